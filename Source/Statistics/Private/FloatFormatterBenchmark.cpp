@@ -0,0 +1,82 @@
+// ...
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "FloatFormatter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFloatFormatter, Log, All)
+
+namespace FloatFormatterBenchmark
+{
+	/** Values like the tables have...Transforms, bounds and KB... */
+	static void MakeValues(int32 InNumValues, TArray<float>& OutValues)
+	{
+		FRandomStream Random(0x5747);
+		OutValues.SetNumUninitialized(InNumValues);
+		for (int32 i = 0; i < InNumValues; ++i)
+		{
+			switch (i % 4)
+			{
+			case 0:  OutValues[i] = Random.FRandRange(-1.f, 1.f); break;			// Rotation...
+			case 1:  OutValues[i] = Random.FRandRange(-100000.f, 100000.f); break;	// Translation, bounds...
+			case 2:  OutValues[i] = (float)Random.RandRange(0, 16384) / 1024.f; break; // KB...
+			default: OutValues[i] = (float)Random.RandRange(0, 4); break;			// Scale, flags...
+			}
+		}
+	}
+
+	template<typename AppendType>
+	static void Run(const TCHAR* InLabel, const TArray<float>& InValues, AppendType InAppend)
+	{
+		// Reset per chunk like one table...
+		const int32 ChunkSize = 1024 * 1024;
+		int64 NumChars = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		FString ToCSVFile;
+		for (int32 i = 0; i < InValues.Num(); ++i)
+		{
+			if (i % ChunkSize == 0)
+			{
+				NumChars += ToCSVFile.Len();
+				ToCSVFile.Reset();
+			}
+			InAppend(ToCSVFile, InValues[i]);
+			ToCSVFile += TEXT(",");
+		}
+		NumChars += ToCSVFile.Len();
+
+		UE_LOG(LogFloatFormatter, Display, TEXT("%-24s %8.1f ms  %6.1f MB"), InLabel, (FPlatformTime::Seconds() - StartTime) * 1000.0, NumChars / (1024.0 * 1024.0));
+	}
+
+	static void Benchmark(const TArray<FString>& InArgs)
+	{
+		const int32 NumValues = InArgs.Num() > 0 ? FCString::Atoi(*InArgs[0]) : 10 * 1000 * 1000;
+
+		TArray<float> Values;
+		MakeValues(NumValues, Values);
+
+		UE_LOG(LogFloatFormatter, Display, TEXT("Formatting %d floats..."), NumValues);
+		Run(TEXT("SanitizeFloat"), Values, [](FString& OutStr, float InValue) { OutStr += FString::SanitizeFloat(InValue); });
+		Run(TEXT("FFloatFormatter RoundTrip"), Values, [](FString& OutStr, float InValue) { FFloatFormatter::Append(OutStr, InValue); });
+		Run(TEXT("FFloatFormatter 4"), Values, [](FString& OutStr, float InValue) { FFloatFormatter::Append(OutStr, InValue, 4); });
+		Run(TEXT("FFloatFormatter 1"), Values, [](FString& OutStr, float InValue) { FFloatFormatter::Append(OutStr, InValue, 1); });
+
+		// Round trip check...
+		int32 NumMismatches = 0;
+		TCHAR Buffer[FFloatFormatter::MaxChars];
+		for (int32 i = 0; i < Values.Num(); ++i)
+		{
+			Buffer[FFloatFormatter::Format(Buffer, Values[i])] = TEXT('\0');
+			NumMismatches += FCString::Atof(Buffer) != Values[i] ? 1 : 0;
+		}
+		UE_LOG(LogFloatFormatter, Display, TEXT("RoundTrip mismatches: %d"), NumMismatches);
+	}
+}
+
+static FAutoConsoleCommand GFloatFormatterBenchmarkCommand(
+	TEXT("Statistics.BenchmarkFloatFormat"),
+	TEXT("Times FFloatFormatter against FString::SanitizeFloat. Arg: num of values, 10M by default."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FloatFormatterBenchmark::Benchmark));
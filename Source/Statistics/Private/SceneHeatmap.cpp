@@ -0,0 +1,278 @@
+// ...
+
+#include "SceneHeatmap.h"
+#include "Components/LineBatchComponent.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "ParallelSort.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSceneHeatmap, Log, All)
+
+namespace SceneHeatmap
+{
+	static const int32 NumColors = 256;
+	static const float ColorPercentile = 0.99f;
+}
+
+FSceneHeatmap::FSceneHeatmap()
+	: LineBatcher(nullptr)
+{
+}
+
+FSceneHeatmap::~FSceneHeatmap()
+{
+	Hide();
+}
+
+const TCHAR* FSceneHeatmap::GetMetricName(EMetric InMetric)
+{
+	switch (InMetric)
+	{
+	case EMetric::Triangles:		  return TEXT("Triangles");
+	case EMetric::DrawCalls:		  return TEXT("DrawCalls");
+	case EMetric::TextureKB:		  return TEXT("TextureKB");
+	case EMetric::ShaderInstructions: return TEXT("ShaderInstructions");
+	default:						  return TEXT("None");
+	}
+}
+
+void FSceneHeatmap::GetBoundsCosts(const FExporterHelper::FExportContext& InContext, EMetric InMetric, TArray<float>& OutCosts)
+{
+	OutCosts.Reset();
+	if (!InContext.WorldSceneDataSets.IsValidIndex(0))
+		return;
+
+	const FExporterHelper::FSceneDataSet& SceneDataSet = InContext.WorldSceneDataSets[0];
+	const FIndexPool& IndexPool = InContext.IndexPool;
+
+	auto GetMaterialsCost = [InMetric, &SceneDataSet, &IndexPool](const FIndexSpan& InMaterials, const FIndexSpan& InMaterialInstances) -> float
+	{
+		if (InMetric == EMetric::TextureKB)
+		{
+			FExporterHelper::FGatherCache::FMaterialSetup MaterialSetup;
+			MaterialSetup.UsedMaterialsIndices = InMaterials;
+			MaterialSetup.UsedMaterialIntancesIndices = InMaterialInstances;
+			return FExporterHelper::GetMaterialSetupTextureKB(SceneDataSet, IndexPool, MaterialSetup);
+		}
+
+		// Instances without shader map of their own run the shaders of the parent...
+		int32 Instructions = 0;
+		for (int32 MaterialIndex : IndexPool[InMaterials])
+			Instructions += FMath::Max(SceneDataSet.MaterialsTable[MaterialIndex].BPSCount, 0);
+		for (int32 MaterialInsIndex : IndexPool[InMaterialInstances])
+		{
+			const FExporterHelper::FSceneMaterialInstanceDataSet& MaterialIns = SceneDataSet.MaterialInstancesTable[MaterialInsIndex];
+			if (MaterialIns.bHasUniqueShaderMap)
+				Instructions += FMath::Max(MaterialIns.UniqueShaderMapStats.BPSCount, 0);
+			else if (SceneDataSet.MaterialsTable.IsValidIndex(MaterialIns.ParentIndex))
+				Instructions += FMath::Max(SceneDataSet.MaterialsTable[MaterialIns.ParentIndex].BPSCount, 0);
+		}
+		return (float)Instructions;
+	};
+
+	// Once per mesh row, instances share the cost of their mesh...
+	TArray<float> StaticMeshCosts;
+	StaticMeshCosts.SetNumUninitialized(SceneDataSet.StaticMeshesTable.Num());
+	ParallelFor(StaticMeshCosts.Num(), [InMetric, &SceneDataSet, &StaticMeshCosts, &GetMaterialsCost](int32 Row)
+	{
+		const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = SceneDataSet.StaticMeshesTable[Row];
+		switch (InMetric)
+		{
+		case EMetric::Triangles: StaticMeshCosts[Row] = (float)StaticMesh.NumTriangles; break;
+		case EMetric::DrawCalls: StaticMeshCosts[Row] = (float)(StaticMesh.UsedMaterialsIndices.Num() + StaticMesh.UsedMaterialIntancesIndices.Num()); break;
+		default:				 StaticMeshCosts[Row] = GetMaterialsCost(StaticMesh.UsedMaterialsIndices, StaticMesh.UsedMaterialIntancesIndices); break;
+		}
+	});
+
+	TArray<float> SkeletalMeshCosts;
+	SkeletalMeshCosts.SetNumUninitialized(SceneDataSet.SkeletalMeshesTable.Num());
+	ParallelFor(SkeletalMeshCosts.Num(), [InMetric, &SceneDataSet, &SkeletalMeshCosts, &GetMaterialsCost](int32 Row)
+	{
+		const FExporterHelper::FSceneSkeletalMeshDataSet& SkeletalMesh = SceneDataSet.SkeletalMeshesTable[Row];
+		switch (InMetric)
+		{
+		case EMetric::Triangles: SkeletalMeshCosts[Row] = (float)SkeletalMesh.NumTriangles; break;
+		case EMetric::DrawCalls: SkeletalMeshCosts[Row] = (float)SkeletalMesh.NumSections; break;
+		default:				 SkeletalMeshCosts[Row] = GetMaterialsCost(SkeletalMesh.UsedMaterialsIndices, SkeletalMesh.UsedMaterialIntancesIndices); break;
+		}
+	});
+
+	TArray<int32> BoundsOwners;
+	FExporterHelper::GetBoundsOwners(SceneDataSet, IndexPool, BoundsOwners);
+
+	OutCosts.SetNumUninitialized(BoundsOwners.Num());
+	for (int32 Row = 0; Row < BoundsOwners.Num(); ++Row)
+	{
+		const int32 Owner = BoundsOwners[Row];
+		OutCosts[Row] = Owner == INDEX_NONE ? 0.f : (Owner >= 0 ? StaticMeshCosts[Owner] : SkeletalMeshCosts[-Owner - 2]);
+	}
+}
+
+bool FSceneHeatmap::Show(UWorld* InWorld, const FExporterHelper::FExportContext& InContext, EMetric InMetric, const FSettings& InSettings)
+{
+	if (!InWorld || !InContext.WorldSceneDataSets.IsValidIndex(0))
+		return false;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FExporterHelper::FSceneDataSet& SceneDataSet = InContext.WorldSceneDataSets[0];
+
+	TArray<float> Costs;
+	GetBoundsCosts(InContext, InMetric, Costs);
+
+	TArray<FHeatBox> Boxes;
+	if (InSettings.Mode == EMode::Grid)
+		GetGridBoxes(SceneDataSet, Costs, InSettings.CellSize, Boxes);
+	else
+		GetBoundsBoxes(SceneDataSet, Costs, InSettings.MaxBoxes, Boxes);
+
+	if (LineBatcher && LineBatcher->GetWorld() != InWorld)
+		Hide();
+	if (!LineBatcher)
+	{
+		// Not the World line batcher, debug lines of others are never flushed with ours...
+		LineBatcher = NewObject<ULineBatchComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+		LineBatcher->bCalculateAccurateBounds = false;
+		LineBatcher->RegisterComponentWithWorld(InWorld);
+		WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([this](UWorld* InCleanupWorld, bool, bool)
+		{
+			if (LineBatcher && LineBatcher->GetWorld() == InCleanupWorld)
+				Hide();
+		});
+	}
+
+	DrawBoxes(Boxes, InSettings);
+
+	UE_LOG(LogSceneHeatmap, Log, TEXT("Heatmap of %s: %d boxes in %.2f ms"), GetMetricName(InMetric), Boxes.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+void FSceneHeatmap::Hide()
+{
+	if (WorldCleanupHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+		WorldCleanupHandle.Reset();
+	}
+
+	if (LineBatcher)
+	{
+		if (LineBatcher->IsRegistered())
+			LineBatcher->UnregisterComponent();
+		LineBatcher = nullptr;
+	}
+}
+
+void FSceneHeatmap::AddReferencedObjects(FReferenceCollector& InCollector)
+{
+	if (LineBatcher)
+		InCollector.AddReferencedObject(LineBatcher);
+}
+
+void FSceneHeatmap::GetBoundsBoxes(const FExporterHelper::FSceneDataSet& InSceneDataSet, const TArray<float>& InCosts, int32 InMaxBoxes, TArray<FHeatBox>& OutBoxes)
+{
+	TArray<int32> Rows;
+	Rows.Reserve(InCosts.Num());
+	for (int32 Row = 0; Row < InCosts.Num(); ++Row)
+	{
+		if (InCosts[Row] > 0.f)
+			Rows.Add(Row);
+	}
+
+	// Most expensive first...
+	if (Rows.Num() > InMaxBoxes)
+	{
+		FParallelSort::Sort(Rows, [&InCosts](int32 A, int32 B) { return InCosts[A] != InCosts[B] ? InCosts[A] > InCosts[B] : A < B; });
+		Rows.SetNum(FMath::Max(InMaxBoxes, 0));
+	}
+
+	OutBoxes.SetNumUninitialized(Rows.Num());
+	for (int32 i = 0; i < Rows.Num(); ++i)
+	{
+		const FBoxSphereBounds& Bounds = InSceneDataSet.BoundsTable[Rows[i]];
+		OutBoxes[i].Box = FBox(Bounds.Origin - Bounds.BoxExtent, Bounds.Origin + Bounds.BoxExtent);
+		OutBoxes[i].Cost = InCosts[Rows[i]];
+	}
+}
+
+void FSceneHeatmap::GetGridBoxes(const FExporterHelper::FSceneDataSet& InSceneDataSet, const TArray<float>& InCosts, float InCellSize, TArray<FHeatBox>& OutBoxes)
+{
+	OutBoxes.Reset();
+
+	// A primitive counts in the XY cell of its bounds center...
+	TMap<FIntPoint, int32> Cells;
+	for (int32 Row = 0; Row < InCosts.Num(); ++Row)
+	{
+		if (InCosts[Row] <= 0.f)
+			continue;
+
+		const FBoxSphereBounds& Bounds = InSceneDataSet.BoundsTable[Row];
+		const FIntPoint Cell(FMath::FloorToInt(Bounds.Origin.X / InCellSize), FMath::FloorToInt(Bounds.Origin.Y / InCellSize));
+		int32* BoxIndex = Cells.Find(Cell);
+		if (!BoxIndex)
+		{
+			FHeatBox& HeatBox = OutBoxes[OutBoxes.AddUninitialized()];
+			HeatBox.Box.Min = FVector(Cell.X * InCellSize, Cell.Y * InCellSize, Bounds.Origin.Z - Bounds.BoxExtent.Z);
+			HeatBox.Box.Max = FVector((Cell.X + 1) * InCellSize, (Cell.Y + 1) * InCellSize, Bounds.Origin.Z + Bounds.BoxExtent.Z);
+			HeatBox.Box.IsValid = 1;
+			HeatBox.Cost = 0.f;
+			BoxIndex = &Cells.Add(Cell, OutBoxes.Num() - 1);
+		}
+
+		FHeatBox& HeatBox = OutBoxes[*BoxIndex];
+		HeatBox.Box.Min.Z = FMath::Min(HeatBox.Box.Min.Z, Bounds.Origin.Z - Bounds.BoxExtent.Z);
+		HeatBox.Box.Max.Z = FMath::Max(HeatBox.Box.Max.Z, Bounds.Origin.Z + Bounds.BoxExtent.Z);
+		HeatBox.Cost += InCosts[Row];
+	}
+}
+
+void FSceneHeatmap::DrawBoxes(const TArray<FHeatBox>& InBoxes, const FSettings& InSettings)
+{
+	// Color scale...One outlier would turn every other box green...
+	float MaxCost = 0.f;
+	if (InBoxes.Num() > 0)
+	{
+		TArray<float> SortedCosts;
+		SortedCosts.SetNumUninitialized(InBoxes.Num());
+		for (int32 i = 0; i < InBoxes.Num(); ++i)
+			SortedCosts[i] = InBoxes[i].Cost;
+		FParallelSort::Sort(SortedCosts, TLess<float>());
+		MaxCost = SortedCosts[FMath::Min((int32)(SortedCosts.Num() * SceneHeatmap::ColorPercentile), SortedCosts.Num() - 1)];
+	}
+	const float CostToColor = MaxCost > 0.f ? (SceneHeatmap::NumColors - 1) / MaxCost : 0.f;
+
+	FLinearColor Palette[SceneHeatmap::NumColors];
+	for (int32 i = 0; i < SceneHeatmap::NumColors; ++i)
+		Palette[i] = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, (float)i / (SceneHeatmap::NumColors - 1));
+
+	const uint8 DepthPriority = InSettings.bForeground ? SDPG_Foreground : SDPG_World;
+	const float Thickness = InSettings.Thickness;
+
+	// 12 edges per box...Life time 0 keeps the lines until the next Flush()...
+	TArray<FBatchedLine> Lines;
+	Lines.SetNumUninitialized(InBoxes.Num() * 12);
+	ParallelFor(InBoxes.Num(), [&InBoxes, &Lines, &Palette, CostToColor, DepthPriority, Thickness](int32 BoxIndex)
+	{
+		const FHeatBox& HeatBox = InBoxes[BoxIndex];
+		const FLinearColor& Color = Palette[FMath::Clamp((int32)(HeatBox.Cost * CostToColor), 0, SceneHeatmap::NumColors - 1)];
+		const FVector& Min = HeatBox.Box.Min;
+		const FVector& Max = HeatBox.Box.Max;
+		const FVector Corners[8] =
+		{
+			FVector(Min.X, Min.Y, Min.Z), FVector(Max.X, Min.Y, Min.Z), FVector(Max.X, Max.Y, Min.Z), FVector(Min.X, Max.Y, Min.Z),
+			FVector(Min.X, Min.Y, Max.Z), FVector(Max.X, Min.Y, Max.Z), FVector(Max.X, Max.Y, Max.Z), FVector(Min.X, Max.Y, Max.Z)
+		};
+
+		FBatchedLine* Line = &Lines[BoxIndex * 12];
+		for (int32 i = 0; i < 4; ++i)
+		{
+			*Line++ = FBatchedLine(Corners[i], Corners[(i + 1) % 4], Color, 0.f, Thickness, DepthPriority);
+			*Line++ = FBatchedLine(Corners[4 + i], Corners[4 + (i + 1) % 4], Color, 0.f, Thickness, DepthPriority);
+			*Line++ = FBatchedLine(Corners[i], Corners[4 + i], Color, 0.f, Thickness, DepthPriority);
+		}
+	});
+
+	// One render state update for all boxes...
+	LineBatcher->Flush();
+	LineBatcher->DrawLines(Lines);
+}
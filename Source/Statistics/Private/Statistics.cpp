@@ -9,6 +9,10 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "StatisticsWidget.h"
+#include "StatisticsServer.h"
+#include "TextureWhatIfEngine.h"
+
+DEFINE_LOG_CATEGORY(LogTextureWhatIf)
 
 static const FName StatisticsTabName("Statistics");
 
@@ -49,6 +53,16 @@ void FStatisticsModule::StartupModule()
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(StatisticsTabName, FOnSpawnTab::CreateRaw(this, &FStatisticsModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FStatisticsTabTitle", "Statistics"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	const FString ConfigFile = FPaths::ProjectPluginsDir() + "Statistics/Config/PluginSetting.ini";
+	FStatisticsServer::FSettings ServerSettings;
+	ServerSettings.LoadConfig(ConfigFile);
+	if (ServerSettings.bEnabled)
+	{
+		StatisticsServer = MakeShareable(new FStatisticsServer(ServerSettings, ConfigFile));
+		if (!StatisticsServer->Start())
+			StatisticsServer.Reset();
+	}
 }
 
 void FStatisticsModule::ShutdownModule()
@@ -60,6 +74,8 @@ void FStatisticsModule::ShutdownModule()
 	FStatisticsCommands::Unregister();
 
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(StatisticsTabName);
+
+	StatisticsServer.Reset();
 }
 
 TSharedRef<SDockTab> FStatisticsModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
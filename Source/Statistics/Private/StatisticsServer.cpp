@@ -0,0 +1,420 @@
+// ...
+
+#include "StatisticsServer.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStatisticsServer, Log, All)
+
+FStatisticsServer::FStatisticsServer(const FSettings& InSettings, const FString& InConfigFile)
+	: Settings(InSettings)
+	, ConfigFile(InConfigFile)
+	, ListenSocket(nullptr)
+	, Thread(nullptr)
+	, bStopping(false)
+	, Index(InSettings.IndexCellSize)
+	, Version(0)
+	, UpdateTime(0.0)
+	, bQueried(false)
+	, bGatherNeeded(false)
+	, GatherTime(0.0)
+{
+}
+
+FStatisticsServer::~FStatisticsServer()
+{
+	if (TickHandle.IsValid())
+		FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	// Engine may be gone at module shutdown...
+	if (GEngine)
+	{
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	for (TArray<TUniquePtr<FClient>>::TIterator It(Clients); It; ++It)
+	{
+		(*It)->Socket->Close();
+		SocketSubsystem->DestroySocket((*It)->Socket);
+	}
+	Clients.Empty();
+
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		SocketSubsystem->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+}
+
+bool FStatisticsServer::Start()
+{
+	// Loopback only...Scene data is not served to the network...
+	ListenSocket = FTcpSocketBuilder(TEXT("StatisticsServer"))
+		.AsReusable()
+		.AsNonBlocking()
+		.BoundToEndpoint(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Settings.Port))
+		.Listening(16)
+		.Build();
+	if (!ListenSocket)
+	{
+		UE_LOG(LogStatisticsServer, Warning, TEXT("Can not listen on 127.0.0.1:%d"), Settings.Port);
+		return false;
+	}
+
+	// Changes are patched into the index on the next tick...Only levels coming and going need a gather...
+	if (GEngine)
+	{
+		ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FStatisticsServer::OnActorChanged);
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FStatisticsServer::OnActorChanged);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FStatisticsServer::OnActorChanged);
+	}
+	// Modified catches edits without a property event, foliage painting and instance edits...
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FStatisticsServer::OnObjectChanged);
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* InObject, FPropertyChangedEvent&) { OnObjectChanged(InObject); });
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddLambda([this](ULevel*, UWorld*) { OnLevelsChanged(); });
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddLambda([this](ULevel*, UWorld*) { OnLevelsChanged(); });
+	MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32) { OnLevelsChanged(); });
+
+	TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FStatisticsServer::Tick), 0.5f);
+	Thread = FRunnableThread::Create(this, TEXT("StatisticsServer"), 0, TPri_BelowNormal);
+
+	UE_LOG(LogStatisticsServer, Log, TEXT("Listening on 127.0.0.1:%d"), Settings.Port);
+	return Thread != nullptr;
+}
+
+void FStatisticsServer::Stop()
+{
+	bStopping = true;
+}
+
+void FStatisticsServer::OnActorChanged(AActor* InActor)
+{
+	// Nothing to patch before the first gather...
+	if (InActor && Snapshot.IsValid())
+		DirtyActors.Add(InActor, InActor);
+}
+
+void FStatisticsServer::OnObjectChanged(UObject* InObject)
+{
+	if (AActor* Actor = Cast<AActor>(InObject))
+		OnActorChanged(Actor);
+	else if (UActorComponent* Component = Cast<UActorComponent>(InObject))
+		OnActorChanged(Component->GetOwner());
+}
+
+void FStatisticsServer::OnLevelsChanged()
+{
+	bGatherNeeded = true;
+}
+
+bool FStatisticsServer::Tick(float InDeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (bQueried && (!Snapshot.IsValid() || (bGatherNeeded && Now - GatherTime >= Settings.RefreshSeconds)))
+	{
+		bQueried = false;
+		BuildSnapshot();
+	}
+	else if (DirtyActors.Num() > 0 && !bGatherNeeded)
+	{
+		PatchSnapshot();
+	}
+	return true;
+}
+
+bool FStatisticsServer::AddPrimitiveRows(StatisticsClient::FSceneIndex& InOutIndex, const TMap<uint32, int32>& InMaterialRows, UPrimitiveComponent* InComponent, TArray<uint32>& OutRows)
+{
+	uint32 NumTriangles = 0, MeshId = 0;
+	UStaticMesh* StaticMesh = nullptr;
+	if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(InComponent))
+	{
+		StaticMesh = StaticMeshComponent->GetStaticMesh();
+		if (!StaticMesh || !StaticMesh->RenderData || StaticMesh->RenderData->LODResources.Num() == 0)
+			return true;
+		NumTriangles = StaticMesh->RenderData->LODResources[0].GetNumTriangles();
+		MeshId = StaticMesh->GetUniqueID();
+	}
+	else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(InComponent))
+	{
+		FSkeletalMeshRenderData* RenderData = SkeletalMeshComponent->GetSkeletalMeshRenderData();
+		if (!SkeletalMeshComponent->SkeletalMesh || !RenderData || RenderData->LODRenderData.Num() == 0)
+			return true;
+		for (const FSkelMeshRenderSection& Section : RenderData->LODRenderData[0].RenderSections)
+			NumTriangles += Section.NumTriangles;
+		MeshId = SkeletalMeshComponent->SkeletalMesh->GetUniqueID();
+	}
+	else
+	{
+		// Landscape and BSP have no mesh rows in the tables either...
+		return true;
+	}
+
+	// Instances count as their parent material...
+	TArray<UMaterialInterface*> UsedMaterials;
+	InComponent->GetUsedMaterials(UsedMaterials);
+	TArray<uint32, TInlineAllocator<8>> Materials;
+	bool bKnownMaterials = true;
+	for (UMaterialInterface* UsedMaterial : UsedMaterials)
+	{
+		UMaterial* Material = UsedMaterial ? UsedMaterial->GetMaterial() : nullptr;
+		if (!Material)
+			continue;
+		if (const int32* MaterialRow = InMaterialRows.Find(Material->GetUniqueID()))
+			Materials.AddUnique(*MaterialRow);
+		else
+			bKnownMaterials = false;
+	}
+
+	auto AddRow = [&](const FBox& InBox)
+	{
+		OutRows.Add(InOutIndex.AddRow({ InBox.Min.X, InBox.Min.Y, InBox.Min.Z }, { InBox.Max.X, InBox.Max.Y, InBox.Max.Z }, NumTriangles, MeshId, Materials.GetData(), Materials.Num()));
+	};
+
+	// World bounds of every instance...
+	UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(InComponent);
+	if (InstancedComponent && StaticMesh)
+	{
+		const FBox MeshBox = StaticMesh->GetBounds().GetBox();
+		for (int32 i = 0; i < InstancedComponent->GetInstanceCount(); ++i)
+		{
+			FTransform InstanceTransform;
+			if (InstancedComponent->GetInstanceTransform(i, InstanceTransform, true))
+				AddRow(MeshBox.TransformBy(InstanceTransform));
+		}
+	}
+	else
+	{
+		AddRow(InComponent->Bounds.GetBox());
+	}
+
+	return bKnownMaterials;
+}
+
+void FStatisticsServer::BuildSnapshot()
+{
+	UWorld* World = FExporterHelper::GetWorld();
+	if (!World || !World->Scene)
+		return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedPtr<FSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSnapshot, ESPMode::ThreadSafe>();
+	FExporterHelper::FExportContext& Context = NewSnapshot->Context;
+	Context.Settings.LoadConfig(ConfigFile);
+	// Default stats of the editor feature level only...Side by side levels would compile shader maps on every gather...
+	Context.Settings.MaterialFeatureLevels.Empty();
+	Context.Settings.MaterialQualityLevels.Empty();
+
+	TMap<ULevel*, TMap<FPrimitiveComponentId, UPrimitiveComponent*>> PerLevelComps;
+	TMap<FPrimitiveComponentId, UPrimitiveComponent*> PrimitivesTable;
+	FExporterHelper::GatherPrimitives(World, PerLevelComps, PrimitivesTable);
+	if (!FExporterHelper::GatherSceneDataSets((FScene*)World->Scene, PrimitivesTable, World->GetName(), Context, NewSnapshot->PerLODSceneDataSets))
+		NewSnapshot->PerLODSceneDataSets.AddZeroed(1);
+
+	// Nothing waits for compiles...Materials still compiling keep their defaults...
+	FExporterHelper::FSceneDataSet& BaseDataSet = NewSnapshot->PerLODSceneDataSets[0];
+	FExporterHelper::GatherMaterialsStats(BaseDataSet.MaterialsTable, Context);
+	FExporterHelper::QueuePendingMaterialInstanceStats(BaseDataSet.MaterialInstancesTable, Context);
+	FExporterHelper::ResolvePendingMaterialStats(Context, 0.f);
+	FExporterHelper::PatchPendingMaterialStats(BaseDataSet, Context);
+	FExporterHelper::ReleasePendingMaterialStats(Context);
+
+	// Material rows of the index, sorted once for TopMaterials...
+	StatisticsClient::FSceneIndex NewIndex(Settings.IndexCellSize);
+	std::vector<StatisticsClient::FMaterialRow> Materials;
+	Materials.reserve(BaseDataSet.MaterialsTable.Num());
+	for (int32 i = 0; i < BaseDataSet.MaterialsTable.Num(); ++i)
+	{
+		const FExporterHelper::FSceneMaterialDataSet& Row = BaseDataSet.MaterialsTable[i];
+		NewSnapshot->MaterialRows.Add(Row.UniqueId, i);
+
+		FTCHARToUTF8 NameUTF8(Context.StringPool[Row.Name], Context.StringPool.Len(Row.Name));
+		Materials.push_back({ Row.BPSCount, Row.BPSVertex, Row.NumRefs, std::string(NameUTF8.Get(), NameUTF8.Length()) });
+	}
+	NewIndex.SetMaterials(std::move(Materials));
+
+	// Same rows as the patches add...
+	TMap<const AActor*, TArray<uint32>> NewActorRows;
+	for (TMap<FPrimitiveComponentId, UPrimitiveComponent*>::TConstIterator It(PrimitivesTable); It; ++It)
+	{
+		if (UPrimitiveComponent* Component = It.Value())
+			AddPrimitiveRows(NewIndex, NewSnapshot->MaterialRows, Component, NewActorRows.FindOrAdd(Component->GetOwner()));
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	NewSnapshot->GatherSeconds = Now - StartTime;
+	GatherTime = Now;
+	bGatherNeeded = false;
+	ActorRows = MoveTemp(NewActorRows);
+	// Included in the new gather...
+	DirtyActors.Reset();
+
+	{
+		FWriteScopeLock Lock(IndexLock);
+		Snapshot = NewSnapshot;
+		Index = std::move(NewIndex);
+		Version++;
+		UpdateTime = Now;
+	}
+
+	UE_LOG(LogStatisticsServer, Log, TEXT("Snapshot %u: %u primitives, %d materials in %.1f ms"),
+		Version, Index.GetNumRows(), BaseDataSet.MaterialsTable.Num(), NewSnapshot->GatherSeconds * 1000.0);
+}
+
+void FStatisticsServer::PatchSnapshot()
+{
+	UWorld* World = FExporterHelper::GetWorld();
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumActors = 0;
+
+	{
+		FWriteScopeLock Lock(IndexLock);
+		for (TMap<const AActor*, TWeakObjectPtr<AActor>>::TConstIterator It(DirtyActors); It; ++It)
+		{
+			if (TArray<uint32>* Rows = ActorRows.Find(It.Key()))
+			{
+				for (uint32 Row : *Rows)
+					Index.RemoveRow(Row);
+				ActorRows.Remove(It.Key());
+			}
+
+			// Deleted actors only lose their rows...
+			AActor* Actor = It.Value().Get();
+			if (!Actor || Actor->IsPendingKill() || Actor->GetWorld() != World)
+				continue;
+
+			TArray<UPrimitiveComponent*> Components;
+			Actor->GetComponents(Components);
+			TArray<uint32> Rows;
+			for (UPrimitiveComponent* Component : Components)
+			{
+				// New materials have no rows yet, the next gather adds them...
+				if (Component->IsRegistered() && !AddPrimitiveRows(Index, Snapshot->MaterialRows, Component, Rows))
+					bGatherNeeded = true;
+			}
+			if (Rows.Num() > 0)
+				ActorRows.Add(It.Key(), MoveTemp(Rows));
+			NumActors++;
+		}
+
+		Version++;
+		UpdateTime = FPlatformTime::Seconds();
+	}
+
+	DirtyActors.Reset();
+	UE_LOG(LogStatisticsServer, Verbose, TEXT("Snapshot %u: patched %d actors in %.2f ms"), Version, NumActors, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+uint32 FStatisticsServer::Run()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	auto Execute = [this](EQuery InQuery, StatisticsClient::FReader& InRequest, std::vector<uint8>& OutPayload) { return ExecuteQuery(InQuery, InRequest, OutPayload); };
+
+	while (!bStopping)
+	{
+		bool bPendingConnection = false;
+		while (ListenSocket->HasPendingConnection(bPendingConnection) && bPendingConnection)
+		{
+			FSocket* Socket = ListenSocket->Accept(TEXT("StatisticsServerClient"));
+			if (!Socket)
+				break;
+
+			// Never blocks...Answers wait in the connection queue until the client reads...
+			Socket->SetNonBlocking(true);
+			Socket->SetNoDelay(true);
+			TUniquePtr<FClient> Client = MakeUnique<FClient>();
+			Client->Socket = Socket;
+			Clients.Add(MoveTemp(Client));
+		}
+
+		bool bActive = false;
+		for (int32 ClientIndex = Clients.Num() - 1; ClientIndex >= 0; --ClientIndex)
+		{
+			FSocket* Socket = Clients[ClientIndex]->Socket;
+			const StatisticsClient::FServerConnection::EPump State = Clients[ClientIndex]->Connection.Pump(
+				[Socket](uint8* OutData, size_t InSize) -> int64
+				{
+					// True without bytes would block...False is a closed peer or an error...
+					int32 BytesRead = 0;
+					return Socket->Recv(OutData, (int32)InSize, BytesRead) ? BytesRead : -1;
+				},
+				[Socket, SocketSubsystem](const uint8* InData, size_t InSize) -> int64
+				{
+					int32 BytesSent = 0;
+					if (Socket->Send(InData, (int32)FMath::Min<size_t>(InSize, MAX_int32), BytesSent))
+						return BytesSent;
+					return SocketSubsystem->GetLastErrorCode() == SE_EWOULDBLOCK ? 0 : -1;
+				},
+				Execute);
+
+			if (State == StatisticsClient::FServerConnection::EPump::Closed)
+			{
+				Socket->Close();
+				SocketSubsystem->DestroySocket(Socket);
+				Clients.RemoveAtSwap(ClientIndex);
+			}
+			else if (State == StatisticsClient::FServerConnection::EPump::Active)
+			{
+				bActive = true;
+			}
+		}
+
+		if (!bActive)
+			FPlatformProcess::Sleep(0.001f);
+	}
+
+	return 0;
+}
+
+FStatisticsServer::EStatus FStatisticsServer::ExecuteQuery(EQuery InQuery, StatisticsClient::FReader& InRequest, std::vector<uint8>& OutPayload)
+{
+	bQueried = true;
+
+	// A patch waits for one query at most...
+	FReadScopeLock Lock(IndexLock);
+	if (!Snapshot.IsValid())
+		return EStatus::NoSnapshot;
+
+	if (InQuery != EQuery::Info)
+		return Index.Execute(InQuery, InRequest, OutPayload, (uint64)Settings.MaxGridCells);
+
+	const FExporterHelper::FSceneDataSet& BaseDataSet = Snapshot->PerLODSceneDataSets[0];
+	StatisticsClient::FInfo Info;
+	Info.Version = Version;
+	Info.NumPrimitives = Index.GetNumRows();
+	Info.NumStaticMeshes = BaseDataSet.StaticMeshesTable.Num();
+	Info.NumSkeletalMeshes = BaseDataSet.SkeletalMeshesTable.Num();
+	Info.NumMaterials = BaseDataSet.MaterialsTable.Num();
+	Info.NumTextures = BaseDataSet.TexturesTable.Num();
+	Info.GatherMs = Snapshot->GatherSeconds * 1000.0;
+	Info.Age = FPlatformTime::Seconds() - UpdateTime;
+	Info.BoundsMin = Index.GetBoundsMin();
+	Info.BoundsMax = Index.GetBoundsMax();
+	StatisticsClient::FWriter(OutPayload).Put(Info.Version).Put(Info.NumPrimitives).Put(Info.NumStaticMeshes).Put(Info.NumSkeletalMeshes).Put(Info.NumMaterials)
+		.Put(Info.NumTextures).Put(Info.GatherMs).Put(Info.Age).Put(Info.BoundsMin).Put(Info.BoundsMax);
+	return EStatus::Ok;
+}
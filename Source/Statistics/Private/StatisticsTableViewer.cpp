@@ -0,0 +1,555 @@
+// ...
+
+#include "StatisticsTableViewer.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "ParallelSort.h"
+#include "FloatFormatter.h"
+#include "Editor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStatisticsTableViewer, Log, All)
+
+#define LOCTEXT_NAMESPACE "SStatisticsTableViewer"
+
+/** Cells of one visible row...Texts are built when the list generates the row, only for rows on screen... */
+class SStatisticsTableRow : public SMultiColumnTableRow<SStatisticsTableViewer::FRowItemPtr>
+{
+public:
+	SLATE_BEGIN_ARGS(SStatisticsTableRow) : _Viewer(nullptr), _Row(INDEX_NONE) {}
+	SLATE_ARGUMENT(const SStatisticsTableViewer*, Viewer)
+	SLATE_ARGUMENT(int32, Row)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable)
+	{
+		Viewer = InArgs._Viewer;
+		Row = InArgs._Row;
+		SMultiColumnTableRow<SStatisticsTableViewer::FRowItemPtr>::Construct(FSuperRowType::FArguments(), InOwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& InColumnName) override
+	{
+		return SNew(SBox).Padding(FMargin(4.0f, 0.0f))
+		[
+			SNew(STextBlock).Text(Viewer->GetCellText(Row, InColumnName))
+		];
+	}
+
+private:
+	const SStatisticsTableViewer* Viewer;
+	int32 Row;
+};
+
+void SStatisticsTableViewer::Construct(const FArguments& InArgs)
+{
+	ExportContext = InArgs._ExportContext;
+	CurrentTable = INDEX_NONE;
+	SortModes[0] = SortModes[1] = EColumnSortMode::None;
+	LastOperationMs = 0.0;
+
+	BuildTables();
+	for (TArray<FTable>::TIterator It(Tables); It; ++It)
+		TableNames.Add(MakeShared<FString>((*It).Name));
+
+	this->ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot().AutoHeight().Padding(FMargin(0.0f, 0.0f, 0.0f, 4.0f))
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(FMargin(0.0f, 0.0f, 8.0f, 0.0f))
+			[
+				SNew(SComboBox<TSharedPtr<FString>>)
+				.OptionsSource(&TableNames)
+				.OnGenerateWidget(this, &SStatisticsTableViewer::OnGenerateTableName)
+				.OnSelectionChanged(this, &SStatisticsTableViewer::OnTableNameSelected)
+				.InitiallySelectedItem(TableNames.Num() > 0 ? TableNames[0] : nullptr)
+				[
+					SNew(STextBlock).Text(this, &SStatisticsTableViewer::GetCurrentTableName)
+				]
+			]
+			+SHorizontalBox::Slot()
+			.FillWidth(1)
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("FilterHint", "过滤名称或路径..."))
+				.OnTextChanged(this, &SStatisticsTableViewer::OnFilterTextChanged)
+			]
+		]
+		+SVerticalBox::Slot().FillHeight(1)
+		[
+			SAssignNew(ListView, SListView<FRowItemPtr>)
+			.ListItemsSource(&VisibleItems)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SStatisticsTableViewer::OnGenerateRow)
+			.OnSelectionChanged(this, &SStatisticsTableViewer::OnSelectionChanged)
+			.OnMouseButtonDoubleClick(this, &SStatisticsTableViewer::OnRowDoubleClicked)
+			.HeaderRow(SAssignNew(HeaderRow, SHeaderRow))
+		]
+		+SVerticalBox::Slot().AutoHeight().Padding(FMargin(0.0f, 4.0f, 0.0f, 0.0f))
+		[
+			SNew(STextBlock).Text(this, &SStatisticsTableViewer::GetStatusText)
+		]
+	];
+
+	SelectTable(0);
+}
+
+void SStatisticsTableViewer::BuildTables()
+{
+	if (!ExportContext.IsValid() || ExportContext->WorldSceneDataSets.Num() == 0)
+		return;
+
+	const TArray<FExporterHelper::FSceneDataSet>& DataSets = ExportContext->WorldSceneDataSets;
+	const FExporterHelper::FSceneDataSet& BaseDataSet = DataSets[0];
+	const FStringPool& StringPool = ExportContext->StringPool;
+	const FIndexPool& IndexPool = ExportContext->IndexPool;
+
+	// Rows of all LODs...Table order is LOD major...
+	for (TArray<FExporterHelper::FSceneDataSet>::TConstIterator It(DataSets); It; ++It)
+	{
+		for (TArray<FExporterHelper::FSceneStaticMeshDataSet>::TConstIterator RowIt((*It).StaticMeshesTable); RowIt; ++RowIt)
+			StaticMeshRows.Add(&(*RowIt));
+		for (TArray<FExporterHelper::FSceneSkeletalMeshDataSet>::TConstIterator RowIt((*It).SkeletalMeshesTable); RowIt; ++RowIt)
+			SkeletalMeshRows.Add(&(*RowIt));
+	}
+
+	// LOD0 rows come first, their row is the same in the table and in the flat rows...
+	FExporterHelper::GetBoundsOwners(BaseDataSet, IndexPool, BoundsOwners);
+
+	auto MakeStringColumn = [](const TCHAR* InId, const FText& InLabel, float InFillWidth, TFunction<const TCHAR*(int32)>&& InGetString)
+	{
+		FColumn Column;
+		Column.Id = InId;
+		Column.Label = InLabel;
+		Column.FillWidth = InFillWidth;
+		Column.GetString = MoveTemp(InGetString);
+		Column.Precision = 0;
+		return Column;
+	};
+	auto MakeNumberColumn = [](const TCHAR* InId, const FText& InLabel, float InFillWidth, int32 InPrecision, TFunction<double(int32)>&& InGetNumber)
+	{
+		FColumn Column;
+		Column.Id = InId;
+		Column.Label = InLabel;
+		Column.FillWidth = InFillWidth;
+		Column.GetNumber = MoveTemp(InGetNumber);
+		Column.Precision = InPrecision;
+		return Column;
+	};
+
+	// Static meshes...
+	{
+		FTable& Table = Tables[Tables.AddDefaulted()];
+		Table.Name = TEXT("StaticMeshes");
+		Table.NumRows = StaticMeshRows.Num();
+		const TArray<const FExporterHelper::FSceneStaticMeshDataSet*>& Rows = StaticMeshRows;
+		Table.Columns.Add(MakeStringColumn(TEXT("Name"), LOCTEXT("Name", "Name"), 2.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row]->Name]; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("Owner"), LOCTEXT("Owner", "Owner"), 2.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row]->OwnerName]; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("LOD"), LOCTEXT("LOD", "LOD"), 0.5f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->CurrentLOD; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumLODs"), LOCTEXT("NumLODs", "LODs"), 0.5f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumLODs; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumVertices"), LOCTEXT("NumVertices", "Vertices"), 1.0f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumVertices; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumTriangles"), LOCTEXT("NumTriangles", "Triangles"), 1.0f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumTriangles; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumInstances"), LOCTEXT("NumInstances", "Instances"), 0.8f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumInstances; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumMaterials"), LOCTEXT("NumMaterials", "Materials"), 0.8f, 0, [&Rows](int32 Row) { return (double)(Rows[Row]->UsedMaterialsIndices.Num() + Rows[Row]->UsedMaterialIntancesIndices.Num()); }));
+		Table.Columns.Add(MakeStringColumn(TEXT("AssetPath"), LOCTEXT("AssetPath", "Asset Path"), 3.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row]->AssetPath]; }));
+		Table.OnRowClicked = [&Rows](int32 Row, bool bFocus) { SelectComponentActor(Rows[Row]->Component, bFocus); };
+	}
+
+	// Skeletal meshes...
+	{
+		FTable& Table = Tables[Tables.AddDefaulted()];
+		Table.Name = TEXT("SkeletalMeshes");
+		Table.NumRows = SkeletalMeshRows.Num();
+		const TArray<const FExporterHelper::FSceneSkeletalMeshDataSet*>& Rows = SkeletalMeshRows;
+		Table.Columns.Add(MakeStringColumn(TEXT("Name"), LOCTEXT("Name", "Name"), 2.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row]->Name]; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("Owner"), LOCTEXT("Owner", "Owner"), 2.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row]->OwnerName]; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("LOD"), LOCTEXT("LOD", "LOD"), 0.5f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->CurrentLOD; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumLODs"), LOCTEXT("NumLODs", "LODs"), 0.5f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumLODs; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumVertices"), LOCTEXT("NumVertices", "Vertices"), 1.0f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumVertices; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumTriangles"), LOCTEXT("NumTriangles", "Triangles"), 1.0f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumTriangles; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumSections"), LOCTEXT("NumSections", "Sections"), 0.8f, 0, [&Rows](int32 Row) { return (double)Rows[Row]->NumSections; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumMaterials"), LOCTEXT("NumMaterials", "Materials"), 0.8f, 0, [&Rows](int32 Row) { return (double)(Rows[Row]->UsedMaterialsIndices.Num() + Rows[Row]->UsedMaterialIntancesIndices.Num()); }));
+		Table.Columns.Add(MakeStringColumn(TEXT("AssetPath"), LOCTEXT("AssetPath", "Asset Path"), 3.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row]->AssetPath]; }));
+		Table.OnRowClicked = [&Rows](int32 Row, bool bFocus) { SelectComponentActor(Rows[Row]->Component, bFocus); };
+	}
+
+	// Materials...
+	{
+		FTable& Table = Tables[Tables.AddDefaulted()];
+		Table.Name = TEXT("Materials");
+		Table.NumRows = BaseDataSet.MaterialsTable.Num();
+		const TArray<FExporterHelper::FSceneMaterialDataSet>& Rows = BaseDataSet.MaterialsTable;
+		Table.Columns.Add(MakeStringColumn(TEXT("Name"), LOCTEXT("Name", "Name"), 2.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row].Name]; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("BlendMode"), LOCTEXT("BlendMode", "Blend Mode"), 1.0f, [&Rows](int32 Row) { return *Rows[Row].BlendMode; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("ShadingModel"), LOCTEXT("ShadingModel", "Shading Model"), 1.0f, [&Rows](int32 Row) { return *Rows[Row].ShadingModel; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumRefs"), LOCTEXT("NumRefs", "Refs"), 0.6f, 0, [&Rows](int32 Row) { return (double)Rows[Row].NumRefs; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumInstances"), LOCTEXT("NumMaterialInstances", "Instances"), 0.6f, 0, [&Rows](int32 Row) { return (double)Rows[Row].NumInstances; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("BPSCount"), LOCTEXT("BPSCount", "BPS Pixel"), 0.8f, 0, [&Rows](int32 Row) { return (double)Rows[Row].BPSCount; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("BPSVertex"), LOCTEXT("BPSVertex", "BPS Vertex"), 0.8f, 0, [&Rows](int32 Row) { return (double)Rows[Row].BPSVertex; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumShaderPermutations"), LOCTEXT("NumShaderPermutations", "Permutations"), 0.8f, 0, [&Rows](int32 Row) { return (double)Rows[Row].NumShaderPermutations; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("ShaderMapKB"), LOCTEXT("ShaderMapKB", "Shader Map KB"), 0.8f, 1, [&Rows](int32 Row) { return Rows[Row].ShaderMapBytes / 1024.0; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("AssetPath"), LOCTEXT("AssetPath", "Asset Path"), 3.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row].AssetPath]; }));
+		Table.OnRowClicked = [this, &Rows](int32 Row, bool) { SyncBrowserToAsset(Rows[Row].AssetPath); };
+	}
+
+	// Textures...
+	{
+		FTable& Table = Tables[Tables.AddDefaulted()];
+		Table.Name = TEXT("Textures");
+		Table.NumRows = BaseDataSet.TexturesTable.Num();
+		const TArray<FExporterHelper::FSceneTextureDataSet>& Rows = BaseDataSet.TexturesTable;
+		Table.Columns.Add(MakeStringColumn(TEXT("Name"), LOCTEXT("Name", "Name"), 2.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row].Name]; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("PixelFormat"), LOCTEXT("PixelFormat", "Format"), 1.0f, [&Rows](int32 Row) { return *Rows[Row].PixelFormat; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("SizeX"), LOCTEXT("SizeX", "Size X"), 0.6f, 0, [&Rows](int32 Row) { return (double)Rows[Row].SizeX; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("SizeY"), LOCTEXT("SizeY", "Size Y"), 0.6f, 0, [&Rows](int32 Row) { return (double)Rows[Row].SizeY; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("NumRefs"), LOCTEXT("NumRefs", "Refs"), 0.6f, 0, [&Rows](int32 Row) { return (double)Rows[Row].NumRefs; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("LODBias"), LOCTEXT("LODBias", "LOD Bias"), 0.6f, 0, [&Rows](int32 Row) { return (double)Rows[Row].LODBias; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("CurrentKB"), LOCTEXT("CurrentKB", "Current KB"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].CurrentKB; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("FullyLoadedKB"), LOCTEXT("FullyLoadedKB", "Fully Loaded KB"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].FullyLoadedKB; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("AssetPath"), LOCTEXT("AssetPath", "Asset Path"), 3.0f, [&Rows, &StringPool](int32 Row) { return StringPool[Rows[Row].AssetPath]; }));
+		Table.OnRowClicked = [this, &Rows](int32 Row, bool) { SyncBrowserToAsset(Rows[Row].AssetPath); };
+	}
+
+	// Bounds...Owner is the mesh row of LOD0...
+	{
+		FTable& Table = Tables[Tables.AddDefaulted()];
+		Table.Name = TEXT("Bounds");
+		Table.NumRows = BaseDataSet.BoundsTable.Num();
+		const TArray<FBoxSphereBounds>& Rows = BaseDataSet.BoundsTable;
+		auto GetOwnerName = [this, &StringPool](int32 Row) -> const TCHAR*
+		{
+			const int32 Owner = BoundsOwners[Row];
+			if (Owner == INDEX_NONE)
+				return TEXT("");
+			return Owner >= 0 ? StringPool[StaticMeshRows[Owner]->OwnerName] : StringPool[SkeletalMeshRows[-Owner - 2]->OwnerName];
+		};
+		Table.Columns.Add(MakeNumberColumn(TEXT("Index"), LOCTEXT("Index", "Index"), 0.6f, 0, [](int32 Row) { return (double)Row; }));
+		Table.Columns.Add(MakeStringColumn(TEXT("Owner"), LOCTEXT("Owner", "Owner"), 2.0f, GetOwnerName));
+		Table.Columns.Add(MakeNumberColumn(TEXT("OriginX"), LOCTEXT("OriginX", "Origin X"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].Origin.X; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("OriginY"), LOCTEXT("OriginY", "Origin Y"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].Origin.Y; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("OriginZ"), LOCTEXT("OriginZ", "Origin Z"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].Origin.Z; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("ExtentX"), LOCTEXT("ExtentX", "Extent X"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].BoxExtent.X; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("ExtentY"), LOCTEXT("ExtentY", "Extent Y"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].BoxExtent.Y; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("ExtentZ"), LOCTEXT("ExtentZ", "Extent Z"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].BoxExtent.Z; }));
+		Table.Columns.Add(MakeNumberColumn(TEXT("Radius"), LOCTEXT("Radius", "Radius"), 0.8f, 1, [&Rows](int32 Row) { return (double)Rows[Row].SphereRadius; }));
+		Table.OnRowClicked = [this](int32 Row, bool bFocus)
+		{
+			const int32 Owner = BoundsOwners[Row];
+			if (Owner != INDEX_NONE)
+				SelectComponentActor(Owner >= 0 ? StaticMeshRows[Owner]->Component : SkeletalMeshRows[-Owner - 2]->Component, bFocus);
+		};
+	}
+}
+
+void SStatisticsTableViewer::SelectTable(int32 InTableIndex)
+{
+	if (!Tables.IsValidIndex(InTableIndex) || InTableIndex == CurrentTable)
+		return;
+
+	CurrentTable = InTableIndex;
+	const FTable& Table = Tables[CurrentTable];
+
+	SortColumns[0] = SortColumns[1] = NAME_None;
+	SortModes[0] = SortModes[1] = EColumnSortMode::None;
+
+	HeaderRow->ClearColumns();
+	for (TArray<FColumn>::TConstIterator It(Table.Columns); It; ++It)
+	{
+		HeaderRow->AddColumn(SHeaderRow::Column((*It).Id)
+			.DefaultLabel((*It).Label)
+			.FillWidth((*It).FillWidth)
+			.SortMode(this, &SStatisticsTableViewer::GetColumnSortMode, (*It).Id)
+			.SortPriority(this, &SStatisticsTableViewer::GetColumnSortPriority, (*It).Id)
+			.OnSort(this, &SStatisticsTableViewer::OnSortModeChanged));
+	}
+
+	TSharedRef<TArray<int32>> NewRowItems = MakeShared<TArray<int32>>();
+	NewRowItems->SetNumUninitialized(Table.NumRows);
+	for (int32 Row = 0; Row < Table.NumRows; ++Row)
+		(*NewRowItems)[Row] = Row;
+	RowItems = NewRowItems;
+
+	SortRows();
+}
+
+void SStatisticsTableViewer::SortRows()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const FTable& Table = Tables[CurrentTable];
+
+	SortedRows.SetNumUninitialized(Table.NumRows);
+	for (int32 Row = 0; Row < Table.NumRows; ++Row)
+		SortedRows[Row] = Row;
+
+	// Keys are gathered once per sort, not once per comparison...
+	struct FSortKeys
+	{
+		TArray<double> Numbers;
+		TArray<const TCHAR*> Strings;
+		bool bDescending;
+	};
+	TArray<FSortKeys, TInlineAllocator<2>> SortKeys;
+	for (int32 i = 0; i < 2; ++i)
+	{
+		const FColumn* Column = Table.Columns.FindByPredicate([this, i](const FColumn& InColumn) { return InColumn.Id == SortColumns[i]; });
+		if (!Column || SortModes[i] == EColumnSortMode::None)
+			continue;
+
+		FSortKeys& Keys = SortKeys[SortKeys.AddDefaulted()];
+		Keys.bDescending = SortModes[i] == EColumnSortMode::Descending;
+		if (Column->GetNumber)
+		{
+			Keys.Numbers.SetNumUninitialized(Table.NumRows);
+			ParallelFor(Table.NumRows, [&Keys, Column](int32 Row) { Keys.Numbers[Row] = Column->GetNumber(Row); });
+		}
+		else
+		{
+			Keys.Strings.SetNumUninitialized(Table.NumRows);
+			ParallelFor(Table.NumRows, [&Keys, Column](int32 Row) { Keys.Strings[Row] = Column->GetString(Row); });
+		}
+	}
+
+	if (SortKeys.Num() > 0)
+	{
+		// Ties keep the table order...
+		FParallelSort::Sort(SortedRows, [&SortKeys](int32 A, int32 B)
+		{
+			for (const FSortKeys& Keys : SortKeys)
+			{
+				int32 Compare;
+				if (Keys.Numbers.Num() > 0)
+					Compare = Keys.Numbers[A] < Keys.Numbers[B] ? -1 : (Keys.Numbers[B] < Keys.Numbers[A] ? 1 : 0);
+				else
+					Compare = FCString::Stricmp(Keys.Strings[A], Keys.Strings[B]);
+				if (Compare != 0)
+					return Keys.bDescending ? Compare > 0 : Compare < 0;
+			}
+			return A < B;
+		});
+	}
+
+	LastOperation = TEXT("Sort");
+	LastOperationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	FilterRows(false);
+}
+
+void SStatisticsTableViewer::FilterRows(bool bInIncremental)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const FTable& Table = Tables[CurrentTable];
+
+	if (FilterText.IsEmpty())
+	{
+		FilteredRows = SortedRows;
+		RefreshItems();
+		return;
+	}
+
+	// A longer text only drops rows, the last result is searched again...
+	TArray<int32> SourceRows = bInIncremental ? MoveTemp(FilteredRows) : SortedRows;
+
+	TArray<const FColumn*, TInlineAllocator<8>> StringColumns;
+	for (TArray<FColumn>::TConstIterator It(Table.Columns); It; ++It)
+	{
+		if ((*It).GetString)
+			StringColumns.Add(&(*It));
+	}
+
+	// Chunks keep the sorted order when joined...
+	const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	const int32 NumChunks = FMath::Clamp(SourceRows.Num() / 4096, 1, NumWorkers * 4);
+	TArray<TArray<int32>> ChunkRows;
+	ChunkRows.SetNum(NumChunks);
+	const TCHAR* Filter = *FilterText;
+	ParallelFor(NumChunks, [&SourceRows, &ChunkRows, &StringColumns, NumChunks, Filter](int32 ChunkIndex)
+	{
+		const int32 First = (int32)((int64)SourceRows.Num() * ChunkIndex / NumChunks);
+		const int32 Last = (int32)((int64)SourceRows.Num() * (ChunkIndex + 1) / NumChunks);
+		TArray<int32>& Rows = ChunkRows[ChunkIndex];
+		for (int32 i = First; i < Last; ++i)
+		{
+			const int32 Row = SourceRows[i];
+			for (const FColumn* Column : StringColumns)
+			{
+				if (FCString::Stristr(Column->GetString(Row), Filter))
+				{
+					Rows.Add(Row);
+					break;
+				}
+			}
+		}
+	});
+
+	int32 NumRows = 0;
+	for (const TArray<int32>& Rows : ChunkRows)
+		NumRows += Rows.Num();
+	FilteredRows.Reset(NumRows);
+	for (const TArray<int32>& Rows : ChunkRows)
+		FilteredRows.Append(Rows);
+
+	LastOperation = bInIncremental ? TEXT("Filter (incremental)") : TEXT("Filter");
+	LastOperationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	RefreshItems();
+}
+
+void SStatisticsTableViewer::RefreshItems()
+{
+	// Aliasing pointers share the reference count of RowItems...
+	VisibleItems.Reset(FilteredRows.Num());
+	if (RowItems.IsValid())
+	{
+		const int32* Items = RowItems->GetData();
+		for (int32 Row : FilteredRows)
+			VisibleItems.Add(FRowItemPtr(RowItems, Items + Row));
+	}
+
+	ListView->RequestListRefresh();
+}
+
+FText SStatisticsTableViewer::GetCellText(int32 InRow, const FName& InColumnId) const
+{
+	const FColumn* Column = Tables[CurrentTable].Columns.FindByPredicate([&InColumnId](const FColumn& InColumn) { return InColumn.Id == InColumnId; });
+	if (!Column)
+		return FText::GetEmpty();
+	if (Column->GetString)
+		return FText::FromString(Column->GetString(InRow));
+
+	FString Str;
+	if (Column->Precision == 0)
+		FFloatFormatter::AppendInteger(Str, (int64)Column->GetNumber(InRow));
+	else
+		FFloatFormatter::Append(Str, Column->GetNumber(InRow), Column->Precision);
+	return FText::FromString(MoveTemp(Str));
+}
+
+TSharedRef<ITableRow> SStatisticsTableViewer::OnGenerateRow(FRowItemPtr InItem, const TSharedRef<STableViewBase>& InOwnerTable)
+{
+	return SNew(SStatisticsTableRow, InOwnerTable).Viewer(this).Row(*InItem);
+}
+
+TSharedRef<SWidget> SStatisticsTableViewer::OnGenerateTableName(TSharedPtr<FString> InName)
+{
+	return SNew(STextBlock).Text(FText::FromString(*InName));
+}
+
+void SStatisticsTableViewer::OnTableNameSelected(TSharedPtr<FString> InName, ESelectInfo::Type InSelectInfo)
+{
+	SelectTable(TableNames.IndexOfByKey(InName));
+}
+
+void SStatisticsTableViewer::OnFilterTextChanged(const FText& InText)
+{
+	const FString NewFilterText = InText.ToString().TrimStartAndEnd();
+	if (NewFilterText == FilterText || CurrentTable == INDEX_NONE)
+		return;
+
+	const bool bIncremental = !FilterText.IsEmpty() && NewFilterText.Contains(FilterText);
+	FilterText = NewFilterText;
+	FilterRows(bIncremental);
+}
+
+void SStatisticsTableViewer::OnSortModeChanged(EColumnSortPriority::Type InPriority, const FName& InColumnId, EColumnSortMode::Type InSortMode)
+{
+	if (InPriority == EColumnSortPriority::Secondary && SortColumns[0] != InColumnId)
+	{
+		SortColumns[1] = InColumnId;
+		SortModes[1] = InSortMode;
+	}
+	else
+	{
+		SortColumns[0] = InColumnId;
+		SortModes[0] = InSortMode;
+		if (SortColumns[1] == InColumnId)
+		{
+			SortColumns[1] = NAME_None;
+			SortModes[1] = EColumnSortMode::None;
+		}
+	}
+	SortRows();
+}
+
+EColumnSortMode::Type SStatisticsTableViewer::GetColumnSortMode(FName InColumnId) const
+{
+	if (SortColumns[0] == InColumnId)
+		return SortModes[0];
+	if (SortColumns[1] == InColumnId)
+		return SortModes[1];
+	return EColumnSortMode::None;
+}
+
+EColumnSortPriority::Type SStatisticsTableViewer::GetColumnSortPriority(FName InColumnId) const
+{
+	return SortColumns[1] == InColumnId ? EColumnSortPriority::Secondary : EColumnSortPriority::Primary;
+}
+
+void SStatisticsTableViewer::OnSelectionChanged(FRowItemPtr InItem, ESelectInfo::Type InSelectInfo)
+{
+	if (InItem.IsValid() && InSelectInfo != ESelectInfo::Direct && Tables[CurrentTable].OnRowClicked)
+		Tables[CurrentTable].OnRowClicked(*InItem, false);
+}
+
+void SStatisticsTableViewer::OnRowDoubleClicked(FRowItemPtr InItem)
+{
+	if (InItem.IsValid() && Tables[CurrentTable].OnRowClicked)
+		Tables[CurrentTable].OnRowClicked(*InItem, true);
+}
+
+FText SStatisticsTableViewer::GetCurrentTableName() const
+{
+	return Tables.IsValidIndex(CurrentTable) ? FText::FromString(Tables[CurrentTable].Name) : LOCTEXT("NoTables", "No export yet");
+}
+
+FText SStatisticsTableViewer::GetStatusText() const
+{
+	if (!Tables.IsValidIndex(CurrentTable))
+		return FText::GetEmpty();
+
+	FString Status;
+	FFloatFormatter::AppendInteger(Status, FilteredRows.Num());
+	Status += TEXT(" / ");
+	FFloatFormatter::AppendInteger(Status, Tables[CurrentTable].NumRows);
+	Status += TEXT(" rows   ") + LastOperation + TEXT(" ");
+	FFloatFormatter::Append(Status, LastOperationMs, 2);
+	Status += TEXT(" ms");
+	return FText::FromString(Status);
+}
+
+void SStatisticsTableViewer::SelectComponentActor(const TWeakObjectPtr<UPrimitiveComponent>& InComponent, bool bInFocus)
+{
+	UPrimitiveComponent* Component = InComponent.Get();
+	AActor* Actor = Component ? Component->GetOwner() : nullptr;
+	if (!Actor || !GEditor)
+	{
+		UE_LOG(LogStatisticsTableViewer, Log, TEXT("Actor of the row is gone, export again"));
+		return;
+	}
+
+	GEditor->SelectNone(false, true, false);
+	GEditor->SelectActor(Actor, true, true, true);
+	if (bInFocus)
+		GEditor->MoveViewportCamerasToActor(*Actor, false);
+}
+
+void SStatisticsTableViewer::SyncBrowserToAsset(FStringPool::FId InAssetPath) const
+{
+	// Assets of the scene are loaded...Nothing is loaded here...
+	UObject* Asset = FindObject<UObject>(nullptr, ExportContext->StringPool[InAssetPath]);
+	if (!Asset || !GEditor)
+		return;
+
+	TArray<UObject*> Assets;
+	Assets.Add(Asset);
+	GEditor->SyncBrowserToObjects(Assets);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -3,14 +3,17 @@
 #include "StatisticsWidget.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SNumericEntryBox.h"
+#include "Widgets/Input/SComboBox.h"
 #include "Widgets/SBoxPanel.h"
 #include "ExporterHelper.h"
+#include "SceneAnalysisHelper.h"
+#include "VisualizationToolLauncher.h"
+#include "StatisticsTableViewer.h"
+#include "Serialization/MemoryWriter.h"
 #include "Editor/UnrealEd/Public/Dialogs/SOutputLogDialog.h"
 #include "Developer/SlateFileDialogs/Public/SlateFileDialogs.h"
 #include "HAL/PlatformProcess.h"
 #include "Developer/DesktopPlatform/Public/DesktopPlatformModule.h"
-#include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
-// #include "Runtime/Engine/Classes/Kismet/KismetSystemLibrary.h" // PrintString()
 
 DEFINE_LOG_CATEGORY_STATIC(Ansys_Zheng, Warning, All)
 
@@ -21,6 +24,10 @@ void SStatisticsWidget::Construct(const FArguments& InArgs)
 {
 	FString InString = InArgs._InText.Get();
 
+	HeatmapMetric = FSceneHeatmap::EMetric::Triangles;
+	for (uint8 Metric = 0; Metric < (uint8)FSceneHeatmap::EMetric::Num; ++Metric)
+		HeatmapMetricNames.Add(MakeShared<FString>(FSceneHeatmap::GetMetricName((FSceneHeatmap::EMetric)Metric)));
+
 	this->ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -96,6 +103,45 @@ void SStatisticsWidget::Construct(const FArguments& InArgs)
 				SNew(SButton).Text(LOCTEXT("Ansys", "启动可视化"))
 				.OnClicked(this, &SStatisticsWidget::OnButtonAnalysisClicked)
 			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f)
+			[
+				SNew(SButton).Text(LOCTEXT("Tables", "浏览表格"))
+				.OnClicked(this, &SStatisticsWidget::OnButtonTablesClicked)
+			]
+		]
+		+SVerticalBox::Slot()
+		.Padding(FMargin(0.0f, 0.0f, 0.0f, 4.0f))
+		.AutoHeight()
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(FMargin(0.0f, 0.0f, 8.0f, 0.0f))
+			[
+				SNew(SComboBox<TSharedPtr<FString>>)
+				.OptionsSource(&HeatmapMetricNames)
+				.OnGenerateWidget_Lambda([](TSharedPtr<FString> InName) { return SNew(STextBlock).Text(FText::FromString(*InName)); })
+				.OnSelectionChanged(this, &SStatisticsWidget::OnHeatmapMetricSelected)
+				[
+					SNew(STextBlock).Text_Lambda([this]() { return FText::FromString(FSceneHeatmap::GetMetricName(HeatmapMetric)); })
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f)
+			[
+				SNew(SButton).Text(LOCTEXT("ShowHeatmap", "显示热力图"))
+				.OnClicked(this, &SStatisticsWidget::OnButtonShowHeatmapClicked)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f)
+			[
+				SNew(SButton).Text(LOCTEXT("HideHeatmap", "隐藏热力图"))
+				.OnClicked(this, &SStatisticsWidget::OnButtonHideHeatmapClicked)
+			]
 		]
 		+SVerticalBox::Slot().AutoHeight()
 		[
@@ -138,8 +184,16 @@ FReply SStatisticsWidget::OnButtonExportClicked()
 	// to do export...
 	FPlatformProcess::ExploreFolder(OutputPath.GetCharArray().GetData());
 
+	// Released before the next export gathers...
+	LastExportContext.Reset();
+	LastExportContext = MakeShared<FExporterHelper::FExportContext>();
+	FExporterHelper::FExportContext& ExportContext = *LastExportContext;
+	ExportContext.Settings.LoadConfig(FPaths::ProjectPluginsDir() + "Statistics/Config/PluginSetting.ini");
+
 	TMap<FString, bool> ResultPathsStates;
-	FExporterHelper::ExportSceneDataToCSV(ResultPathsStates, OutputPath);
+	FExporterHelper::ExportSceneDataToCSV(ResultPathsStates, OutputPath, ExportContext);
+	FSceneAnalysisHelper::ExportSceneAnalysesToCSV(ResultPathsStates, OutputPath, ExportContext);
+
 	FString OutputLogs; OutputLogs.Empty();
 	for (TMap<FString, bool>::TIterator It(ResultPathsStates); It; ++It)
 	{
@@ -154,6 +208,11 @@ FReply SStatisticsWidget::OnButtonExportClicked()
 			UE_LOG(Ansys_Zheng, Warning, TEXT("Save to [%s] Failed!"), (*It).Key.GetCharArray().GetData()); 
 		}
 	}
+	for (TArray<FString>::TIterator It(ExportContext.Notes); It; ++It)
+	{
+		OutputLogs += "-> " + (*It) + "\n";
+		UE_LOG(Ansys_Zheng, Warning, TEXT("%s"), (*It).GetCharArray().GetData());
+	}
 	
 	SOutputLogDialog::Open(FText::FromString("Hint"), FText::FromString("Export Scene data..."), FText::FromString(OutputLogs));
 	
@@ -170,12 +229,27 @@ FReply SStatisticsWidget::OnButtonAnalysisClicked()
 	LOCTEXT("Hints", "启动可视化");	
 	
 	FString WorldName = FExporterHelper::GetWorld()->GetName();
-	FString PlatformName;
-	PlatformName = UGameplayStatics::GetPlatformName();
-	// UKismetSystemLibrary::PrintString(nullptr, platformName, true, true, FLinearColor(0.000000, 0.660000, 1.000000, 1.000000), 2.000000);
-	if (PlatformName == "Windows")
+
+	FVisualizationToolLauncher::FSettings LaunchSettings;
+	LaunchSettings.LoadConfig(FPaths::ProjectPluginsDir() + "Statistics/Config/PluginSetting.ini");
+
+	TArray<uint8> WorldTables;
+	if (LaunchSettings.bSharedMemory && LastExportContext.IsValid() && LastExportContext->WorldSceneDataSets.Num() > 0)
 	{
-		_wsystem(FString(VisualizationToolPath + "/D3DVisualizationTool.exe -dir [" + OutputPath + "/World_" + WorldName + "] -scale [" + FString::SanitizeFloat(_Scale) + "]").GetCharArray().GetData());
+		FMemoryWriter Writer(WorldTables);
+		FExporterHelper::SaveSceneDataSetsToBinary(LastExportContext->WorldSceneDataSets, LastExportContext->StringPool, LastExportContext->IndexPool, Writer);
+	}
+
+	// Does not wait for the viewer...
+	FString LaunchError;
+	if (!FVisualizationToolLauncher::Launch(VisualizationToolPath, LaunchSettings, OutputPath + "/World_" + WorldName, _Scale, WorldTables, LaunchError))
+	{
+		UE_LOG(Ansys_Zheng, Warning, TEXT("%s"), *LaunchError);
+		SOutputLogDialog::Open(FText::FromString("Hint"), FText::FromString("Launch Visualization Tool..."), FText::FromString(LaunchError));
+	}
+	else if (!LaunchError.IsEmpty())
+	{
+		UE_LOG(Ansys_Zheng, Warning, TEXT("%s"), *LaunchError);
 	}
 
 	SaveScale();
@@ -183,6 +257,72 @@ FReply SStatisticsWidget::OnButtonAnalysisClicked()
 	return FReply::Handled();
 }
 
+FReply SStatisticsWidget::OnButtonTablesClicked()
+{
+	if (!LastExportContext.IsValid() || LastExportContext->WorldSceneDataSets.Num() == 0)
+	{
+		SOutputLogDialog::Open(FText::FromString("Hint"), FText::FromString("Browse Tables..."), LOCTEXT("NoExport", "请先导出场景数据!"));
+		return FReply::Handled();
+	}
+
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(FText::FromString("Statistics Tables - " + LastExportContext->WorldName))
+		.ClientSize(FVector2D(1280.0f, 720.0f))
+		[
+			SNew(SStatisticsTableViewer).ExportContext(LastExportContext)
+		];
+	FSlateApplication::Get().AddWindow(Window);
+
+	return FReply::Handled();
+}
+
+FReply SStatisticsWidget::OnButtonShowHeatmapClicked()
+{
+	if (!LastExportContext.IsValid() || LastExportContext->WorldSceneDataSets.Num() == 0)
+	{
+		SOutputLogDialog::Open(FText::FromString("Hint"), FText::FromString("Show Heatmap..."), LOCTEXT("NoExport", "请先导出场景数据!"));
+		return FReply::Handled();
+	}
+
+	ShowHeatmap();
+
+	return FReply::Handled();
+}
+
+FReply SStatisticsWidget::OnButtonHideHeatmapClicked()
+{
+	if (Heatmap.IsValid())
+		Heatmap->Hide();
+
+	return FReply::Handled();
+}
+
+void SStatisticsWidget::OnHeatmapMetricSelected(TSharedPtr<FString> InName, ESelectInfo::Type InSelectInfo)
+{
+	const int32 Metric = HeatmapMetricNames.IndexOfByKey(InName);
+	if (Metric == INDEX_NONE)
+		return;
+
+	HeatmapMetric = (FSceneHeatmap::EMetric)Metric;
+	if (Heatmap.IsValid() && Heatmap->IsShown())
+		ShowHeatmap();
+}
+
+void SStatisticsWidget::ShowHeatmap()
+{
+	if (!LastExportContext.IsValid())
+		return;
+
+	FSceneHeatmap::FSettings HeatmapSettings;
+	HeatmapSettings.LoadConfig(FPaths::ProjectPluginsDir() + "Statistics/Config/PluginSetting.ini");
+
+	if (!Heatmap.IsValid())
+		Heatmap = MakeShared<FSceneHeatmap>();
+	// Drawn over the World that was exported...
+	if (!Heatmap->Show(FExporterHelper::GetWorld(), *LastExportContext, HeatmapMetric, HeatmapSettings))
+		UE_LOG(Ansys_Zheng, Warning, TEXT("No World tables for the heatmap, export again"));
+}
+
 void SStatisticsWidget::OnSliderValueChanged(float InVal)
 {
 	_Scale = InVal;
@@ -0,0 +1,134 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Package.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/FileHelper.h"
+
+/** Analysis results that only depend on the asset...Kept on disk across exports, keyed by asset path and package guid... */
+class FAssetAnalysisCache
+{
+public:
+
+	FAssetAnalysisCache() : NumHits(0), NumMisses(0), bDirty(false) {}
+
+	bool Load(const FString& InFilePath)
+	{
+		FilePath = InFilePath;
+		Entries.Empty();
+
+		TArray<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *InFilePath, FILEREAD_Silent))
+			return false;
+
+		FMemoryReader Reader(FileData);
+		uint32 FileMagic = 0, FileVersion = 0;
+		Reader << FileMagic << FileVersion;
+		if (FileMagic != Magic || FileVersion != Version)
+			return false;
+
+		int32 NumEntries = 0;
+		Reader << NumEntries;
+		Entries.Reserve(NumEntries);
+		for (int32 i = 0; i < NumEntries && !Reader.IsError(); ++i)
+		{
+			FString Key;
+			FEntry Entry;
+			Reader << Key << Entry.Guid << Entry.Data;
+			Entries.Add(MoveTemp(Key), MoveTemp(Entry));
+		}
+
+		// Truncated file...Start over...
+		if (Reader.IsError())
+			Entries.Empty();
+
+		return Entries.Num() > 0;
+	}
+
+	bool Save()
+	{
+		if (!bDirty || FilePath.IsEmpty())
+			return true;
+
+		FBufferArchive Writer;
+		uint32 FileMagic = Magic, FileVersion = Version;
+		int32 NumEntries = Entries.Num();
+		Writer << FileMagic << FileVersion << NumEntries;
+		for (TMap<FString, FEntry>::TIterator It(Entries); It; ++It)
+			Writer << It.Key() << It.Value().Guid << It.Value().Data;
+
+		bDirty = false;
+		return FFileHelper::SaveArrayToFile(Writer, *FilePath);
+	}
+
+	/** Saved package guid of the asset...Dirty or never saved packages are not cached... */
+	static bool GetAssetGuid(const UObject* InAsset, FGuid& OutGuid)
+	{
+		const UPackage* Package = InAsset ? InAsset->GetOutermost() : nullptr;
+		if (!Package || Package->IsDirty() || Package == GetTransientPackage())
+			return false;
+
+		OutGuid = Package->GetGuid();
+		return OutGuid.IsValid();
+	}
+
+	/** Data of an unchanged asset...Only valid until the next Add()... */
+	const TArray<uint8>* Find(const TCHAR* InCategory, const UObject* InAsset)
+	{
+		FGuid Guid;
+		const FEntry* Entry = GetAssetGuid(InAsset, Guid) ? Entries.Find(MakeKey(InCategory, InAsset)) : nullptr;
+		if (Entry && Entry->Guid == Guid)
+		{
+			NumHits++;
+			return &Entry->Data;
+		}
+
+		NumMisses++;
+		return nullptr;
+	}
+
+	/** Replaces the data of older versions of the asset... */
+	void Add(const TCHAR* InCategory, const UObject* InAsset, TArray<uint8>&& InData)
+	{
+		FGuid Guid;
+		if (!GetAssetGuid(InAsset, Guid))
+			return;
+
+		FEntry& Entry = Entries.FindOrAdd(MakeKey(InCategory, InAsset));
+		Entry.Guid = Guid;
+		Entry.Data = MoveTemp(InData);
+		bDirty = true;
+	}
+
+	int32 Num() const { return Entries.Num(); }
+	const FString& GetFilePath() const { return FilePath; }
+	int32 GetNumHits() const { return NumHits; }
+	int32 GetNumMisses() const { return NumMisses; }
+
+private:
+
+	static FString MakeKey(const TCHAR* InCategory, const UObject* InAsset)
+	{
+		return FString(InCategory) + TEXT(":") + InAsset->GetPathName();
+	}
+
+	struct FEntry
+	{
+		FGuid Guid;
+		TArray<uint8> Data;
+	};
+
+	// Bump when the layout of any cached data changes...
+	static const uint32 Magic = 0x43414153; // SAAC
+	static const uint32 Version = 1;
+
+	FString FilePath;
+	TMap<FString, FEntry> Entries;
+
+	int32 NumHits;
+	int32 NumMisses;
+	bool  bDirty;
+};
@@ -0,0 +1,166 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "IndexPool.h"
+
+/** Columns of the exported tables in one binary file...Opened with memory mapping by Tools/StatisticsReader...
+ *
+ *  Header     : uint32 Magic 'STBF', uint32 Version, uint32 NumColumns, uint32 Reserved...
+ *  Columns    : NumColumns x { char Name[48], uint32 Type, uint32 NumComponents, uint64 NumRows, uint64 Offset }...
+ *  Column data: Rows x Components, little endian, every column aligned to 64 bytes...
+ */
+class FBinaryTableWriter
+{
+public:
+
+	enum class EColumnType : uint32
+	{
+		UInt8,
+		UInt16,
+		UInt32,
+		UInt64,
+		Int32,
+		Float
+	};
+
+	/** Column type and components of a value type... */
+	template<typename ValueType> struct TColumnTraits;
+
+	/** Columns only keep the pointer...Data must stay alive until Save()... */
+	template<typename ValueType>
+	void AddColumn(const FString& InName, const ValueType* InData, int64 InNumRows)
+	{
+		FColumn& Column = Columns.AddDefaulted_GetRef();
+		Column.Name = InName;
+		Column.Type = TColumnTraits<ValueType>::Type;
+		Column.NumComponents = TColumnTraits<ValueType>::NumComponents;
+		Column.NumRows = InNumRows;
+		Column.ExternalData = (const uint8*)InData;
+	}
+
+	/** One field of every row, copied into a column... */
+	template<typename RowType, typename GetterType>
+	void AddColumn(const FString& InName, const TArray<RowType>& InRows, GetterType InGetter)
+	{
+		typedef typename TDecay<decltype(InGetter(InRows[0]))>::Type ValueType;
+
+		FColumn& Column = Columns.AddDefaulted_GetRef();
+		Column.Name = InName;
+		Column.Type = TColumnTraits<ValueType>::Type;
+		Column.NumComponents = TColumnTraits<ValueType>::NumComponents;
+		Column.NumRows = InRows.Num();
+		Column.Data.SetNumUninitialized(InRows.Num() * sizeof(ValueType));
+
+		ValueType* Values = (ValueType*)Column.Data.GetData();
+		for (int32 i = 0; i < InRows.Num(); ++i)
+			Values[i] = InGetter(InRows[i]);
+	}
+
+	bool Save(const FString& InFilePath)
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*InFilePath));
+		if (!Writer)
+			return false;
+
+		Save(*Writer);
+		return Writer->Close();
+	}
+
+	/** Same bytes as the file...A FMemoryWriter gives the tables without a file... */
+	void Save(FArchive& InOutWriter)
+	{
+		FArchive* Writer = &InOutWriter;
+
+		uint32 FileMagic = Magic, FileVersion = Version, NumColumns = Columns.Num(), Reserved = 0;
+		*Writer << FileMagic << FileVersion << NumColumns << Reserved;
+
+		// Descriptors first...Offsets are known from the sizes...
+		uint64 Offset = Align(HeaderBytes + (uint64)Columns.Num() * ColumnBytes, DataAlignment);
+		for (TArray<FColumn>::TIterator It(Columns); It; ++It)
+		{
+			ANSICHAR Name[NameBytes];
+			FMemory::Memzero(Name);
+			FTCHARToUTF8 NameUTF8(*(*It).Name);
+			FMemory::Memcpy(Name, NameUTF8.Get(), FMath::Min(NameUTF8.Length(), NameBytes - 1));
+
+			uint32 Type = (uint32)(*It).Type;
+			uint64 NumRows = (*It).NumRows;
+			Writer->Serialize(Name, NameBytes);
+			*Writer << Type << (*It).NumComponents << NumRows << Offset;
+
+			Offset = Align(Offset + (*It).GetNumBytes(), DataAlignment);
+		}
+
+		for (TArray<FColumn>::TIterator It(Columns); It; ++It)
+		{
+			WritePadding(*Writer);
+			Writer->Serialize((void*)(*It).GetData(), (*It).GetNumBytes());
+		}
+	}
+
+private:
+
+	struct FColumn
+	{
+		FString		Name;
+		EColumnType Type;
+		uint32		NumComponents;
+		int64		NumRows;
+		TArray<uint8> Data;
+		const uint8*  ExternalData;
+
+		FColumn() : Type(EColumnType::UInt8), NumComponents(1), NumRows(0), ExternalData(nullptr) {}
+
+		const uint8* GetData() const { return ExternalData ? ExternalData : Data.GetData(); }
+		int64 GetNumBytes() const { return NumRows * NumComponents * GetTypeBytes(Type); }
+	};
+
+	static int64 GetTypeBytes(EColumnType InType)
+	{
+		switch (InType)
+		{
+		case EColumnType::UInt8:  return 1;
+		case EColumnType::UInt16: return 2;
+		case EColumnType::UInt64: return 8;
+		default:				  return 4;
+		}
+	}
+
+	static uint64 Align(uint64 InOffset, uint64 InAlignment)
+	{
+		return (InOffset + InAlignment - 1) & ~(InAlignment - 1);
+	}
+
+	static void WritePadding(FArchive& InOutWriter)
+	{
+		static const uint8 Zeros[DataAlignment] = { 0 };
+		const int64 Padding = Align(InOutWriter.Tell(), DataAlignment) - InOutWriter.Tell();
+		if (Padding > 0)
+			InOutWriter.Serialize((void*)Zeros, Padding);
+	}
+
+	static const uint32 Magic = 0x46425453; // STBF
+	static const uint32 Version = 1;
+	static const int32  NameBytes = 48;
+	static const uint64 HeaderBytes = 16;
+	static const uint64 ColumnBytes = NameBytes + 4 + 4 + 8 + 8;
+	static const uint64 DataAlignment = 64;
+
+	TArray<FColumn> Columns;
+};
+
+template<> struct FBinaryTableWriter::TColumnTraits<uint8>	{ static const EColumnType Type = EColumnType::UInt8;  static const uint32 NumComponents = 1; };
+template<> struct FBinaryTableWriter::TColumnTraits<uint16> { static const EColumnType Type = EColumnType::UInt16; static const uint32 NumComponents = 1; };
+template<> struct FBinaryTableWriter::TColumnTraits<uint32> { static const EColumnType Type = EColumnType::UInt32; static const uint32 NumComponents = 1; };
+template<> struct FBinaryTableWriter::TColumnTraits<uint64> { static const EColumnType Type = EColumnType::UInt64; static const uint32 NumComponents = 1; };
+template<> struct FBinaryTableWriter::TColumnTraits<int32>	{ static const EColumnType Type = EColumnType::Int32;  static const uint32 NumComponents = 1; };
+template<> struct FBinaryTableWriter::TColumnTraits<float>	{ static const EColumnType Type = EColumnType::Float;  static const uint32 NumComponents = 1; };
+template<> struct FBinaryTableWriter::TColumnTraits<FVector> { static const EColumnType Type = EColumnType::Float; static const uint32 NumComponents = 3; };
+template<> struct FBinaryTableWriter::TColumnTraits<FMatrix> { static const EColumnType Type = EColumnType::Float; static const uint32 NumComponents = 16; };
+template<> struct FBinaryTableWriter::TColumnTraits<FIndexSpan> { static const EColumnType Type = EColumnType::Int32; static const uint32 NumComponents = 2; };
+
+static_assert(sizeof(FVector) == 3 * sizeof(float) && sizeof(FMatrix) == 16 * sizeof(float), "Float columns are written as raw memory...");
+static_assert(sizeof(FIndexSpan) == 2 * sizeof(int32), "Span columns are written as raw memory...");
@@ -0,0 +1,112 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Async/ParallelFor.h"
+
+/** Large text output compressed in independent chunks on all cores...
+ *
+ *  Gzip : every chunk is a gzip member, the file is a plain .gz any tool reads...
+ *  Other: FCompression formats (Zlib, LZ4, Oodle if registered) in a chunk container...
+ *         uint32 Magic 'SCZF', uint32 Version, FString Format, int32 NumChunks, then NumChunks x { int32 UncompressedSize, int32 CompressedSize, Data }...
+ */
+class FCompressedFileWriter
+{
+public:
+
+	static bool IsFormatSupported(FName InFormat)
+	{
+		return InFormat != NAME_None && FCompression::IsFormatValid(InFormat);
+	}
+
+	static FString GetFileExtension(FName InFormat)
+	{
+		return InFormat == NAME_Gzip ? TEXT(".gz") : TEXT(".z");
+	}
+
+	/** Text as UTF-8...Path gets the extension of the format... */
+	static bool SaveStringToFile(const FString& InString, FString& InOutFilePath, FName InFormat, int32 InChunkChars)
+	{
+		InOutFilePath += GetFileExtension(InFormat);
+
+		const int32 Len = InString.Len();
+		const int32 ChunkChars = FMath::Max(InChunkChars, 4096);
+		const int32 NumChunks = FMath::Max(FMath::DivideAndRoundUp(Len, ChunkChars), 1);
+
+		// Chunk bounds...Never split a surrogate pair...
+		TArray<int32> ChunkStarts;
+		ChunkStarts.SetNumUninitialized(NumChunks + 1);
+		ChunkStarts[0] = 0;
+		for (int32 i = 1; i < NumChunks; ++i)
+		{
+			int32 Start = FMath::Min(i * ChunkChars, Len);
+			if (Start < Len && Start > ChunkStarts[i - 1] + 1 && IsLowSurrogate(InString[Start]))
+				Start--;
+			ChunkStarts[i] = Start;
+		}
+		ChunkStarts[NumChunks] = Len;
+
+		TArray<TArray<uint8>> CompressedChunks;
+		TArray<int32> UncompressedSizes;
+		CompressedChunks.AddDefaulted(NumChunks);
+		UncompressedSizes.SetNumZeroed(NumChunks);
+		TAtomic<bool> bFailed(false);
+
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			const int32 Start = ChunkStarts[ChunkIndex];
+			FTCHARToUTF8 ChunkUTF8(*InString + Start, ChunkStarts[ChunkIndex + 1] - Start);
+
+			TArray<uint8>& Compressed = CompressedChunks[ChunkIndex];
+			int32 CompressedSize = FCompression::CompressMemoryBound(InFormat, ChunkUTF8.Length());
+			Compressed.SetNumUninitialized(CompressedSize);
+			if (!FCompression::CompressMemory(InFormat, Compressed.GetData(), CompressedSize, ChunkUTF8.Get(), ChunkUTF8.Length()))
+			{
+				bFailed = true;
+				return;
+			}
+			Compressed.SetNum(CompressedSize, false);
+			UncompressedSizes[ChunkIndex] = ChunkUTF8.Length();
+		});
+
+		if (bFailed)
+			return false;
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*InOutFilePath));
+		if (!Writer)
+			return false;
+
+		const bool bContainer = InFormat != NAME_Gzip;
+		if (bContainer)
+		{
+			uint32 FileMagic = Magic, FileVersion = Version;
+			FString Format = InFormat.ToString();
+			int32 NumChunksToWrite = NumChunks;
+			*Writer << FileMagic << FileVersion << Format << NumChunksToWrite;
+		}
+		for (int32 i = 0; i < NumChunks; ++i)
+		{
+			if (bContainer)
+			{
+				int32 CompressedSize = CompressedChunks[i].Num();
+				*Writer << UncompressedSizes[i] << CompressedSize;
+			}
+			Writer->Serialize(CompressedChunks[i].GetData(), CompressedChunks[i].Num());
+		}
+
+		return Writer->Close();
+	}
+
+private:
+
+	static bool IsLowSurrogate(TCHAR InChar)
+	{
+		return sizeof(TCHAR) == 2 && InChar >= 0xDC00 && InChar <= 0xDFFF;
+	}
+
+	static const uint32 Magic = 0x465A4353; // SCZF
+	static const uint32 Version = 1;
+};
@@ -10,9 +10,22 @@
 #include "Misc/FileHelper.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Rendering/SkeletalMeshRenderData.h"
+#include "SkeletalRenderPublic.h"
 #include "LandscapeComponent.h"
 #include "Components/ModelComponent.h"
 #include "Runtime/RenderCore/Public/RenderUtils.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Async/ParallelFor.h"
+#include "Misc/MemStack.h"
+#include "ShaderCompiler.h"
+#include "TextureWhatIfEngine.h"
+#include "StringPool.h"
+#include "IndexPool.h"
+#include "AssetAnalysisCache.h"
+#include "SceneRollup.h"
+#include "BinaryTableWriter.h"
+#include "FloatFormatter.h"
+#include "CompressedFileWriter.h"
 
 class FBoxContainer
 {
@@ -55,35 +68,279 @@ class FExporterHelper
 {
 public:	
 
+	/** Options of an export...Loaded from PluginSetting.ini... */
+	struct FExportSettings
+	{
+	public:
+
+		// Material stats are gathered for every (feature level, quality level) pair...
+		TArray<ERHIFeatureLevel::Type>		MaterialFeatureLevels;
+		TArray<EMaterialQualityLevel::Type> MaterialQualityLevels;
+		// Seconds to wait for shader maps still compiling before the materials tables are written...
+		float PendingShaderStatsTimeout;
+
+		// Texture streaming simulation...Camera path is sampled every StreamingPathStep units...
+		TArray<FVector> StreamingViewPoints;
+		float StreamingPathStep;
+		float StreamingPoolSizeMB;
+		float StreamingScreenHeight;
+		float StreamingFOV;
+
+		// Texture memory what-if scenarios...
+		TArray<FTextureWhatIfEngine::FScenario> TextureWhatIfScenarios;
+
+		// Asset analyses of unchanged assets are loaded from the output dir, see FAssetAnalysisCache...
+		bool bUseAssetCache;
+
+		// Nodes of every type listed in the scene rollup summary...
+		int32 RollupTopN;
+
+		// Opt-in...Tables are also written as one memory mappable file per World and Level, see FBinaryTableWriter...
+		bool bWriteBinaryTables;
+
+		// Decimals of the float columns of the CSV tables...
+		FFloatFormatter::FPrecisions FloatPrecisions;
+
+		// CSV tables compressed in chunks of CompressionChunkKB, see FCompressedFileWriter...None writes plain text...
+		FName CompressionFormat;
+		int32 CompressionChunkKB;
+
+		// Dynamic lights counted per XY cell, see FLightStatistics...Cells grow until the grid fits in LightGridMaxCells...
+		float LightGridCellSize;
+		int32 LightGridMaxCells;
+
+		// Same mesh and materials on at least InstancingMinGroupSize components, see FInstancingDetector...
+		int32 InstancingMinGroupSize;
+		float InstancingClusterSize;
+		// Small static primitives with the same materials within MergeRadius, see FMergeClusterFinder...
+		float MergeRadius;
+		float MergeMaxPrimitiveRadius;
+		int32 MergeMinClusterSize;
+
+		// Textures with the same source mip 0, see FTextureDuplicateFinder...Source mips are copied DuplicateTextureBudgetMB at a time...
+		bool bFindDuplicateTextures;
+		bool bPerceptualTextureHash;
+		int32 DuplicateTextureMaxDistance;
+		int32 DuplicateTextureBudgetMB;
+
+		// LODs above MaxACMR or MaxSubPixelTriangleShare are flagged for a rebuild, see FMeshEfficiencyAnalyzer...
+		int32 VertexCacheSize;
+		float MaxACMR;
+		float MaxSubPixelTriangleShare;
+
+		// LOD screen sizes against player positions, see FLODScreenSizeAudit...Same FOV and screen height as the streaming simulation...
+		bool  bLODAuditNavMesh;
+		float LODAuditGridCellSize;
+		int32 LODAuditMaxPositions;
+		float LODAuditEyeHeight;
+		float LODAuditViewDistance;
+		float LODAuditMinLODUsage;
+		float LODAuditMaxTrianglesPerPixel;
+		float LODAuditMaxDenseShare;
+
+		FExportSettings()
+		{
+			FTextureWhatIfEngine::GetDefaultScenarios(TextureWhatIfScenarios);
+
+			PendingShaderStatsTimeout = 120.f;
+			bUseAssetCache = true;
+			RollupTopN = 50;
+			bWriteBinaryTables = false;
+			CompressionFormat = NAME_None;
+			CompressionChunkKB = 1024;
+			LightGridCellSize = 1000.f;
+			LightGridMaxCells = 1024 * 1024;
+			InstancingMinGroupSize = 10;
+			InstancingClusterSize = 5000.f;
+			MergeRadius = 2000.f;
+			MergeMaxPrimitiveRadius = 500.f;
+			MergeMinClusterSize = 2;
+			bFindDuplicateTextures = true;
+			bPerceptualTextureHash = false;
+			DuplicateTextureMaxDistance = 0;
+			DuplicateTextureBudgetMB = 512;
+			VertexCacheSize = 32;
+			MaxACMR = 1.f;
+			MaxSubPixelTriangleShare = 0.5f;
+			bLODAuditNavMesh = false;
+			LODAuditGridCellSize = 2000.f;
+			LODAuditMaxPositions = 4096;
+			LODAuditEyeHeight = 170.f;
+			LODAuditViewDistance = 50000.f;
+			LODAuditMinLODUsage = 0.02f;
+			LODAuditMaxTrianglesPerPixel = 0.1f;
+			LODAuditMaxDenseShare = 0.1f;
+
+			StreamingPathStep = 1000.f;
+			StreamingPoolSizeMB = 1000.f;
+			StreamingScreenHeight = 1080.f;
+			StreamingFOV = 90.f;
+			MaterialFeatureLevels.Add(GMaxRHIFeatureLevel);
+			MaterialQualityLevels.Add(EMaterialQualityLevel::Num); // Num is the active quality level...
+		}
+
+		void LoadConfig(const FString& InConfigFile)
+		{
+			FString FeatureLevels;
+			if (GConfig->GetString(TEXT("MaterialStats"), TEXT("FeatureLevels"), FeatureLevels, InConfigFile))
+			{
+				TArray<FString> Names;
+				FeatureLevels.ParseIntoArray(Names, TEXT(","));
+
+				MaterialFeatureLevels.Empty();
+				for (TArray<FString>::TIterator It(Names); It; ++It)
+				{
+					ERHIFeatureLevel::Type FeatureLevel;
+					if (GetFeatureLevelFromName(FName(*(*It).TrimStartAndEnd()), FeatureLevel))
+						MaterialFeatureLevels.AddUnique(FeatureLevel);
+				}
+				if (MaterialFeatureLevels.Num() == 0)
+					MaterialFeatureLevels.Add(GMaxRHIFeatureLevel);
+			}
+
+			FString QualityLevels;
+			if (GConfig->GetString(TEXT("MaterialStats"), TEXT("QualityLevels"), QualityLevels, InConfigFile))
+			{
+				TArray<FString> Names;
+				QualityLevels.ParseIntoArray(Names, TEXT(","));
+
+				MaterialQualityLevels.Empty();
+				for (TArray<FString>::TIterator It(Names); It; ++It)
+				{
+					for (int32 QualityLevel = 0; QualityLevel < EMaterialQualityLevel::Num; ++QualityLevel)
+					{
+						FString QualityLevelName;
+						GetMaterialQualityLevelName((EMaterialQualityLevel::Type)QualityLevel, QualityLevelName);
+						if (QualityLevelName == (*It).TrimStartAndEnd())
+							MaterialQualityLevels.AddUnique((EMaterialQualityLevel::Type)QualityLevel);
+					}
+				}
+				if (MaterialQualityLevels.Num() == 0)
+					MaterialQualityLevels.Add(EMaterialQualityLevel::Num);
+			}
+
+			GConfig->GetFloat(TEXT("MaterialStats"), TEXT("PendingTimeout"), PendingShaderStatsTimeout, InConfigFile);
+			GConfig->GetBool(TEXT("AssetCache"), TEXT("Enabled"), bUseAssetCache, InConfigFile);
+			GConfig->GetInt(TEXT("SceneRollup"), TEXT("TopN"), RollupTopN, InConfigFile);
+			GConfig->GetBool(TEXT("BinaryTables"), TEXT("Enabled"), bWriteBinaryTables, InConfigFile);
+			GConfig->GetInt(TEXT("FloatFormat"), TEXT("Transforms"), FloatPrecisions.Transforms, InConfigFile);
+			GConfig->GetInt(TEXT("FloatFormat"), TEXT("Bounds"), FloatPrecisions.Bounds, InConfigFile);
+			GConfig->GetInt(TEXT("FloatFormat"), TEXT("KB"), FloatPrecisions.KB, InConfigFile);
+			GConfig->GetInt(TEXT("FloatFormat"), TEXT("Default"), FloatPrecisions.Default, InConfigFile);
+			GConfig->GetBool(TEXT("FloatFormat"), TEXT("DeltaTransforms"), FloatPrecisions.bDeltaTransforms, InConfigFile);
+
+			FString Compression;
+			if (GConfig->GetString(TEXT("Compression"), TEXT("Format"), Compression, InConfigFile))
+			{
+				CompressionFormat = FName(*Compression.TrimStartAndEnd());
+				if (!FCompressedFileWriter::IsFormatSupported(CompressionFormat))
+					CompressionFormat = NAME_None;
+			}
+			GConfig->GetInt(TEXT("Compression"), TEXT("ChunkKB"), CompressionChunkKB, InConfigFile);
+			GConfig->GetFloat(TEXT("Lights"), TEXT("GridCellSize"), LightGridCellSize, InConfigFile);
+			GConfig->GetInt(TEXT("Lights"), TEXT("GridMaxCells"), LightGridMaxCells, InConfigFile);
+			LightGridCellSize = FMath::Max(LightGridCellSize, 1.f);
+			LightGridMaxCells = FMath::Max(LightGridMaxCells, 1);
+			GConfig->GetInt(TEXT("Instancing"), TEXT("MinGroupSize"), InstancingMinGroupSize, InConfigFile);
+			GConfig->GetFloat(TEXT("Instancing"), TEXT("ClusterSize"), InstancingClusterSize, InConfigFile);
+			InstancingMinGroupSize = FMath::Max(InstancingMinGroupSize, 2);
+			InstancingClusterSize = FMath::Max(InstancingClusterSize, 1.f);
+
+			GConfig->GetFloat(TEXT("MeshMerge"), TEXT("Radius"), MergeRadius, InConfigFile);
+			GConfig->GetFloat(TEXT("MeshMerge"), TEXT("MaxPrimitiveRadius"), MergeMaxPrimitiveRadius, InConfigFile);
+			GConfig->GetInt(TEXT("MeshMerge"), TEXT("MinClusterSize"), MergeMinClusterSize, InConfigFile);
+			MergeRadius = FMath::Max(MergeRadius, 0.f);
+			MergeMinClusterSize = FMath::Max(MergeMinClusterSize, 2);
+
+			FString DuplicateTextureMode;
+			GConfig->GetBool(TEXT("TextureDuplicates"), TEXT("Enabled"), bFindDuplicateTextures, InConfigFile);
+			if (GConfig->GetString(TEXT("TextureDuplicates"), TEXT("Mode"), DuplicateTextureMode, InConfigFile))
+				bPerceptualTextureHash = DuplicateTextureMode.Equals(TEXT("Perceptual"), ESearchCase::IgnoreCase);
+			GConfig->GetInt(TEXT("TextureDuplicates"), TEXT("MaxDistance"), DuplicateTextureMaxDistance, InConfigFile);
+			GConfig->GetInt(TEXT("TextureDuplicates"), TEXT("BudgetMB"), DuplicateTextureBudgetMB, InConfigFile);
+			DuplicateTextureMaxDistance = FMath::Clamp(DuplicateTextureMaxDistance, 0, 64);
+			DuplicateTextureBudgetMB = FMath::Max(DuplicateTextureBudgetMB, 1);
+
+			GConfig->GetInt(TEXT("MeshEfficiency"), TEXT("VertexCacheSize"), VertexCacheSize, InConfigFile);
+			GConfig->GetFloat(TEXT("MeshEfficiency"), TEXT("MaxACMR"), MaxACMR, InConfigFile);
+			GConfig->GetFloat(TEXT("MeshEfficiency"), TEXT("MaxSubPixelShare"), MaxSubPixelTriangleShare, InConfigFile);
+			VertexCacheSize = FMath::Max(VertexCacheSize, 1);
+
+			FString LODAuditPositions;
+			if (GConfig->GetString(TEXT("LODAudit"), TEXT("Positions"), LODAuditPositions, InConfigFile))
+				bLODAuditNavMesh = LODAuditPositions.Equals(TEXT("NavMesh"), ESearchCase::IgnoreCase);
+			GConfig->GetFloat(TEXT("LODAudit"), TEXT("GridCellSize"), LODAuditGridCellSize, InConfigFile);
+			GConfig->GetInt(TEXT("LODAudit"), TEXT("MaxPositions"), LODAuditMaxPositions, InConfigFile);
+			GConfig->GetFloat(TEXT("LODAudit"), TEXT("EyeHeight"), LODAuditEyeHeight, InConfigFile);
+			GConfig->GetFloat(TEXT("LODAudit"), TEXT("ViewDistance"), LODAuditViewDistance, InConfigFile);
+			GConfig->GetFloat(TEXT("LODAudit"), TEXT("MinLODUsage"), LODAuditMinLODUsage, InConfigFile);
+			GConfig->GetFloat(TEXT("LODAudit"), TEXT("MaxTrianglesPerPixel"), LODAuditMaxTrianglesPerPixel, InConfigFile);
+			GConfig->GetFloat(TEXT("LODAudit"), TEXT("MaxDenseShare"), LODAuditMaxDenseShare, InConfigFile);
+			LODAuditGridCellSize = FMath::Max(LODAuditGridCellSize, 1.f);
+			LODAuditMaxPositions = FMath::Max(LODAuditMaxPositions, 1);
+
+			FString ViewPoints;
+			if (GConfig->GetString(TEXT("TextureStreaming"), TEXT("ViewPoints"), ViewPoints, InConfigFile))
+			{
+				TArray<FString> Points;
+				ViewPoints.ParseIntoArray(Points, TEXT(";"));
+
+				StreamingViewPoints.Empty();
+				for (TArray<FString>::TIterator It(Points); It; ++It)
+				{
+					FVector ViewPoint;
+					if (ViewPoint.InitFromString(*It))
+						StreamingViewPoints.Add(ViewPoint);
+				}
+			}
+			GConfig->GetFloat(TEXT("TextureStreaming"), TEXT("PathStep"), StreamingPathStep, InConfigFile);
+			GConfig->GetFloat(TEXT("TextureStreaming"), TEXT("PoolSizeMB"), StreamingPoolSizeMB, InConfigFile);
+			GConfig->GetFloat(TEXT("TextureStreaming"), TEXT("ScreenHeight"), StreamingScreenHeight, InConfigFile);
+			GConfig->GetFloat(TEXT("TextureStreaming"), TEXT("FOV"), StreamingFOV, InConfigFile);
+
+			TArray<FString> WhatIfRules;
+			if (GConfig->GetArray(TEXT("TextureWhatIf"), TEXT("Rules"), WhatIfRules, InConfigFile) > 0)
+			{
+				FTextureWhatIfEngine::ParseScenarios(WhatIfRules, TextureWhatIfScenarios);
+				if (TextureWhatIfScenarios.Num() == 0)
+					FTextureWhatIfEngine::GetDefaultScenarios(TextureWhatIfScenarios);
+			}
+		}
+	};
+
 	struct FSceneStaticMeshDataSet
 	{
 	public:
 
-		FString Name;
-		FString OwnerName;
-		FString AssetPath;
+		FStringPool::FId Name; // See FExportContext::StringPool...
+		FStringPool::FId OwnerName;
+		FStringPool::FId AssetPath;
 
 		uint32 UniqueId;
 		uint32 NumVertices;
 		uint32 NumTriangles;
 		uint32 NumInstances;
 
-		TArray<int32> BoundsIndices;     // First is Mesh...Rest is Instance...
-		TArray<int32> TransformsIndices; // First is Mesh...Rest is Instance...
-		TArray<int32> UsedMaterialsIndices;
-		TArray<int32> UsedMaterialIntancesIndices;
+		// Spans into FExportContext::IndexPool...
+		FIndexSpan BoundsIndices;     // First is Mesh...Rest is Instance...
+		FIndexSpan TransformsIndices; // First is Mesh...Rest is Instance...
+		FIndexSpan UsedMaterialsIndices;
+		FIndexSpan UsedMaterialIntancesIndices;
 
 		uint16 NumLODs;
 		uint16 CurrentLOD;
+
+		// Transient...Selects the actor of a row, see SStatisticsTableViewer...
+		TWeakObjectPtr<UPrimitiveComponent> Component;
 	};
 
 	struct FSceneSkeletalMeshDataSet
 	{
 	public:
 
-		FString Name;
-		FString OwnerName;
-		FString AssetPath;
+		FStringPool::FId Name; // See FExportContext::StringPool...
+		FStringPool::FId OwnerName;
+		FStringPool::FId AssetPath;
 
 		uint32 UniqueId;
 		uint32 NumVertices;
@@ -92,11 +349,14 @@ public:
 
 		int32 BoundsIndex;     // First is Mesh...Rest is Instance...
 		int32 TransformsIndex; // First is Mesh...Rest is Instance...
-		TArray<int32> UsedMaterialsIndices;
-		TArray<int32> UsedMaterialIntancesIndices;
+		FIndexSpan UsedMaterialsIndices;
+		FIndexSpan UsedMaterialIntancesIndices;
 
 		uint16 NumLODs;
 		uint16 CurrentLOD;
+
+		// Transient...Selects the actor of a row, see SStatisticsTableViewer...
+		TWeakObjectPtr<UPrimitiveComponent> Component;
 	};
 
 	struct FSceneLandscapeDataSet
@@ -105,12 +365,96 @@ public:
 
 	};
 
+	/** Everything the stats of one material resource are read from...Collected on the game thread, the stat extraction only reads it... */
+	struct FMaterialStatsSource
+	{
+	public:
+
+		// Finalized game thread shader map only...Null while compiling...
+		const FMaterialShaderMap* ShaderMap;
+		ERHIFeatureLevel::Type FeatureLevel;
+		TArray<FString> CompileErrors;
+		TMap<FName, TArray<FMaterialStatsUtils::FRepresentativeShaderInfo>> RepresentativeShaders;
+		uint8 bHasResource : 1;
+		uint8 bUIMaterial : 1;
+		uint8 bPending : 1;
+
+		FMaterialStatsSource() : ShaderMap(nullptr), FeatureLevel(GMaxRHIFeatureLevel), bHasResource(0), bUIMaterial(0), bPending(1) {}
+
+		void Init(const FMaterialResource* InResource)
+		{
+			this->ShaderMap = nullptr;
+			this->CompileErrors.Empty();
+			this->RepresentativeShaders.Empty();
+			this->bHasResource = InResource != nullptr;
+			this->bUIMaterial = 0;
+			this->bPending = FExporterHelper::IsMaterialResourcePending(InResource);
+			if (!InResource) return;
+
+			this->FeatureLevel = InResource->GetFeatureLevel();
+			this->CompileErrors = InResource->GetCompileErrors();
+			const FMaterialShaderMap* GameThreadShaderMap = InResource->GetGameThreadShaderMap();
+			if (GameThreadShaderMap && GameThreadShaderMap->IsCompilationFinalized())
+			{
+				this->ShaderMap = GameThreadShaderMap;
+				this->bUIMaterial = InResource->IsUIMaterial();
+				FMaterialStatsUtils::GetRepresentativeShaderTypesAndDescriptions(this->RepresentativeShaders, InResource);
+			}
+		}
+	};
+
+	/** Material stats under one (feature level, quality level)... */
+	struct FMaterialPlatformStats
+	{
+	public:
+
+		ERHIFeatureLevel::Type		 FeatureLevel;
+		EMaterialQualityLevel::Type QualityLevel;
+
+		FString TexSamplers;
+		FString TexLookups;
+		FString ShaderErrors;
+
+		int32 BPSCount;
+		int32 BPSVertex;
+
+		// Shader map not finalized yet...Resolved once all passes are gathered, see FinishPendingMaterialStats()...
+		uint8 bPending : 1;
+
+		friend FArchive& operator<<(FArchive& Ar, FMaterialPlatformStats& InStats)
+		{
+			uint8 FeatureLevel = InStats.FeatureLevel;
+			uint8 QualityLevel = InStats.QualityLevel;
+			Ar << FeatureLevel << QualityLevel;
+			Ar << InStats.TexSamplers << InStats.TexLookups << InStats.ShaderErrors;
+			Ar << InStats.BPSCount << InStats.BPSVertex;
+			if (Ar.IsLoading())
+			{
+				InStats.FeatureLevel = (ERHIFeatureLevel::Type)FeatureLevel;
+				InStats.QualityLevel = (EMaterialQualityLevel::Type)QualityLevel;
+				InStats.bPending = 0;
+			}
+			return Ar;
+		}
+
+		FString GetLabel() const
+		{
+			FString FeatureLevelName, QualityLevelName;
+			GetFeatureLevelName(FeatureLevel, FeatureLevelName);
+			if (QualityLevel == EMaterialQualityLevel::Num)
+				QualityLevelName = TEXT("Default");
+			else
+				GetMaterialQualityLevelName(QualityLevel, QualityLevelName);
+			return FeatureLevelName + "/" + QualityLevelName;
+		}
+	};
+
 	struct FSceneMaterialDataSet
 	{
 	public:
 
-		FString Name;
-		FString AssetPath;
+		FStringPool::FId Name;
+		FStringPool::FId AssetPath;
 
 		// Stats...
 		FString TexSamplers;
@@ -132,13 +476,26 @@ public:
 		uint32 UniqueId;
 		uint32 NumInstances;
 		uint32 NumRefs;
-		TArray<int32> MatInsIndices;
-		TArray<int32> UsedTexturesIndices;
+		FIndexSpan MatInsIndices; // Built after the gather, see BuildMaterialInstancesIndices()...
+		FIndexSpan UsedTexturesIndices;
 		// ShaderInstructionInfo...BPS is Base Pass Shader... 
 		int32 BPSCount;
 		int32 BPSSurfaceLightmap;
 		int32 BPSVolumetricLightmap;
 		int32 BPSVertex;
+		// Shader map...
+		uint32 NumShaderPermutations;
+		uint32 ShaderMapBytes;
+		TArray<FName> CompiledVertexFactories;
+		TMap<FName, uint32> UsedVertexFactories; // Vertex factory -> Num scene primitives...
+		// Side by side stats of FExportSettings feature levels and quality levels...
+		TArray<FMaterialPlatformStats> PlatformStats;
+		// Transient...Only valid during export...
+		UMaterial* Material;
+		// Shader map of GMaxRHIFeatureLevel not finalized yet...
+		uint8 bStatsPending : 1;
+		// Stats loaded from FAssetAnalysisCache...
+		uint8 bStatsCached : 1;
 		// Material...
 		uint8 TwoSided : 1;
 		uint8 bCastRayTracedShadows : 1;
@@ -163,7 +520,7 @@ public:
 		uint8 bUsePlanarForwardReflections : 1;
 		/////////////////////////
 
-		void Init(UMaterial* InMaterial, TArray<int32>& InUsedTexturesIndices)
+		void Init(UMaterial* InMaterial, const FIndexSpan& InUsedTexturesIndices, FStringPool& InOutStringPool)
 		{
 			/////////////////////////
 			// Material
@@ -194,11 +551,86 @@ public:
 			// Forward Shading
 			this->bUseHQForwardReflections = InMaterial->bUseHQForwardReflections;
 			this->bUsePlanarForwardReflections = InMaterial->bUsePlanarForwardReflections;
+			/////////////////////////
+			this->UniqueId = InMaterial->GetUniqueID();
+			this->Name = InOutStringPool.Add(InMaterial->GetName());
+			this->AssetPath = InOutStringPool.Add(InMaterial->GetPathName());
+			this->UsedTexturesIndices = InUsedTexturesIndices;
+			this->Material = InMaterial;
+
+			this->NumInstances = 0;
+			this->NumRefs = 1;
+			this->MatInsIndices = FIndexSpan();
+			this->UsedVertexFactories.Empty();
+			this->PlatformStats.Empty();
+			this->bStatsPending = 0;
+			this->bStatsCached = 0;
+		}
+
+		/** Game thread part of the stats...GMaxRHIFeatureLevel first, then the side by side levels... */
+		void CollectStatsSources(const FExportSettings& InSettings, TArray<FMaterialStatsSource>& OutSources) const
+		{
+			OutSources.Reset();
+			if (!Material) return;
+
+			OutSources.AddDefaulted_GetRef().Init(Material->GetMaterialResource(GMaxRHIFeatureLevel));
+			for (TArray<ERHIFeatureLevel::Type>::TConstIterator It_FL(InSettings.MaterialFeatureLevels); It_FL; ++It_FL)
+			{
+				for (TArray<EMaterialQualityLevel::Type>::TConstIterator It_QL(InSettings.MaterialQualityLevels); It_QL; ++It_QL)
+					OutSources.AddDefaulted_GetRef().Init(Material->GetMaterialResource(*It_FL, *It_QL));
+			}
+		}
+
+		/** Shader stats are heavy...Only gathered once per table row, see GatherMaterialsStats()...Only reads the collected sources... */
+		void InitStats(const FExportSettings& InSettings, const TArray<FMaterialStatsSource>& InSources)
+		{
+			if (!Material || InSources.Num() == 0) return;
+
+			InitDefaultStats(InSources[0]);
+
+			// Side by side...
+			int32 SourceIndex = 1;
+			this->PlatformStats.Empty();
+			for (TArray<ERHIFeatureLevel::Type>::TConstIterator It_FL(InSettings.MaterialFeatureLevels); It_FL; ++It_FL)
+			{
+				for (TArray<EMaterialQualityLevel::Type>::TConstIterator It_QL(InSettings.MaterialQualityLevels); It_QL; ++It_QL)
+				{
+					FExporterHelper::FMaterialPlatformStats Stats;
+					Stats.FeatureLevel = *It_FL;
+					Stats.QualityLevel = *It_QL;
+					FExporterHelper::GetMaterialPlatformStats(Stats, InSources[SourceIndex++]);
+					this->PlatformStats.Add(Stats);
+				}
+			}
+		}
+
+		/** Stats part of the row...Cached across exports, see LoadMaterialStats()... */
+		void SerializeStats(FArchive& Ar)
+		{
+			Ar << TexSamplers << UserInterpolators << TexLookups << VTLookups << ShaderErrors;
+			Ar << BPSCount << BPSSurfaceLightmap << BPSVolumetricLightmap << BPSVertex;
+			Ar << NumShaderPermutations << ShaderMapBytes << CompiledVertexFactories;
+			Ar << PlatformStats;
+		}
+
+		bool HasPendingStats() const
+		{
+			if (bStatsPending) return true;
+			for (TArray<FMaterialPlatformStats>::TConstIterator It(PlatformStats); It; ++It)
+			{
+				if ((*It).bPending) return true;
+			}
+			return false;
+		}
+
+		void InitDefaultStats(const FMaterialStatsSource& InSource)
+		{
 			// Stats
 			FExporterHelper::FShaderStatsInfo MatShaderInfo;
 			TArray<FMaterialStatsUtils::FShaderInstructionsInfo> ShaderInstructionInfo;
-			FMaterialResource* MatRes = InMaterial->GetMaterialResource(GMaxRHIFeatureLevel);
-			FExporterHelper::GetMatertialStatsInfo(ShaderInstructionInfo, MatShaderInfo, MatRes);
+			this->bStatsPending = InSource.bPending;
+			if (InSource.bHasResource)
+				FExporterHelper::GetMatertialStatsInfo(ShaderInstructionInfo, MatShaderInfo, InSource);
 
 			this->TexSamplers = MatShaderInfo.SamplersCount.StrDescription;
 			this->UserInterpolators = MatShaderInfo.InterpolatorsCount.StrDescriptionLong;
@@ -213,15 +645,11 @@ public:
 			this->BPSVolumetricLightmap = ShaderInstructionInfo[2].InstructionCount;
 			this->BPSVertex = ShaderInstructionInfo[3].InstructionCount;
 
-			/////////////////////////
-			this->UniqueId = InMaterial->GetUniqueID();
-			this->Name = InMaterial->GetName();
-			this->AssetPath = InMaterial->GetPathName();
-			this->UsedTexturesIndices = InUsedTexturesIndices;
-
-			this->NumInstances = 0;
-			this->NumRefs = 1;
-			this->MatInsIndices.Empty();
+			FExporterHelper::FShaderMapInfo MatShaderMapInfo;
+			FExporterHelper::GetShaderMapInfo(MatShaderMapInfo, InSource.ShaderMap);
+			this->NumShaderPermutations = MatShaderMapInfo.NumPermutations;
+			this->ShaderMapBytes = MatShaderMapInfo.SizeBytes;
+			this->CompiledVertexFactories = MatShaderMapInfo.VertexFactories;
 		}
 
 		bool operator==(const FSceneMaterialDataSet& InElement) const
@@ -236,16 +664,100 @@ public:
 	{
 	public:
 
-		FString Name;
-		FString AssetPath;
+		FStringPool::FId Name;
+		FStringPool::FId AssetPath;
 
 		// ParentData...
-		FString ParentName;
+		FStringPool::FId ParentName;
 
 		uint32 UniqueId;
 		uint32 NumRefs;
 		int32  ParentIndex;
-		TArray<int32> UsedTexturesIndices;
+		FIndexSpan UsedTexturesIndices;
+
+		// Parameter overrides...
+		uint32 NumScalarOverrides;
+		uint32 NumVectorOverrides;
+		uint32 NumTextureOverrides;
+		uint32 NumStaticSwitchOverrides;
+		uint32 NumStaticComponentMaskOverrides;
+		// Static parameter overrides force a shader map of its own...
+		uint32 NumShaderPermutations;
+		uint32 ShaderMapBytes;
+		FMaterialPlatformStats UniqueShaderMapStats;
+		TArray<FName> CompiledVertexFactories;
+		TMap<FName, uint32> UsedVertexFactories; // Only with unique shader map...Else counted on the parent...
+		// Transient...Only valid during export...
+		UMaterialInstance* MaterialInstance;
+		uint8 bHasStaticParameterOverrides : 1;
+		uint8 bHasUniqueShaderMap : 1;
+
+		void Init(UMaterialInstance* InMaterialIns, const FIndexSpan& InUsedTexturesIndices, FStringPool& InOutStringPool)
+		{
+			this->UniqueId = InMaterialIns->GetUniqueID();
+			this->MaterialInstance = InMaterialIns;
+			this->Name = InOutStringPool.Add(InMaterialIns->GetName());
+			this->AssetPath = InOutStringPool.Add(InMaterialIns->GetPathName());
+			this->UsedTexturesIndices = InUsedTexturesIndices;
+			this->ParentName = InOutStringPool.Add(InMaterialIns->Parent ? InMaterialIns->Parent->GetName() : FString(TEXT("None")));
+			this->ParentIndex = -1;
+			this->NumRefs = 1;
+
+			// Parameter overrides...
+			this->NumScalarOverrides = InMaterialIns->ScalarParameterValues.Num();
+			this->NumVectorOverrides = InMaterialIns->VectorParameterValues.Num();
+			this->NumTextureOverrides = InMaterialIns->TextureParameterValues.Num();
+
+			const FStaticParameterSet& StaticParameters = InMaterialIns->GetStaticParameters();
+			this->NumStaticSwitchOverrides = 0;
+			for (TArray<FStaticSwitchParameter>::TConstIterator It(StaticParameters.StaticSwitchParameters); It; ++It)
+			{
+				if ((*It).bOverride)
+					this->NumStaticSwitchOverrides++;
+			}
+			this->NumStaticComponentMaskOverrides = 0;
+			for (TArray<FStaticComponentMaskParameter>::TConstIterator It(StaticParameters.StaticComponentMaskParameters); It; ++It)
+			{
+				if ((*It).bOverride)
+					this->NumStaticComponentMaskOverrides++;
+			}
+			this->bHasStaticParameterOverrides = (this->NumStaticSwitchOverrides + this->NumStaticComponentMaskOverrides) > 0;
+
+			// Unique shader map...
+			this->bHasUniqueShaderMap = InMaterialIns->bHasStaticPermutationResource;
+			this->NumShaderPermutations = 0;
+			this->ShaderMapBytes = 0;
+			this->UniqueShaderMapStats.FeatureLevel = GMaxRHIFeatureLevel;
+			this->UniqueShaderMapStats.QualityLevel = EMaterialQualityLevel::Num;
+			this->UniqueShaderMapStats.BPSCount = 0;
+			this->UniqueShaderMapStats.BPSVertex = 0;
+			this->UniqueShaderMapStats.bPending = 0;
+			this->CompiledVertexFactories.Empty();
+			this->UsedVertexFactories.Empty();
+			if (this->bHasUniqueShaderMap)
+			{
+				// Returns the static permutation resource of the instance...Pending ones are queued like materials, see QueuePendingMaterialInstanceStats()...
+				FExporterHelper::FMaterialStatsSource Source;
+				Source.Init(InMaterialIns->GetMaterialResource(GMaxRHIFeatureLevel));
+				InitUniqueShaderMapStats(Source);
+			}
+		}
+
+		void InitUniqueShaderMapStats(const FMaterialStatsSource& InSource)
+		{
+			FExporterHelper::GetMaterialPlatformStats(this->UniqueShaderMapStats, InSource);
+
+			FExporterHelper::FShaderMapInfo MatInsShaderMapInfo;
+			FExporterHelper::GetShaderMapInfo(MatInsShaderMapInfo, InSource.ShaderMap);
+			this->NumShaderPermutations = MatInsShaderMapInfo.NumPermutations;
+			this->ShaderMapBytes = MatInsShaderMapInfo.SizeBytes;
+			this->CompiledVertexFactories = MatInsShaderMapInfo.VertexFactories;
+		}
+
+		bool HasPendingStats() const
+		{
+			return this->bHasUniqueShaderMap && this->UniqueShaderMapStats.bPending;
+		}
 
 		bool operator==(const FSceneMaterialInstanceDataSet& InElement) const
 		{
@@ -259,8 +771,8 @@ public:
 	{
 	public:
 
-		FString Name;
-		FString AssetPath;
+		FStringPool::FId Name;
+		FStringPool::FId AssetPath;
 		FString Type;
 
 		FString CurrentSize;
@@ -276,15 +788,8 @@ public:
 		float  CurrentKB;
 		float  FullyLoadedKB;
 
-		// Special Format Size...
-		float  PVRTC2;
-		float  PVRTC4;
-		float  ASTC_4x4;	// 8.00 bpp
-		float  ASTC_6x6;	// 3.56 bpp
-		float  ASTC_8x8;	// 2.00 bpp
-		float  ASTC_10x10;	// 1.28 bpp
-		float  ASTC_12x12;	// 0.89 bpp
-
+		uint16 SizeX; // Top mip...Before LOD bias...
+		uint16 SizeY;
 		uint16 CurrentSizeX;
 		uint16 CurrentSizeY;
 		uint16 SourceSizeX;
@@ -293,6 +798,7 @@ public:
 		uint8  NumResidentMips;
 		uint8  NumMipsAllowed;
 		uint8  CurrentMips;
+		uint8  LODGroup;
 		uint8  CompressionNoAlpha : 1;
 
 		bool operator==(const FSceneTextureDataSet& InElement) const
@@ -303,6 +809,73 @@ public:
 		}
 	};
 
+	/** Totals of all mesh components of one owner name or one actor class... */
+	struct FSceneOwnerDataSet
+	{
+	public:
+
+		FStringPool::FId Name;      // Owner name without number suffix, or actor class name...
+		FStringPool::FId ClassName;
+
+		uint32 NumActors;
+		uint32 NumComponents;
+		uint32 NumInstances;		 // Rendered copies...Instances of instanced components, else one per component...
+		TArray<uint64> NumTrianglesPerLOD; // All copies...
+		TSet<int32> UsedMaterialsIndices;
+		TSet<int32> UsedMaterialIntancesIndices;
+	};
+
+	// Vertex factory types of one primitive, see GetPrimitiveVertexFactories()...
+	typedef TArray<FName, TInlineAllocator<4>> FVertexFactoryNames;
+
+	/** Lookups of one gather pass...Rows are found by asset instead of searching the tables... */
+	struct FGatherCache
+	{
+	public:
+
+		/** Mesh and override materials of a component...Same key renders with the same material rows... */
+		struct FMaterialSetupKey
+		{
+			const UObject* Mesh;
+			TArray<UMaterialInterface*, TInlineAllocator<8>> OverrideMaterials;
+
+			FMaterialSetupKey() : Mesh(nullptr) {}
+
+			bool operator==(const FMaterialSetupKey& InOther) const
+			{
+				return Mesh == InOther.Mesh && OverrideMaterials == InOther.OverrideMaterials;
+			}
+
+			friend uint32 GetTypeHash(const FMaterialSetupKey& InKey)
+			{
+				uint32 Hash = GetTypeHash(InKey.Mesh);
+				for (UMaterialInterface* OverrideMaterial : InKey.OverrideMaterials)
+					Hash = HashCombine(Hash, GetTypeHash(OverrideMaterial));
+				return Hash;
+			}
+		};
+
+		struct FMaterialSetup
+		{
+			FIndexSpan UsedMaterialsIndices;
+			FIndexSpan UsedMaterialIntancesIndices;
+			float TextureKB; // Unique textures of all materials, fully loaded...
+		};
+
+		TMap<UMaterial*, int32>		    MaterialRows;
+		TMap<UMaterialInstance*, int32> MaterialInstanceRows; // Parent chain is resolved once, see FSceneMaterialInstanceDataSet::ParentIndex...
+		TMap<UMaterialInterface*, FIndexSpan> MaterialTextures;
+		TMap<FMaterialSetupKey, FMaterialSetup> MaterialSetups;
+		// Owner aggregation...
+		TSet<AActor*>		 Owners;
+		TMap<FName, int32>	 OwnerRows;
+		TMap<UClass*, int32> ActorClassRows;
+		// Scene rollup nodes...
+		TMap<ULevel*, int32> RollupLevels;
+		TMap<AActor*, int32> RollupActors;
+		TMap<const UObject*, float> MeshKB;
+	};
+
 	struct FSceneDataSet
 	{
 	public:
@@ -316,6 +889,66 @@ public:
 		TArray<FSceneMaterialDataSet>		  MaterialsTable;
 		TArray<FSceneMaterialInstanceDataSet> MaterialInstancesTable;
 		TArray<FSceneTextureDataSet>		  TexturesTable;
+
+		// Owner aggregation...
+		TArray<FSceneOwnerDataSet> OwnersTable;
+		TArray<FSceneOwnerDataSet> ActorClassesTable;
+
+		// World -> Level -> Actor -> Component -> Asset costs...
+		FSceneRollup Rollup;
+	};
+
+	/** A shader map the stats of some rows wait for...Queued once per export, see QueuePendingMaterialStats()... */
+	struct FPendingMaterialStats
+	{
+		UMaterialInterface* Material; // Material, or instance with a unique shader map...
+		int32 PlatformIndex; // INDEX_NONE is the GMaxRHIFeatureLevel stats...
+		ERHIFeatureLevel::Type FeatureLevel;
+		EMaterialQualityLevel::Type QualityLevel;
+		FMaterialResource* Resource;
+		TArray<FMaterialResource*> OwnedResources; // Compiled for this request only...Deleted after all passes are patched...
+		FMaterialStatsSource Source; // Valid once resolved...
+		bool bResolved;
+	};
+
+	/** Tables of one pass whose material rows wait for pending shader maps...Written after all passes, see FinishPendingMaterialStats()... */
+	struct FPendingMaterialStatsPass
+	{
+		FString OutputPath;
+		FString TablePrefix;
+		TArray<FSceneDataSet> PerLODSceneDataSets;
+		TArray<FSceneDataSet>* OutPerLODSceneDataSets;
+	};
+
+	/** State of one export run, shared by the World and all Level tables... */
+	struct FExportContext
+	{
+	public:
+
+		FExportSettings Settings;
+		// Names and asset paths of all rows, shared by the World and all Level tables...
+		FStringPool StringPool;
+		// Index lists of all rows...Released with the context...
+		FIndexPool IndexPool;
+		SIZE_T MemStackPeakBytes;
+		// Summary lines shown to the user after export...
+		TArray<FString> Notes;
+
+		// Tables of the World export...Kept for the scene analyses, see FSceneAnalysisHelper...
+		FString WorldName;
+		TArray<FSceneDataSet> WorldSceneDataSets;
+
+		FAssetAnalysisCache AssetCache;
+
+		// Table prefix of the World and every Level -> Total KB, current and per what-if scenario...
+		TMap<FString, FTextureWhatIfEngine::FTotals> TextureWhatIfTotals;
+
+		// Shader maps of all passes not finalized yet...(Material or instance, PlatformIndex) -> Request...
+		TArray<FPendingMaterialStats> PendingMaterialStats;
+		TMap<TPair<const UMaterialInterface*, int32>, int32> PendingMaterialStatsIndices;
+		TArray<FPendingMaterialStatsPass> PendingMaterialStatsPasses;
+
+		FExportContext() : MemStackPeakBytes(0) {}
 	};
 
 	/** structure used to store various statistics extracted from compiled shaders... */
@@ -378,6 +1011,14 @@ public:
 		}
 	};
 
+	/** structure used to store the permutations and size of a compiled material shader map... */
+	struct FShaderMapInfo
+	{
+		uint32 NumPermutations = 0;
+		uint32 SizeBytes = 0;
+		TArray<FName> VertexFactories;
+	};
+
 	static inline UWorld* GetWorld()
 	{
 		UWorld* World = GWorld.GetReference();
@@ -467,8 +1108,8 @@ public:
 		return TEXT("NULL");
 	}
 
-	template<typename TextureType>
-	static void UpdateTexturesTable(TArray<TextureType*>& InTextures, TArray<FSceneTextureDataSet>& TargetTexturesTable, bool bOutTexturesIndices = false, TArray<int32>* OutTexturesIndices = nullptr)
+	template<typename TextureType, typename IndicesAllocatorType = FDefaultAllocator>
+	static void UpdateTexturesTable(TArray<TextureType*>& InTextures, TArray<FSceneTextureDataSet>& TargetTexturesTable, FStringPool& InOutStringPool, bool bOutTexturesIndices = false, TArray<int32, IndicesAllocatorType>* OutTexturesIndices = nullptr)
 	{
 		for (TArray<TextureType*>::TIterator It(InTextures); It; ++It)
 		{
@@ -478,14 +1119,16 @@ public:
 			FExporterHelper::FSceneTextureDataSet TextureDataSet;
 			
 			TextureDataSet.UniqueId = InTexture->GetUniqueID();
-			TextureDataSet.Name = InTexture->GetName();
-			TextureDataSet.AssetPath = InTexture->GetPathName();
+			TextureDataSet.Name = InOutStringPool.Add(InTexture->GetName());
+			TextureDataSet.AssetPath = InOutStringPool.Add(InTexture->GetPathName());
 			TextureDataSet.CompressionNoAlpha = InTexture->CompressionNoAlpha;
 			TextureDataSet.SourceSizeX = InTexture->Source.GetSizeX();
 			TextureDataSet.SourceSizeY = InTexture->Source.GetSizeY();
 			TextureDataSet.SourceSize = FString::FromInt(TextureDataSet.SourceSizeX) + FString(TEXT("x")) + FString::FromInt(TextureDataSet.SourceSizeY);
 			TextureDataSet.SourceFormat = FExporterHelper::EnumToStringEx(InTexture->Source.GetFormat());
 			TextureDataSet.NumRefs = 1;
+			TextureDataSet.LODGroup = InTexture->LODGroup;
+			TextureDataSet.SizeX = TextureDataSet.SizeY = 0;
 
 			TextureDataSet.LODBias = InTexture->GetCachedLODBias();
 			TextureDataSet.CurrentKB = InTexture->CalcTextureMemorySizeEnum(ETextureMipCount::TMC_ResidentMips) / 1024.0f;
@@ -497,6 +1140,8 @@ public:
 			{
 				// Calculate in game current dimensions 
 				const int32 DroppedMips = Texture2D->GetNumMips() - Texture2D->GetNumResidentMips();
+				TextureDataSet.SizeX = Texture2D->GetSizeX();
+				TextureDataSet.SizeY = Texture2D->GetSizeY();
 				TextureDataSet.CurrentSizeX = Texture2D->GetSizeX() >> DroppedMips;
 				TextureDataSet.CurrentSizeY = Texture2D->GetSizeY() >> DroppedMips;
 
@@ -521,6 +1166,8 @@ public:
 				UTextureCube* TextureCube = Cast<UTextureCube>(InTexture);
 				if (TextureCube)
 				{
+					TextureDataSet.SizeX = TextureCube->GetSizeX();
+					TextureDataSet.SizeY = TextureCube->GetSizeY();
 					TextureDataSet.CurrentSizeX = TextureCube->GetSizeX() >> TextureDataSet.LODBias;
 					TextureDataSet.CurrentSizeY = TextureCube->GetSizeY() >> TextureDataSet.LODBias;
 					TextureDataSet.CurrentSize = FString::FromInt(TextureDataSet.CurrentSizeX) + FString(TEXT("x")) + FString::FromInt(TextureDataSet.CurrentSizeY);
@@ -533,16 +1180,6 @@ public:
 				}
 			}
 
-			// Special Format Size...
-			TextureDataSet.PVRTC2 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_PVRTC2, TextureDataSet.NumResidentMips) / 1024.0f;
-			TextureDataSet.PVRTC4 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_PVRTC4, TextureDataSet.NumResidentMips) / 1024.0f;
-
-			TextureDataSet.ASTC_4x4 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_ASTC_4x4, TextureDataSet.NumResidentMips) / 1024.0f;
-			TextureDataSet.ASTC_6x6 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_ASTC_6x6, TextureDataSet.NumResidentMips) / 1024.0f;
-			TextureDataSet.ASTC_8x8 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_ASTC_8x8, TextureDataSet.NumResidentMips) / 1024.0f;
-			TextureDataSet.ASTC_10x10 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_ASTC_10x10, TextureDataSet.NumResidentMips) / 1024.0f;
-			TextureDataSet.ASTC_12x12 = ::CalcTextureSize(TextureDataSet.CurrentSizeX, TextureDataSet.CurrentSizeY, EPixelFormat::PF_ASTC_12x12, TextureDataSet.NumResidentMips) / 1024.0f;
-
 			int32 IndexTex = -1;
 			/// IndexTex = TargetTexturesTable.AddUnique(TextureDataSet);
 
@@ -560,19 +1197,249 @@ public:
 		}
 	}
 
-	static void GetRepresentativeInstructionCounts(TArray<FMaterialStatsUtils::FShaderInstructionsInfo>& Results, const class FMaterialResource* MaterialResource)
+	/** Instances of every material in one pass over the gathered instances...Same order as gathered... */
+	static void BuildMaterialInstancesIndices(FSceneDataSet& InOutSceneDataSet, FIndexPool& InOutIndexPool)
+	{
+		TArray<FSceneMaterialDataSet>& MaterialsTable = InOutSceneDataSet.MaterialsTable;
+		TArray<FSceneMaterialInstanceDataSet>& MaterialInstancesTable = InOutSceneDataSet.MaterialInstancesTable;
+
+		TArray<int32> Counts;
+		Counts.AddZeroed(MaterialsTable.Num());
+		for (TArray<FSceneMaterialInstanceDataSet>::TConstIterator It(MaterialInstancesTable); It; ++It)
+		{
+			if (Counts.IsValidIndex((*It).ParentIndex))
+				Counts[(*It).ParentIndex]++;
+		}
+
+		for (int32 i = 0; i < MaterialsTable.Num(); ++i)
+		{
+			MaterialsTable[i].MatInsIndices = InOutIndexPool.AddUninitialized(Counts[i]);
+			Counts[i] = 0;
+		}
+
+		for (int32 i = 0; i < MaterialInstancesTable.Num(); ++i)
+		{
+			const int32 ParentIndex = MaterialInstancesTable[i].ParentIndex;
+			if (Counts.IsValidIndex(ParentIndex))
+				InOutIndexPool[MaterialsTable[ParentIndex].MatInsIndices][Counts[ParentIndex]++] = i;
+		}
+	}
+
+	static void AddTexturesRefs(TArray<FSceneTextureDataSet>& InOutTexturesTable, const FIndexPool& InIndexPool, const FIndexSpan& InTexturesIndices)
+	{
+		for (int32 TextureIndex : InIndexPool[InTexturesIndices])
+			InOutTexturesTable[TextureIndex].NumRefs++;
+	}
+
+	/** Textures of a material once per export pass...Later uses only count the references... */
+	static FIndexSpan ResolveUsedTextures(UMaterialInterface* InMaterial, TArray<FSceneTextureDataSet>& InOutTexturesTable, FExportContext& InOutContext, FGatherCache& InOutGatherCache, TArray<UTexture*>& InOutUsedTextures)
+	{
+		if (const FIndexSpan* CachedTexturesIndices = InOutGatherCache.MaterialTextures.Find(InMaterial))
+		{
+			FExporterHelper::AddTexturesRefs(InOutTexturesTable, InOutContext.IndexPool, *CachedTexturesIndices);
+			return *CachedTexturesIndices;
+		}
+
+		FMemMark Mark(FMemStack::Get());
+		TArray<int32, TMemStackAllocator<>> UsedTexturesIndices;
+		InMaterial->GetUsedTextures(InOutUsedTextures, EMaterialQualityLevel::Num, false, GMaxRHIFeatureLevel, true);
+		FExporterHelper::UpdateTexturesTable<UTexture>(InOutUsedTextures, InOutTexturesTable, InOutContext.StringPool, true, &UsedTexturesIndices);
+
+		const FIndexSpan TexturesIndices = InOutContext.IndexPool.Add(UsedTexturesIndices);
+		InOutGatherCache.MaterialTextures.Add(InMaterial, TexturesIndices);
+		return TexturesIndices;
+	}
+
+	/** Static and skeletal mesh components only...Others resolve their materials every time... */
+	static bool GetMaterialSetupKey(UPrimitiveComponent* InPrimitiveComponent, FGatherCache::FMaterialSetupKey& OutKey)
+	{
+		UMeshComponent* MeshComponent = Cast<UMeshComponent>(InPrimitiveComponent);
+		if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(InPrimitiveComponent))
+			OutKey.Mesh = StaticMeshComponent->GetStaticMesh();
+		else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(InPrimitiveComponent))
+			OutKey.Mesh = SkeletalMeshComponent->SkeletalMesh;
+		else return false;
+
+		OutKey.OverrideMaterials.Append(MeshComponent->OverrideMaterials);
+		return OutKey.Mesh != nullptr;
+	}
+
+	/** Same counts as gathering the materials of a cached setup again... */
+	static void AddMaterialSetupRefs(FSceneDataSet& InOutSceneDataSet, const FIndexPool& InIndexPool, const FGatherCache::FMaterialSetup& InMaterialSetup)
+	{
+		for (int32 MaterialIndex : InIndexPool[InMaterialSetup.UsedMaterialsIndices])
+		{
+			FSceneMaterialDataSet& MaterialDataSet = InOutSceneDataSet.MaterialsTable[MaterialIndex];
+			MaterialDataSet.NumRefs++;
+			FExporterHelper::AddTexturesRefs(InOutSceneDataSet.TexturesTable, InIndexPool, MaterialDataSet.UsedTexturesIndices);
+		}
+
+		for (int32 MaterialInsIndex : InIndexPool[InMaterialSetup.UsedMaterialIntancesIndices])
+		{
+			FSceneMaterialInstanceDataSet& MaterialInsDataSet = InOutSceneDataSet.MaterialInstancesTable[MaterialInsIndex];
+			FSceneMaterialDataSet& ParentDataSet = InOutSceneDataSet.MaterialsTable[MaterialInsDataSet.ParentIndex];
+			MaterialInsDataSet.NumRefs++;
+			ParentDataSet.NumRefs++;
+			ParentDataSet.NumInstances++;
+			FExporterHelper::AddTexturesRefs(InOutSceneDataSet.TexturesTable, InIndexPool, MaterialInsDataSet.UsedTexturesIndices);
+		}
+	}
+
+	/** Vertex factories of one primitive counted once per shader map it renders with...Slots sharing a material or a parent count once... */
+	static void AddVertexFactoryRefs(FSceneDataSet& InOutSceneDataSet, const FIndexPool& InIndexPool, const FGatherCache::FMaterialSetup& InMaterialSetup, const FVertexFactoryNames& InVertexFactoryNames)
+	{
+		if (InVertexFactoryNames.Num() == 0)
+			return;
+
+		// Instances without static permutation render with the parent shader map...
+		TArray<int32, TInlineAllocator<16>> Materials;
+		TArray<int32, TInlineAllocator<16>> MaterialInstances;
+		for (int32 MaterialIndex : InIndexPool[InMaterialSetup.UsedMaterialsIndices])
+			Materials.AddUnique(MaterialIndex);
+		for (int32 MaterialInsIndex : InIndexPool[InMaterialSetup.UsedMaterialIntancesIndices])
+		{
+			const FSceneMaterialInstanceDataSet& MaterialInsDataSet = InOutSceneDataSet.MaterialInstancesTable[MaterialInsIndex];
+			if (MaterialInsDataSet.bHasUniqueShaderMap)
+				MaterialInstances.AddUnique(MaterialInsIndex);
+			else
+				Materials.AddUnique(MaterialInsDataSet.ParentIndex);
+		}
+
+		for (const FName& VertexFactoryName : InVertexFactoryNames)
+		{
+			for (int32 MaterialIndex : Materials)
+				InOutSceneDataSet.MaterialsTable[MaterialIndex].UsedVertexFactories.FindOrAdd(VertexFactoryName)++;
+			for (int32 MaterialInsIndex : MaterialInstances)
+				InOutSceneDataSet.MaterialInstancesTable[MaterialInsIndex].UsedVertexFactories.FindOrAdd(VertexFactoryName)++;
+		}
+	}
+
+	/** Totals per owner name and per actor class...Once per mesh component... */
+	static void AddOwnerRefs(FSceneDataSet& InOutSceneDataSet, FGatherCache& InOutGatherCache, FStringPool& InOutStringPool, const FIndexPool& InIndexPool, AActor* InOwner, const FGatherCache::FMaterialSetup& InMaterialSetup, const TArray<uint32, TInlineAllocator<8>>& InTrianglesPerLOD, uint32 InNumCopies)
+	{
+		if (!InOwner) return;
+
+		bool bActorCounted = false;
+		InOutGatherCache.Owners.Add(InOwner, &bActorCounted);
+
+		const FName OwnerName(InOwner->GetFName(), NAME_NO_NUMBER_INTERNAL);
+		UClass* OwnerClass = InOwner->GetClass();
+
+		auto FindOrAddRow = [&](TArray<FSceneOwnerDataSet>& InOutTable, int32* InRowIndex, const FName& InName) -> FSceneOwnerDataSet&
+		{
+			if (InRowIndex)
+				return InOutTable[*InRowIndex];
+
+			FSceneOwnerDataSet& NewRow = InOutTable.AddDefaulted_GetRef();
+			NewRow.Name = InOutStringPool.Add(InName);
+			NewRow.ClassName = InOutStringPool.Add(OwnerClass->GetFName());
+			NewRow.NumActors = NewRow.NumComponents = NewRow.NumInstances = 0;
+			return NewRow;
+		};
+
+		int32* OwnerRowIndex = InOutGatherCache.OwnerRows.Find(OwnerName);
+		if (!OwnerRowIndex)
+			InOutGatherCache.OwnerRows.Add(OwnerName, InOutSceneDataSet.OwnersTable.Num());
+		FSceneOwnerDataSet& OwnerRow = FindOrAddRow(InOutSceneDataSet.OwnersTable, OwnerRowIndex, OwnerName);
+
+		int32* ClassRowIndex = InOutGatherCache.ActorClassRows.Find(OwnerClass);
+		if (!ClassRowIndex)
+			InOutGatherCache.ActorClassRows.Add(OwnerClass, InOutSceneDataSet.ActorClassesTable.Num());
+		FSceneOwnerDataSet& ClassRow = FindOrAddRow(InOutSceneDataSet.ActorClassesTable, ClassRowIndex, OwnerClass->GetFName());
+
+		FSceneOwnerDataSet* Rows[] = { &OwnerRow, &ClassRow };
+		for (FSceneOwnerDataSet* Row : Rows)
+		{
+			Row->NumActors += bActorCounted ? 0 : 1;
+			Row->NumComponents++;
+			Row->NumInstances += InNumCopies;
+			if (Row->NumTrianglesPerLOD.Num() < InTrianglesPerLOD.Num())
+				Row->NumTrianglesPerLOD.AddZeroed(InTrianglesPerLOD.Num() - Row->NumTrianglesPerLOD.Num());
+			for (int32 LOD = 0; LOD < InTrianglesPerLOD.Num(); ++LOD)
+				Row->NumTrianglesPerLOD[LOD] += (uint64)InTrianglesPerLOD[LOD] * InNumCopies;
+
+			for (int32 MaterialIndex : InIndexPool[InMaterialSetup.UsedMaterialsIndices])
+				Row->UsedMaterialsIndices.Add(MaterialIndex);
+			for (int32 MaterialInsIndex : InIndexPool[InMaterialSetup.UsedMaterialIntancesIndices])
+				Row->UsedMaterialIntancesIndices.Add(MaterialInsIndex);
+		}
+	}
+
+	/** Textures shared by several materials of the setup are counted once... */
+	static float GetMaterialSetupTextureKB(const FSceneDataSet& InSceneDataSet, const FIndexPool& InIndexPool, const FGatherCache::FMaterialSetup& InMaterialSetup)
+	{
+		TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<32>> UniqueTextures;
+		for (int32 MaterialIndex : InIndexPool[InMaterialSetup.UsedMaterialsIndices])
+			UniqueTextures.Append(InIndexPool[InSceneDataSet.MaterialsTable[MaterialIndex].UsedTexturesIndices]);
+		for (int32 MaterialInsIndex : InIndexPool[InMaterialSetup.UsedMaterialIntancesIndices])
+			UniqueTextures.Append(InIndexPool[InSceneDataSet.MaterialInstancesTable[MaterialInsIndex].UsedTexturesIndices]);
+
+		float TextureKB = 0.f;
+		for (int32 TextureIndex : UniqueTextures)
+			TextureKB += InSceneDataSet.TexturesTable[TextureIndex].FullyLoadedKB;
+		return TextureKB;
+	}
+
+	/** Mesh row of every row of BoundsTable...Static mesh row, or -(Skeletal mesh row + 2), INDEX_NONE for no mesh...Rows of LOD0... */
+	static void GetBoundsOwners(const FSceneDataSet& InSceneDataSet, const FIndexPool& InIndexPool, TArray<int32>& OutOwners)
+	{
+		OutOwners.Init(INDEX_NONE, InSceneDataSet.BoundsTable.Num());
+		for (int32 Row = 0; Row < InSceneDataSet.StaticMeshesTable.Num(); ++Row)
+		{
+			for (int32 BoundsIndex : InIndexPool[InSceneDataSet.StaticMeshesTable[Row].BoundsIndices])
+			{
+				if (OutOwners.IsValidIndex(BoundsIndex))
+					OutOwners[BoundsIndex] = Row;
+			}
+		}
+		for (int32 Row = 0; Row < InSceneDataSet.SkeletalMeshesTable.Num(); ++Row)
+		{
+			const int32 BoundsIndex = InSceneDataSet.SkeletalMeshesTable[Row].BoundsIndex;
+			if (OutOwners.IsValidIndex(BoundsIndex))
+				OutOwners[BoundsIndex] = -(Row + 2);
+		}
+	}
+
+	/** Level, actor and component nodes of a mesh component, then its asset leaf with the costs...Summed up by FSceneRollup::Aggregate()... */
+	static void AddRollupNodes(FSceneDataSet& InOutSceneDataSet, FGatherCache& InOutGatherCache, FStringPool& InOutStringPool, UPrimitiveComponent* InComponent, UObject* InMesh, const FSceneRollup::FCosts& InCosts)
+	{
+		FSceneRollup& Rollup = InOutSceneDataSet.Rollup;
+		AActor* Owner = InComponent->GetOwner();
+		ULevel* Level = InComponent->GetComponentLevel();
+
+		int32 ParentNode = 0;
+		if (Level)
+		{
+			int32* LevelNode = InOutGatherCache.RollupLevels.Find(Level);
+			ParentNode = LevelNode ? *LevelNode : InOutGatherCache.RollupLevels.Add(Level, Rollup.AddNode(0, FSceneRollup::ENodeType::Level, InOutStringPool.Add(Level->GetOuter()->GetFName())));
+		}
+		if (Owner)
+		{
+			int32* ActorNode = InOutGatherCache.RollupActors.Find(Owner);
+			ParentNode = ActorNode ? *ActorNode : InOutGatherCache.RollupActors.Add(Owner, Rollup.AddNode(ParentNode, FSceneRollup::ENodeType::Actor, InOutStringPool.Add(Owner->GetFName())));
+		}
+		const int32 ComponentNode = Rollup.AddNode(ParentNode, FSceneRollup::ENodeType::Component, InOutStringPool.Add(InComponent->GetFName()));
+
+		float* MeshKB = InOutGatherCache.MeshKB.Find(InMesh);
+		if (!MeshKB)
+			MeshKB = &InOutGatherCache.MeshKB.Add(InMesh, InMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) / 1024.f);
+
+		FSceneRollup::FCosts AssetCosts = InCosts;
+		AssetCosts.MeshKB = *MeshKB;
+		Rollup.AddNode(ComponentNode, FSceneRollup::ENodeType::Asset, InOutStringPool.Add(InMesh->GetFName()), AssetCosts);
+	}
+
+	static void GetRepresentativeInstructionCounts(TArray<FMaterialStatsUtils::FShaderInstructionsInfo>& Results, const FMaterialStatsSource& InSource)
 	{
-		TMap<FName, TArray<FMaterialStatsUtils::FRepresentativeShaderInfo>> ShaderTypeNamesAndDescriptions;
+		const TMap<FName, TArray<FMaterialStatsUtils::FRepresentativeShaderInfo>>& ShaderTypeNamesAndDescriptions = InSource.RepresentativeShaders;
 		Results.Empty();
 
 		//when adding a shader type here be sure to update FPreviewMaterial::ShouldCache()
 		//so the shader type will get compiled with preview materials
-		const FMaterialShaderMap* MaterialShaderMap = MaterialResource->GetGameThreadShaderMap();
-		if (MaterialShaderMap && MaterialShaderMap->IsCompilationFinalized())
+		const FMaterialShaderMap* MaterialShaderMap = InSource.ShaderMap;
+		if (MaterialShaderMap)
 		{
-			FMaterialStatsUtils::GetRepresentativeShaderTypesAndDescriptions(ShaderTypeNamesAndDescriptions, MaterialResource);
-
-			if (MaterialResource->IsUIMaterial())
+			if (InSource.bUIMaterial)
 			{
 				for (auto DescriptionPair : ShaderTypeNamesAndDescriptions)
 				{
@@ -632,71 +1499,503 @@ public:
 		}
 	}
 
-	static void GetMatertialStatsInfo(TArray<FMaterialStatsUtils::FShaderInstructionsInfo>& ShaderInstructionInfo, FShaderStatsInfo& OutInfo, const FMaterialResource* MaterialResource)
+	/** Finalized shader map only, see FMaterialStatsSource... */
+	static void GetShaderMapInfo(FShaderMapInfo& OutInfo, const FMaterialShaderMap* MaterialShaderMap)
+	{
+		OutInfo.NumPermutations = 0;
+		OutInfo.SizeBytes = 0;
+		OutInfo.VertexFactories.Empty();
+
+		if (MaterialShaderMap)
+		{
+			OutInfo.SizeBytes = MaterialShaderMap->GetSizeBytes();
+
+			// Material shaders (not bound to any vertex factory)...
+			TMap<FName, FShader*> MaterialShaders;
+			MaterialShaderMap->GetShaderList(MaterialShaders);
+			OutInfo.NumPermutations += MaterialShaders.Num();
+
+			// Mesh material shaders...One mesh shader map per compiled vertex factory...
+			for (TLinkedList<FVertexFactoryType*>::TIterator It(FVertexFactoryType::GetTypeList()); It; It.Next())
+			{
+				FVertexFactoryType* FactoryType = *It;
+				const FMeshMaterialShaderMap* MeshShaderMap = MaterialShaderMap->GetMeshShaderMap(FactoryType);
+				if (MeshShaderMap)
+				{
+					TMap<FName, FShader*> MeshShaders;
+					MeshShaderMap->GetShaderList(MeshShaders);
+					if (MeshShaders.Num() > 0)
+					{
+						OutInfo.NumPermutations += MeshShaders.Num();
+						OutInfo.VertexFactories.Add(FactoryType->GetFName());
+					}
+				}
+			}
+		}
+	}
+
+	/** Vertex factories the scene proxies render with, from their cached static mesh batches...Used to match primitives to mesh shader maps...
+	 *  Skinned meshes draw dynamic, the sections of their LOD in use are asked from the mesh object, passthrough, morph and bone influence variants included...
+	 *  Batches belong to the render thread...Read after a flush, nothing is enqueued until all primitives are read...
+	 */
+	static void GetPrimitiveVertexFactories(const TMap<FPrimitiveComponentId, UPrimitiveComponent*>& InPrimitivesTable, TMap<const UPrimitiveComponent*, FVertexFactoryNames>& OutVertexFactories)
+	{
+		OutVertexFactories.Reset();
+		FlushRenderingCommands();
+
+		for (TMap<FPrimitiveComponentId, UPrimitiveComponent*>::TConstIterator It(InPrimitivesTable); It; ++It)
+		{
+			const UPrimitiveComponent* PrimitiveComponent = (*It).Value;
+			if (!PrimitiveComponent || !PrimitiveComponent->SceneProxy)
+				continue;
+
+			FVertexFactoryNames Names;
+			if (const FPrimitiveSceneInfo* PrimitiveSceneInfo = PrimitiveComponent->SceneProxy->GetPrimitiveSceneInfo())
+			{
+				for (TArray<FStaticMeshBatch>::TConstIterator It_Mesh(PrimitiveSceneInfo->StaticMeshes); It_Mesh; ++It_Mesh)
+				{
+					if ((*It_Mesh).VertexFactory)
+						Names.AddUnique((*It_Mesh).VertexFactory->GetType()->GetFName());
+				}
+			}
+
+			const USkinnedMeshComponent* SkinnedMeshComponent = Cast<USkinnedMeshComponent>(PrimitiveComponent);
+			const FSkeletalMeshObject* MeshObject = SkinnedMeshComponent ? SkinnedMeshComponent->MeshObject : nullptr;
+			if (MeshObject && MeshObject->HaveValidDynamicData())
+			{
+				const int32 LODIndex = MeshObject->GetLOD();
+				const FSkeletalMeshRenderData& RenderData = MeshObject->GetSkeletalMeshRenderData();
+				if (RenderData.LODRenderData.IsValidIndex(LODIndex))
+				{
+					for (int32 Section = 0; Section < RenderData.LODRenderData[LODIndex].RenderSections.Num(); ++Section)
+					{
+						if (const FVertexFactory* VertexFactory = MeshObject->GetSkinVertexFactory(nullptr, LODIndex, Section))
+							Names.AddUnique(VertexFactory->GetType()->GetFName());
+					}
+				}
+			}
+
+			if (Names.Num() > 0)
+				OutVertexFactories.Add(PrimitiveComponent, Names);
+		}
+	}
+
+	/** Default vertex factory of the component class...Only for primitives whose proxy gave none, see GetPrimitiveVertexFactories()... */
+	static FName GetPrimitiveVertexFactoryName(UPrimitiveComponent* InPrimitiveComponent)
+	{
+		static const FName LocalVertexFactory(TEXT("FLocalVertexFactory"));
+		static const FName InstancedStaticMeshVertexFactory(TEXT("FInstancedStaticMeshVertexFactory"));
+		static const FName GPUSkinVertexFactory(TEXT("TGPUSkinVertexFactoryDefault"));
+		static const FName LandscapeVertexFactory(TEXT("FLandscapeVertexFactory"));
+
+		if (Cast<UInstancedStaticMeshComponent>(InPrimitiveComponent))
+			return InstancedStaticMeshVertexFactory;
+		else if (Cast<UStaticMeshComponent>(InPrimitiveComponent))
+			return LocalVertexFactory;
+		else if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(InPrimitiveComponent))
+			return SkeletalMeshComponent->GetCPUSkinningEnabled() ? LocalVertexFactory : GPUSkinVertexFactory;
+		else if (Cast<ULandscapeComponent>(InPrimitiveComponent))
+			return LandscapeVertexFactory;
+
+		return NAME_None;
+	}
+
+	static void GetMatertialStatsInfo(TArray<FMaterialStatsUtils::FShaderInstructionsInfo>& ShaderInstructionInfo, FShaderStatsInfo& OutInfo, const FMaterialStatsSource& InSource)
+	{
+		// extract potential errors
+		const ERHIFeatureLevel::Type MaterialFeatureLevel = InSource.FeatureLevel;
+		FString FeatureLevelName;
+		GetFeatureLevelName(MaterialFeatureLevel, FeatureLevelName);
+
+		OutInfo.Empty();
+		const TArray<FString>& CompileErrors = InSource.CompileErrors;
+		for (int32 ErrorIndex = 0; ErrorIndex < CompileErrors.Num(); ErrorIndex++)
+		{
+			OutInfo.StrShaderErrors += FString::Printf(TEXT("[%s] %s\n"), *FeatureLevelName, *CompileErrors[ErrorIndex]);
+		}
+
+		bool bNoErrors = OutInfo.StrShaderErrors.Len() == 0;
+
+		if (bNoErrors)
+		{
+			// extract instructions info
+			GetRepresentativeInstructionCounts(ShaderInstructionInfo, InSource);
+			const FMaterialShaderMap* MaterialShaderMap = InSource.ShaderMap;
+
+			for (int32 InstructionIndex = 0; InstructionIndex < ShaderInstructionInfo.Num(); InstructionIndex++)
+			{
+				FShaderStatsInfo::FContent Content;
+
+				Content.StrDescription = ShaderInstructionInfo[InstructionIndex].InstructionCount > 0 ? FString::Printf(TEXT("%u"), ShaderInstructionInfo[InstructionIndex].InstructionCount) : TEXT("n/a");
+				Content.StrDescriptionLong = ShaderInstructionInfo[InstructionIndex].InstructionCount > 0 ?
+					FString::Printf(TEXT("%s: %u instructions"), *ShaderInstructionInfo[InstructionIndex].ShaderDescription, ShaderInstructionInfo[InstructionIndex].InstructionCount) :
+					TEXT("Offline shader compiler not available or an error was encountered!");
+
+				OutInfo.ShaderInstructionCount.Add(ShaderInstructionInfo[InstructionIndex].ShaderType, Content);
+			}
+
+			// extract samplers info
+			const int32 SamplersUsed = MaterialShaderMap ? FMath::Max(MaterialShaderMap->GetMaxTextureSamplers(), 0) : 0;
+			const int32 MaxSamplers = GetExpectedFeatureLevelMaxTextureSamplers(MaterialFeatureLevel);
+			OutInfo.SamplersCount.StrDescription = FString::Printf(TEXT("%u/%u"), SamplersUsed, MaxSamplers);
+			OutInfo.SamplersCount.StrDescriptionLong = FString::Printf(TEXT("%s samplers: %u/%u"), TEXT("Texture"), SamplersUsed, MaxSamplers);
+
+			// extract esimated sample info
+			uint32 NumVSTextureSamples = 0, NumPSTextureSamples = 0;
+			if (MaterialShaderMap)
+				MaterialShaderMap->GetEstimatedNumTextureSamples(NumVSTextureSamples, NumPSTextureSamples);
+
+			OutInfo.TextureSampleCount.StrDescription = FString::Printf(TEXT("VS(%u), PS(%u)"), NumVSTextureSamples, NumPSTextureSamples);
+			OutInfo.TextureSampleCount.StrDescriptionLong = FString::Printf(TEXT("Texture Lookups (Est.): Vertex(%u), Pixel(%u)"), NumVSTextureSamples, NumPSTextureSamples);
+
+			// extract estimated VT info
+			const uint32 NumVirtualTextureLookups = MaterialShaderMap ? MaterialShaderMap->GetEstimatedNumVirtualTextureLookups() : 0;
+			OutInfo.VirtualTextureLookupCount.StrDescription = FString::Printf(TEXT("%u"), NumVirtualTextureLookups);
+			OutInfo.VirtualTextureLookupCount.StrDescriptionLong = FString::Printf(TEXT("Virtual Texture Lookups (Est.): %u"), NumVirtualTextureLookups);
+
+			// extract interpolators info
+			const uint32 UVScalarsUsed = MaterialShaderMap ? MaterialShaderMap->GetNumUsedUVScalars() : 0;
+			const uint32 CustomInterpolatorScalarsUsed = MaterialShaderMap ? MaterialShaderMap->GetNumUsedCustomInterpolatorScalars() : 0;
+
+			const uint32 TotalScalars = UVScalarsUsed + CustomInterpolatorScalarsUsed;
+			const uint32 MaxScalars = FMath::DivideAndRoundUp(TotalScalars, 4u) * 4;
+
+			OutInfo.InterpolatorsCount.StrDescription = FString::Printf(TEXT("%u/%u"), TotalScalars, MaxScalars);
+			OutInfo.InterpolatorsCount.StrDescriptionLong = FString::Printf(TEXT("User interpolators: %u/%u Scalars (%u/4 Vectors) (TexCoords: %i, Custom: %i)"),
+				TotalScalars, MaxScalars, MaxScalars / 4, UVScalarsUsed, CustomInterpolatorScalarsUsed);
+		}
+	}
+
+	/** A resource is pending until its game thread shader map is finalized...Resources with compile errors never will be... */
+	static bool IsMaterialResourcePending(const FMaterialResource* MaterialResource)
+	{
+		if (!MaterialResource)
+			return true;
+		if (MaterialResource->GetCompileErrors().Num() > 0)
+			return false;
+
+		const FMaterialShaderMap* MaterialShaderMap = MaterialResource->GetGameThreadShaderMap();
+		return !MaterialShaderMap || !MaterialShaderMap->IsCompilationFinalized();
+	}
+
+	static void GetMaterialPlatformStats(FMaterialPlatformStats& OutStats, const FMaterialStatsSource& InSource)
+	{
+		OutStats.bPending = InSource.bPending;
+
+		FShaderStatsInfo ShaderInfo;
+		ShaderInfo.Reset();
+		TArray<FMaterialStatsUtils::FShaderInstructionsInfo> ShaderInstructionInfo;
+		if (InSource.bHasResource)
+			GetMatertialStatsInfo(ShaderInstructionInfo, ShaderInfo, InSource);
+
+		OutStats.TexSamplers = ShaderInfo.SamplersCount.StrDescription;
+		OutStats.TexLookups = ShaderInfo.TextureSampleCount.StrDescription;
+		OutStats.ShaderErrors = ShaderInfo.StrShaderErrors;
+		if (ShaderInstructionInfo.Num() < 4)
+			ShaderInstructionInfo.AddZeroed(4 - ShaderInstructionInfo.Num());
+		OutStats.BPSCount = ShaderInstructionInfo[0].InstructionCount;
+		OutStats.BPSVertex = ShaderInstructionInfo[3].InstructionCount;
+	}
+
+	/** Resources and shader maps are game thread only...Collected first, the workers only extract the stats of finalized shader maps... */
+	static void GatherMaterialsStats(TArray<FSceneMaterialDataSet>& InOutMaterialsTable, FExportContext& InOutContext, FAssetAnalysisCache* InCache = nullptr)
+	{
+		const FExportSettings& InSettings = InOutContext.Settings;
+
+		// Unchanged materials first...
+		if (InCache)
+		{
+			for (TArray<FSceneMaterialDataSet>::TIterator It(InOutMaterialsTable); It; ++It)
+				(*It).bStatsCached = FExporterHelper::LoadMaterialStats(*It, InSettings, *InCache);
+		}
+
+		TArray<TArray<FMaterialStatsSource>> StatsSources;
+		StatsSources.AddDefaulted(InOutMaterialsTable.Num());
+		for (int32 Index = 0; Index < InOutMaterialsTable.Num(); ++Index)
+		{
+			if (!InOutMaterialsTable[Index].bStatsCached)
+				InOutMaterialsTable[Index].CollectStatsSources(InSettings, StatsSources[Index]);
+		}
+
+		ParallelFor(InOutMaterialsTable.Num(), [&InOutMaterialsTable, &InSettings, &StatsSources](int32 Index)
+		{
+			if (!InOutMaterialsTable[Index].bStatsCached)
+				InOutMaterialsTable[Index].InitStats(InSettings, StatsSources[Index]);
+		});
+
+		// Queue shader maps not finalized yet...
+		for (TArray<FSceneMaterialDataSet>::TConstIterator It(InOutMaterialsTable); It; ++It)
+		{
+			const FSceneMaterialDataSet& MatDataSet = (*It);
+			if (!MatDataSet.Material) continue;
+
+			if (MatDataSet.bStatsPending)
+				QueuePendingMaterialStats(InOutContext, MatDataSet.Material, INDEX_NONE, GMaxRHIFeatureLevel, EMaterialQualityLevel::Num);
+			for (int32 PlatformIndex = 0; PlatformIndex < MatDataSet.PlatformStats.Num(); ++PlatformIndex)
+			{
+				const FMaterialPlatformStats& Stats = MatDataSet.PlatformStats[PlatformIndex];
+				if (Stats.bPending)
+					QueuePendingMaterialStats(InOutContext, MatDataSet.Material, PlatformIndex, Stats.FeatureLevel, Stats.QualityLevel);
+			}
+		}
+	}
+
+	/** Unique shader maps of instances are gathered with the rows...Pending ones wait with the materials... */
+	static void QueuePendingMaterialInstanceStats(const TArray<FSceneMaterialInstanceDataSet>& InMaterialInstancesTable, FExportContext& InOutContext)
+	{
+		for (TArray<FSceneMaterialInstanceDataSet>::TConstIterator It(InMaterialInstancesTable); It; ++It)
+		{
+			if ((*It).MaterialInstance && (*It).HasPendingStats())
+				QueuePendingMaterialStats(InOutContext, (*It).MaterialInstance, INDEX_NONE, GMaxRHIFeatureLevel, EMaterialQualityLevel::Num);
+		}
+	}
+
+	/** Levels the stats are gathered for...Cached stats of other settings are gathered again... */
+	static void GetMaterialStatsCacheHeader(const FExportSettings& InSettings, TArray<uint8>& OutHeader)
+	{
+		OutHeader.Reset();
+		OutHeader.Add((uint8)GMaxRHIFeatureLevel);
+		for (TArray<ERHIFeatureLevel::Type>::TConstIterator It_FL(InSettings.MaterialFeatureLevels); It_FL; ++It_FL)
+		{
+			for (TArray<EMaterialQualityLevel::Type>::TConstIterator It_QL(InSettings.MaterialQualityLevels); It_QL; ++It_QL)
+			{
+				OutHeader.Add((uint8)*It_FL);
+				OutHeader.Add((uint8)*It_QL);
+			}
+		}
+	}
+
+	static bool LoadMaterialStats(FSceneMaterialDataSet& InOutMatDataSet, const FExportSettings& InSettings, FAssetAnalysisCache& InCache)
+	{
+		const TArray<uint8>* CachedData = InOutMatDataSet.Material ? InCache.Find(TEXT("MaterialStats"), InOutMatDataSet.Material) : nullptr;
+		if (!CachedData)
+			return false;
+
+		TArray<uint8> Header, CachedHeader;
+		FExporterHelper::GetMaterialStatsCacheHeader(InSettings, Header);
+		FMemoryReader Reader(*CachedData);
+		Reader << CachedHeader;
+		if (Reader.IsError() || CachedHeader != Header)
+			return false;
+
+		InOutMatDataSet.SerializeStats(Reader);
+		InOutMatDataSet.bStatsPending = 0;
+		return !Reader.IsError();
+	}
+
+	/** Stats of all resolved materials not loaded from the cache... */
+	static void StoreMaterialsStats(TArray<FSceneMaterialDataSet>& InMaterialsTable, const FExportSettings& InSettings, FAssetAnalysisCache& InOutCache)
+	{
+		TArray<uint8> Header;
+		FExporterHelper::GetMaterialStatsCacheHeader(InSettings, Header);
+
+		for (TArray<FSceneMaterialDataSet>::TIterator It(InMaterialsTable); It; ++It)
+		{
+			FSceneMaterialDataSet& MatDataSet = (*It);
+			if (!MatDataSet.Material || MatDataSet.bStatsCached || MatDataSet.HasPendingStats())
+				continue;
+
+			FBufferArchive Writer;
+			Writer << Header;
+			MatDataSet.SerializeStats(Writer);
+			InOutCache.Add(TEXT("MaterialStats"), MatDataSet.Material, MoveTemp(Writer));
+			MatDataSet.bStatsCached = 1;
+		}
+	}
+
+	/** Every shader map is requested once per export...Rows of all passes are patched from the same request... */
+	static void QueuePendingMaterialStats(FExportContext& InOutContext, UMaterialInterface* InMaterial, int32 InPlatformIndex, ERHIFeatureLevel::Type InFeatureLevel, EMaterialQualityLevel::Type InQualityLevel)
+	{
+		const TPair<const UMaterialInterface*, int32> Key(InMaterial, InPlatformIndex);
+		if (InOutContext.PendingMaterialStatsIndices.Contains(Key))
+			return;
+
+		InOutContext.PendingMaterialStatsIndices.Add(Key, InOutContext.PendingMaterialStats.Num());
+		FPendingMaterialStats& Pending = InOutContext.PendingMaterialStats.AddDefaulted_GetRef();
+		Pending.Material = InMaterial;
+		Pending.PlatformIndex = InPlatformIndex;
+		Pending.FeatureLevel = InFeatureLevel;
+		Pending.QualityLevel = InQualityLevel;
+		Pending.bResolved = false;
+		RequestPendingMaterialStats(Pending);
+	}
+
+	/** Kick off the compilation of a queued shader map...Shader maps compiling or waiting to be finalized are only awaited... */
+	static void RequestPendingMaterialStats(FPendingMaterialStats& InOutPending)
+	{
+		const ERHIFeatureLevel::Type FeatureLevel = InOutPending.FeatureLevel;
+		const EMaterialQualityLevel::Type QualityLevel = InOutPending.QualityLevel;
+
+		InOutPending.Resource = InOutPending.Material->GetMaterialResource(FeatureLevel, QualityLevel);
+		if (InOutPending.Resource && (!InOutPending.Resource->IsCompilationFinished() || InOutPending.Resource->GetGameThreadShaderMap()))
+			return;
+
+		// Never requested for this feature level...Compile it the way the cooker does...
+		InOutPending.Resource = nullptr;
+		if (UMaterial* Material = Cast<UMaterial>(InOutPending.Material))
+			Material->CacheResourceShadersForCooking(GShaderPlatformForFeatureLevel[FeatureLevel], InOutPending.OwnedResources);
+		else if (UMaterialInstance* MaterialIns = Cast<UMaterialInstance>(InOutPending.Material))
+			MaterialIns->CacheResourceShadersForCooking(GShaderPlatformForFeatureLevel[FeatureLevel], InOutPending.OwnedResources);
+		for (TArray<FMaterialResource*>::TIterator It_Res(InOutPending.OwnedResources); It_Res; ++It_Res)
+		{
+			if ((*It_Res)->GetFeatureLevel() == FeatureLevel && (QualityLevel == EMaterialQualityLevel::Num || (*It_Res)->GetQualityLevel() == QualityLevel))
+			{
+				InOutPending.Resource = (*It_Res);
+				break;
+			}
+		}
+	}
+
+	/** Wait for the queued shader maps of all passes...Returns the number of materials and instances still unresolved at timeout... */
+	static int32 ResolvePendingMaterialStats(FExportContext& InOutContext, float InTimeout)
+	{
+		TArray<FPendingMaterialStats>& PendingStats = InOutContext.PendingMaterialStats;
+		const double StartTime = FPlatformTime::Seconds();
+		int32 NumRemaining = PendingStats.Num();
+
+		while (NumRemaining > 0)
+		{
+			// Finalize completed shader maps on the game thread...
+			if (GShaderCompilingManager)
+				GShaderCompilingManager->ProcessAsyncResults(false, false);
+
+			NumRemaining = 0;
+			for (TArray<FPendingMaterialStats>::TIterator It(PendingStats); It; ++It)
+			{
+				FPendingMaterialStats& Pending = (*It);
+				if (Pending.bResolved) continue;
+
+				if (Pending.Resource && !IsMaterialResourcePending(Pending.Resource))
+				{
+					Pending.Source.Init(Pending.Resource);
+					Pending.bResolved = true;
+				}
+				else
+				{
+					++NumRemaining;
+				}
+			}
+
+			if (NumRemaining == 0 || FPlatformTime::Seconds() - StartTime > InTimeout)
+				break;
+
+			FPlatformProcess::Sleep(0.05f);
+		}
+
+		TSet<const UMaterialInterface*> UnresolvedMaterials;
+		for (TArray<FPendingMaterialStats>::TConstIterator It(PendingStats); It; ++It)
+		{
+			if (!(*It).bResolved)
+				UnresolvedMaterials.Add((*It).Material);
+		}
+		return UnresolvedMaterials.Num();
+	}
+
+	/** Material and instance rows of one pass from the resolved requests...Unresolved rows stay Pending... */
+	static void PatchPendingMaterialStats(FSceneDataSet& InOutSceneDataSet, const FExportContext& InContext)
+	{
+		auto FindResolved = [&InContext](const UMaterialInterface* InMaterial, int32 InPlatformIndex) -> const FPendingMaterialStats*
+		{
+			const int32* PendingIndex = InContext.PendingMaterialStatsIndices.Find(TPair<const UMaterialInterface*, int32>(InMaterial, InPlatformIndex));
+			const FPendingMaterialStats* Pending = PendingIndex ? &InContext.PendingMaterialStats[*PendingIndex] : nullptr;
+			return Pending && Pending->bResolved ? Pending : nullptr;
+		};
+
+		for (TArray<FSceneMaterialDataSet>::TIterator It(InOutSceneDataSet.MaterialsTable); It; ++It)
+		{
+			FSceneMaterialDataSet& MatDataSet = (*It);
+			if (!MatDataSet.Material) continue;
+
+			if (MatDataSet.bStatsPending)
+			{
+				if (const FPendingMaterialStats* Pending = FindResolved(MatDataSet.Material, INDEX_NONE))
+					MatDataSet.InitDefaultStats(Pending->Source);
+			}
+			for (int32 PlatformIndex = 0; PlatformIndex < MatDataSet.PlatformStats.Num(); ++PlatformIndex)
+			{
+				if (!MatDataSet.PlatformStats[PlatformIndex].bPending) continue;
+				if (const FPendingMaterialStats* Pending = FindResolved(MatDataSet.Material, PlatformIndex))
+					GetMaterialPlatformStats(MatDataSet.PlatformStats[PlatformIndex], Pending->Source);
+			}
+		}
+
+		for (TArray<FSceneMaterialInstanceDataSet>::TIterator It(InOutSceneDataSet.MaterialInstancesTable); It; ++It)
+		{
+			if (!(*It).MaterialInstance || !(*It).HasPendingStats()) continue;
+			if (const FPendingMaterialStats* Pending = FindResolved((*It).MaterialInstance, INDEX_NONE))
+				(*It).InitUniqueShaderMapStats(Pending->Source);
+		}
+	}
+
+	/** Resources compiled for the requests are owned by the export... */
+	static void ReleasePendingMaterialStats(FExportContext& InOutContext)
+	{
+		for (TArray<FPendingMaterialStats>::TIterator It(InOutContext.PendingMaterialStats); It; ++It)
+		{
+			for (TArray<FMaterialResource*>::TIterator It_Res((*It).OwnedResources); It_Res; ++It_Res)
+				delete (*It_Res);
+		}
+		InOutContext.PendingMaterialStats.Empty();
+		InOutContext.PendingMaterialStatsIndices.Empty();
+	}
+
+	static bool HasPendingMaterialStats(const FSceneDataSet& InSceneDataSet)
+	{
+		for (TArray<FSceneMaterialDataSet>::TConstIterator It(InSceneDataSet.MaterialsTable); It; ++It)
+		{
+			if ((*It).HasPendingStats()) return true;
+		}
+		for (TArray<FSceneMaterialInstanceDataSet>::TConstIterator It(InSceneDataSet.MaterialInstancesTable); It; ++It)
+		{
+			if ((*It).HasPendingStats()) return true;
+		}
+		return false;
+	}
+
+	/** Material tables, asset cache and binary tables of one pass...Called once its pending stats are resolved... */
+	static void SavePendingMaterialStatsPass(FPendingMaterialStatsPass& InOutPass, FExportContext& InOutContext, TMap<FString, bool>& OutResultPathsStates)
 	{
-		// extract potential errors
-		const ERHIFeatureLevel::Type MaterialFeatureLevel = MaterialResource->GetFeatureLevel();
-		FString FeatureLevelName;
-		GetFeatureLevelName(MaterialFeatureLevel, FeatureLevelName);
+		FSceneDataSet& BaseDataSet = InOutPass.PerLODSceneDataSets[0];
+		PatchPendingMaterialStats(BaseDataSet, InOutContext);
 
-		OutInfo.Empty();
-		TArray<FString> CompileErrors = MaterialResource->GetCompileErrors();
-		for (int32 ErrorIndex = 0; ErrorIndex < CompileErrors.Num(); ErrorIndex++)
+		TMap<FString, FString> CSVStrings;
+		FExporterHelper::PrintMaterialsTableToCSVString(BaseDataSet.MaterialsTable, InOutContext.StringPool, InOutContext.IndexPool, InOutContext.Settings.FloatPrecisions, CSVStrings);
+		FExporterHelper::PrintMaterialInstancesTableToCSVString(BaseDataSet.MaterialInstancesTable, InOutContext.StringPool, InOutContext.IndexPool, InOutContext.Settings.FloatPrecisions, CSVStrings);
+		FExporterHelper::SaveCSVStringsToFiles(CSVStrings, InOutPass.OutputPath + "/" + InOutPass.TablePrefix + "_", "_LOD0", InOutContext.Settings, OutResultPathsStates);
+		if (InOutContext.Settings.bUseAssetCache)
+			FExporterHelper::StoreMaterialsStats(BaseDataSet.MaterialsTable, InOutContext.Settings, InOutContext.AssetCache);
+
+		if (InOutContext.Settings.bWriteBinaryTables)
 		{
-			OutInfo.StrShaderErrors += FString::Printf(TEXT("[%s] %s\n"), *FeatureLevelName, *CompileErrors[ErrorIndex]);
+			const FString BinaryFilePath = InOutPass.OutputPath + "/" + InOutPass.TablePrefix + "_Tables.stb";
+			OutResultPathsStates.Add(BinaryFilePath, FExporterHelper::SaveSceneDataSetsToBinaryFile(InOutPass.PerLODSceneDataSets, InOutContext.StringPool, InOutContext.IndexPool, BinaryFilePath));
 		}
 
-		bool bNoErrors = OutInfo.StrShaderErrors.Len() == 0;
+		if (InOutPass.OutPerLODSceneDataSets)
+			*InOutPass.OutPerLODSceneDataSets = MoveTemp(InOutPass.PerLODSceneDataSets);
+	}
 
-		if (bNoErrors)
+	/** One wait for the shader maps of the World and all Levels...Then the deferred passes are written... */
+	static void FinishPendingMaterialStats(FExportContext& InOutContext, TMap<FString, bool>& OutResultPathsStates)
+	{
+		if (InOutContext.PendingMaterialStats.Num() > 0)
 		{
-			// extract instructions info
-			GetRepresentativeInstructionCounts(ShaderInstructionInfo, MaterialResource);
-
-			for (int32 InstructionIndex = 0; InstructionIndex < ShaderInstructionInfo.Num(); InstructionIndex++)
+			const int32 NumUnresolved = FExporterHelper::ResolvePendingMaterialStats(InOutContext, InOutContext.Settings.PendingShaderStatsTimeout);
+			if (NumUnresolved > 0)
 			{
-				FShaderStatsInfo::FContent Content;
-
-				Content.StrDescription = ShaderInstructionInfo[InstructionIndex].InstructionCount > 0 ? FString::Printf(TEXT("%u"), ShaderInstructionInfo[InstructionIndex].InstructionCount) : TEXT("n/a");
-				Content.StrDescriptionLong = ShaderInstructionInfo[InstructionIndex].InstructionCount > 0 ?
-					FString::Printf(TEXT("%s: %u instructions"), *ShaderInstructionInfo[InstructionIndex].ShaderDescription, ShaderInstructionInfo[InstructionIndex].InstructionCount) :
-					TEXT("Offline shader compiler not available or an error was encountered!");
-
-				OutInfo.ShaderInstructionCount.Add(ShaderInstructionInfo[InstructionIndex].ShaderType, Content);
+				InOutContext.Notes.Add(FString::Printf(TEXT("[Material Stats] %d materials and instances still compiling after %.0fs, their stats are marked as Pending."),
+					NumUnresolved, InOutContext.Settings.PendingShaderStatsTimeout));
 			}
+		}
 
-			// extract samplers info
-			const int32 SamplersUsed = FMath::Max(MaterialResource->GetSamplerUsage(), 0);
-			const int32 MaxSamplers = GetExpectedFeatureLevelMaxTextureSamplers(MaterialResource->GetFeatureLevel());
-			OutInfo.SamplersCount.StrDescription = FString::Printf(TEXT("%u/%u"), SamplersUsed, MaxSamplers);
-			OutInfo.SamplersCount.StrDescriptionLong = FString::Printf(TEXT("%s samplers: %u/%u"), TEXT("Texture"), SamplersUsed, MaxSamplers);
-
-			// extract esimated sample info
-			uint32 NumVSTextureSamples = 0, NumPSTextureSamples = 0;
-			MaterialResource->GetEstimatedNumTextureSamples(NumVSTextureSamples, NumPSTextureSamples);
-
-			OutInfo.TextureSampleCount.StrDescription = FString::Printf(TEXT("VS(%u), PS(%u)"), NumVSTextureSamples, NumPSTextureSamples);
-			OutInfo.TextureSampleCount.StrDescriptionLong = FString::Printf(TEXT("Texture Lookups (Est.): Vertex(%u), Pixel(%u)"), NumVSTextureSamples, NumPSTextureSamples);
-
-			// extract estimated VT info
-			const uint32 NumVirtualTextureLookups = MaterialResource->GetEstimatedNumVirtualTextureLookups();
-			OutInfo.VirtualTextureLookupCount.StrDescription = FString::Printf(TEXT("%u"), NumVirtualTextureLookups);
-			OutInfo.VirtualTextureLookupCount.StrDescriptionLong = FString::Printf(TEXT("Virtual Texture Lookups (Est.): %u"), NumVirtualTextureLookups);
-
-			// extract interpolators info
-			uint32 UVScalarsUsed, CustomInterpolatorScalarsUsed;
-			MaterialResource->GetUserInterpolatorUsage(UVScalarsUsed, CustomInterpolatorScalarsUsed);
-
-			const uint32 TotalScalars = UVScalarsUsed + CustomInterpolatorScalarsUsed;
-			const uint32 MaxScalars = FMath::DivideAndRoundUp(TotalScalars, 4u) * 4;
+		for (TArray<FPendingMaterialStatsPass>::TIterator It(InOutContext.PendingMaterialStatsPasses); It; ++It)
+			FExporterHelper::SavePendingMaterialStatsPass(*It, InOutContext, OutResultPathsStates);
+		InOutContext.PendingMaterialStatsPasses.Empty();
 
-			OutInfo.InterpolatorsCount.StrDescription = FString::Printf(TEXT("%u/%u"), TotalScalars, MaxScalars);
-			OutInfo.InterpolatorsCount.StrDescriptionLong = FString::Printf(TEXT("User interpolators: %u/%u Scalars (%u/4 Vectors) (TexCoords: %i, Custom: %i)"),
-				TotalScalars, MaxScalars, MaxScalars / 4, UVScalarsUsed, CustomInterpolatorScalarsUsed);
-		}
+		FExporterHelper::ReleasePendingMaterialStats(InOutContext);
 	}
 
-	static void PrintStaticMeshesTableToCSVString(TArray<FSceneStaticMeshDataSet>& InStaticMeshesTable, TMap<FString, FString>& OutCSVStrings)
+	static void PrintStaticMeshesTableToCSVString(TArray<FSceneStaticMeshDataSet>& InStaticMeshesTable, const FStringPool& InStringPool, const FIndexPool& InIndexPool, TMap<FString, FString>& OutCSVStrings)
 	{
 		// StaticMeshesTable...
 		if (InStaticMeshesTable.IsValidIndex(0))
@@ -712,26 +2011,26 @@ public:
 			for (int32 i = 0; i < SMDataSet.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
-				ToCSVFile += SMDataSet[i].Name + ",";
-				ToCSVFile += SMDataSet[i].OwnerName + ",";
+				InStringPool.AppendTo(ToCSVFile, SMDataSet[i].Name) += ",";
+				InStringPool.AppendTo(ToCSVFile, SMDataSet[i].OwnerName) += ",";
 				ToCSVFile += FString::FromInt(SMDataSet[i].NumVertices) + ",";
 				ToCSVFile += FString::FromInt(SMDataSet[i].NumTriangles) + ",";
 				ToCSVFile += FString::FromInt(SMDataSet[i].NumInstances) + ",";
 				ToCSVFile += FString::FromInt(SMDataSet[i].NumLODs) + ",";
 				ToCSVFile += FString::FromInt(SMDataSet[i].CurrentLOD) + ",";
-				ToCSVFile += SMDataSet[i].AssetPath + ",";
+				InStringPool.AppendTo(ToCSVFile, SMDataSet[i].AssetPath) += ",";
 				ToCSVFile += FString::FromInt(SMDataSet[i].UniqueId) + ",";
-				for (TArray<int32>::TIterator It(SMDataSet[i].BoundsIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[SMDataSet[i].BoundsIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += ",";
-				for (TArray<int32>::TIterator It(SMDataSet[i].TransformsIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[SMDataSet[i].TransformsIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += ",";
-				for (TArray<int32>::TIterator It(SMDataSet[i].UsedMaterialsIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[SMDataSet[i].UsedMaterialsIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += ",";
-				for (TArray<int32>::TIterator It(SMDataSet[i].UsedMaterialIntancesIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[SMDataSet[i].UsedMaterialIntancesIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += "\n";
 			}
 
@@ -739,7 +2038,7 @@ public:
 		}
 	}
 
-	static void PrintSkeletalMeshesTableToCSVString(TArray<FSceneSkeletalMeshDataSet>& InSkeletalMeshesTable, TMap<FString, FString>& OutCSVStrings)
+	static void PrintSkeletalMeshesTableToCSVString(TArray<FSceneSkeletalMeshDataSet>& InSkeletalMeshesTable, const FStringPool& InStringPool, const FIndexPool& InIndexPool, TMap<FString, FString>& OutCSVStrings)
 	{
 		// SkeletalMeshesTable...
 		if (InSkeletalMeshesTable.IsValidIndex(0))
@@ -755,22 +2054,22 @@ public:
 			for (int32 i = 0; i < SKDataSet.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
-				ToCSVFile += SKDataSet[i].Name + ",";
-				ToCSVFile += SKDataSet[i].OwnerName + ",";
+				InStringPool.AppendTo(ToCSVFile, SKDataSet[i].Name) += ",";
+				InStringPool.AppendTo(ToCSVFile, SKDataSet[i].OwnerName) += ",";
 				ToCSVFile += FString::FromInt(SKDataSet[i].NumVertices) + ",";
 				ToCSVFile += FString::FromInt(SKDataSet[i].NumTriangles) + ",";
 				ToCSVFile += FString::FromInt(SKDataSet[i].NumSections) + ",";
 				ToCSVFile += FString::FromInt(SKDataSet[i].NumLODs) + ",";
 				ToCSVFile += FString::FromInt(SKDataSet[i].CurrentLOD) + ",";
-				ToCSVFile += SKDataSet[i].AssetPath + ",";
+				InStringPool.AppendTo(ToCSVFile, SKDataSet[i].AssetPath) += ",";
 				ToCSVFile += FString::FromInt(SKDataSet[i].UniqueId) + ",";
 				ToCSVFile += "\\" + FString::FromInt(SKDataSet[i].BoundsIndex) + ",";
 				ToCSVFile += "\\" + FString::FromInt(SKDataSet[i].TransformsIndex) + ",";
-				for (TArray<int32>::TIterator It(SKDataSet[i].UsedMaterialsIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[SKDataSet[i].UsedMaterialsIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += ",";
-				for (TArray<int32>::TIterator It(SKDataSet[i].UsedMaterialIntancesIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[SKDataSet[i].UsedMaterialIntancesIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += "\n";
 			}
 
@@ -789,7 +2088,35 @@ public:
 		}
 	}
 
-	static void PrintPrimitiveTransformsToCSVString(TArray<FMatrix>& InPrimitiveTransforms, TMap<FString, FString>& OutCSVStrings) 
+	/** First row is the quantum of every column, second row the quantized values, the rest deltas to the previous row...
+	 *  Value of a row is Quantum * (sum of the quantized column up to the row)...Small integers compress far better than floats... */
+	static void PrintQuantizedDeltasToCSVString(const float* InValues, int32 InNumRows, int32 InNumColumns, int32 InDecimals, FString& OutCSVString)
+	{
+		const int32 Decimals = InDecimals >= 0 ? FMath::Min(InDecimals, 9) : 4;
+		const double Scale = FMath::Pow(10.f, (float)Decimals);
+
+		OutCSVString += TEXT("Quantum");
+		for (int32 Column = 0; Column < InNumColumns; ++Column)
+			OutCSVString += Decimals > 0 ? TEXT(",0.") + FString::ChrN(Decimals - 1, TEXT('0')) + TEXT("1") : FString(TEXT(",1"));
+		OutCSVString += TEXT("\n");
+		OutCSVString.Reserve(OutCSVString.Len() + InNumRows * InNumColumns * 3);
+
+		TArray<int64, TInlineAllocator<16>> Previous;
+		Previous.SetNumZeroed(InNumColumns);
+		for (int32 Row = 0; Row < InNumRows; ++Row)
+		{
+			FFloatFormatter::AppendInteger(OutCSVString, Row);
+			for (int32 Column = 0; Column < InNumColumns; ++Column)
+			{
+				const int64 Quantized = (int64)FMath::RoundToDouble(InValues[(int64)Row * InNumColumns + Column] * Scale);
+				FFloatFormatter::AppendInteger(OutCSVString += TEXT(","), Quantized - Previous[Column]);
+				Previous[Column] = Quantized;
+			}
+			OutCSVString += TEXT("\n");
+		}
+	}
+
+	static void PrintPrimitiveTransformsToCSVString(TArray<FMatrix>& InPrimitiveTransforms, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings) 
 	{
 		// PrimitiveTransforms...
 		if (InPrimitiveTransforms.IsValidIndex(0))
@@ -801,19 +2128,27 @@ public:
 			for (int i = 0; i < 15; ++i)
 				ToCSVFile += FString::FromInt(i) + ",";
 			ToCSVFile += FString::FromInt(15) + "\n";
+
+			if (InPrecisions.bDeltaTransforms)
+			{
+				PrintQuantizedDeltasToCSVString(&PrimTrans[0].M[0][0], PrimTrans.Num(), 16, InPrecisions.Transforms, ToCSVFile);
+				OutCSVStrings.Add("PrimitiveTransformsDelta", ToCSVFile);
+				return;
+			}
+			ToCSVFile.Reserve(ToCSVFile.Len() + PrimTrans.Num() * 16 * 8);
 			for (int32 i = 0; i < PrimTrans.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
 				for (int j = 0; j < 15; ++j)
-					ToCSVFile += FString::SanitizeFloat(PrimTrans[i].M[j / 4][j % 4]) + ",";
-				ToCSVFile += FString::SanitizeFloat(PrimTrans[i].M[3][3]) + "\n";
+					FFloatFormatter::Append(ToCSVFile, PrimTrans[i].M[j / 4][j % 4], InPrecisions.Transforms) += ",";
+				FFloatFormatter::Append(ToCSVFile, PrimTrans[i].M[3][3], InPrecisions.Transforms) += "\n";
 			}
 
 			OutCSVStrings.Add("PrimitiveTransforms", ToCSVFile);
 		}
 	}
 
-	static void PrintBoundsTableToCSVString(TArray<FBoxSphereBounds>& InBoundsTable, TMap<FString, FString>& OutCSVStrings) 
+	static void PrintBoundsTableToCSVString(TArray<FBoxSphereBounds>& InBoundsTable, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings) 
 	{
 		// BoundsTable...
 		if (InBoundsTable.IsValidIndex(0))
@@ -825,23 +2160,47 @@ public:
 			ToCSVFile += TEXT("OriginX,"); ToCSVFile += TEXT("OriginY,"); ToCSVFile += TEXT("OriginZ,");
 			ToCSVFile += TEXT("BoxExtentX,"); ToCSVFile += TEXT("BoxExtentY,"); ToCSVFile += TEXT("BoxExtentZ,");
 			ToCSVFile += TEXT("SphereRadius\n");
+
+			if (InPrecisions.bDeltaTransforms)
+			{
+				static_assert(sizeof(FBoxSphereBounds) == 7 * sizeof(float), "Bounds are read as 7 floats per row...");
+				PrintQuantizedDeltasToCSVString(&Bounds[0].Origin.X, Bounds.Num(), 7, InPrecisions.Bounds, ToCSVFile);
+				OutCSVStrings.Add("BoundsTableDelta", ToCSVFile);
+				return;
+			}
+			ToCSVFile.Reserve(ToCSVFile.Len() + Bounds.Num() * 7 * 8);
 			for (int32 i = 0; i < Bounds.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].Origin.X) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].Origin.Y) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].Origin.Z) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].BoxExtent.X) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].BoxExtent.Y) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].BoxExtent.Z) + ",";
-				ToCSVFile += FString::SanitizeFloat(Bounds[i].SphereRadius) + "\n";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].Origin.X, InPrecisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].Origin.Y, InPrecisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].Origin.Z, InPrecisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].BoxExtent.X, InPrecisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].BoxExtent.Y, InPrecisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].BoxExtent.Z, InPrecisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Bounds[i].SphereRadius, InPrecisions.Bounds) += "\n";
 			}
 
 			OutCSVStrings.Add("BoundsTable", ToCSVFile);
 		}
 	}
 
-	static void PrintMaterialsTableToCSVString(TArray<FSceneMaterialDataSet>& InMaterialsTable, TMap<FString, FString>& OutCSVStrings) 
+	/** Used vertex factories as \\Name:NumPrimitives in two columns, the second one with those the shader map did not compile...
+	 *  Those render with shaders compiled on demand or fall back to the default material...An empty compiled list is not known yet, all count as used...
+	 */
+	static void AppendUsedVertexFactories(FString& OutCSVString, const TMap<FName, uint32>& InUsedVertexFactories, const TArray<FName>& InCompiledVertexFactories)
+	{
+		FString Uncompiled;
+		for (TMap<FName, uint32>::TConstIterator It(InUsedVertexFactories); It; ++It)
+		{
+			FString& Target = InCompiledVertexFactories.Num() == 0 || InCompiledVertexFactories.Contains((*It).Key) ? OutCSVString : Uncompiled;
+			Target += "\\" + (*It).Key.ToString() + ":" + FString::FromInt((*It).Value);
+		}
+		OutCSVString += ",";
+		OutCSVString += Uncompiled + ",";
+	}
+
+	static void PrintMaterialsTableToCSVString(TArray<FSceneMaterialDataSet>& InMaterialsTable, const FStringPool& InStringPool, const FIndexPool& InIndexPool, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings) 
 	{
 		// MaterialsTable...
 		if (InMaterialsTable.IsValidIndex(0))
@@ -862,6 +2221,22 @@ public:
 			ToCSVFile += TEXT("Stats Texture Lookups (Est.),");
 			ToCSVFile += TEXT("Stats Virtual Texture Lookups (Est.),");
 			ToCSVFile += TEXT("Stats Shader Errors,");
+			// Shader map
+			ToCSVFile += TEXT("Shader Map Permutations,");
+			ToCSVFile += TEXT("Shader Map (KB),");
+			ToCSVFile += TEXT("Shader Map Vertex Factories,");
+			ToCSVFile += TEXT("Shader Map Used Vertex Factories (Primitives),");
+			ToCSVFile += TEXT("Shader Map Uncompiled Vertex Factories (Primitives),");
+			// Side by side feature levels & quality levels
+			for (TArray<FMaterialPlatformStats>::TConstIterator It(MatDataSet[0].PlatformStats); It; ++It)
+			{
+				const FString Label = (*It).GetLabel();
+				ToCSVFile += "[" + Label + "] Base Pass Shader Instructions,";
+				ToCSVFile += "[" + Label + "] Base Pass Vertex Shader,";
+				ToCSVFile += "[" + Label + "] Texture Samplers,";
+				ToCSVFile += "[" + Label + "] Texture Lookups (Est.),";
+				ToCSVFile += "[" + Label + "] Shader Errors,";
+			}
 			// Material
 			ToCSVFile += TEXT("Material Domain,");
 			ToCSVFile += TEXT("Material Blend Mode,");
@@ -896,21 +2271,52 @@ public:
 			for (int32 i = 0; i < MatDataSet.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
-				ToCSVFile += MatDataSet[i].Name + ",";
+				InStringPool.AppendTo(ToCSVFile, MatDataSet[i].Name) += ",";
 				ToCSVFile += FString::FromInt(MatDataSet[i].NumInstances) + ",";
 				ToCSVFile += FString::FromInt(MatDataSet[i].NumRefs) + ",";
 
 				/////////////////////////
 				// Stats
-				ToCSVFile += FString::FromInt(MatDataSet[i].BPSCount) + ",";
-				ToCSVFile += FString::FromInt(MatDataSet[i].BPSSurfaceLightmap) + ",";
-				ToCSVFile += FString::FromInt(MatDataSet[i].BPSVolumetricLightmap) + ",";
-				ToCSVFile += FString::FromInt(MatDataSet[i].BPSVertex) + ",";
+				if (MatDataSet[i].bStatsPending)
+				{
+					// Never print zero instructions for shader maps still compiling...
+					ToCSVFile += TEXT("Pending,Pending,Pending,Pending,");
+				}
+				else
+				{
+					ToCSVFile += FString::FromInt(MatDataSet[i].BPSCount) + ",";
+					ToCSVFile += FString::FromInt(MatDataSet[i].BPSSurfaceLightmap) + ",";
+					ToCSVFile += FString::FromInt(MatDataSet[i].BPSVolumetricLightmap) + ",";
+					ToCSVFile += FString::FromInt(MatDataSet[i].BPSVertex) + ",";
+				}
 				ToCSVFile += "\"_" + MatDataSet[i].TexSamplers + "\",";
 				ToCSVFile += "\"" + MatDataSet[i].UserInterpolators + "\",";
 				ToCSVFile += "\"" + MatDataSet[i].TexLookups + "\",";
 				ToCSVFile += "\"" + MatDataSet[i].VTLookups + "\",";
 				ToCSVFile += "\"" + MatDataSet[i].ShaderErrors + "\",";
+				// Shader map
+				ToCSVFile += FString::FromInt(MatDataSet[i].NumShaderPermutations) + ",";
+				FFloatFormatter::Append(ToCSVFile, MatDataSet[i].ShaderMapBytes / 1024.0f, InPrecisions.KB) += ",";
+				for (TArray<FName>::TIterator It(MatDataSet[i].CompiledVertexFactories); It; ++It)
+					ToCSVFile += "\\" + (*It).ToString();
+				ToCSVFile += ",";
+				AppendUsedVertexFactories(ToCSVFile, MatDataSet[i].UsedVertexFactories, MatDataSet[i].CompiledVertexFactories);
+				// Side by side feature levels & quality levels
+				for (TArray<FMaterialPlatformStats>::TConstIterator It(MatDataSet[i].PlatformStats); It; ++It)
+				{
+					if ((*It).bPending)
+					{
+						ToCSVFile += TEXT("Pending,Pending,");
+					}
+					else
+					{
+						ToCSVFile += FString::FromInt((*It).BPSCount) + ",";
+						ToCSVFile += FString::FromInt((*It).BPSVertex) + ",";
+					}
+					ToCSVFile += "\"_" + (*It).TexSamplers + "\",";
+					ToCSVFile += "\"" + (*It).TexLookups + "\",";
+					ToCSVFile += "\"" + (*It).ShaderErrors + "\",";
+				}
 				// Material
 				ToCSVFile += MatDataSet[i].MaterialDomain + ",";
 				ToCSVFile += MatDataSet[i].BlendMode + ",";
@@ -922,7 +2328,7 @@ public:
 				ToCSVFile += FString::FromInt(MatDataSet[i].bScreenSpaceReflections) + ",";
 				ToCSVFile += FString::FromInt(MatDataSet[i].bContactShadows) + ",";
 				ToCSVFile += MatDataSet[i].TranslucencyLightingMode + ",";
-				ToCSVFile += FString::SanitizeFloat(MatDataSet[i].TranslucencyDirectionalLightingIntensity) + ",";
+				FFloatFormatter::Append(ToCSVFile, MatDataSet[i].TranslucencyDirectionalLightingIntensity, InPrecisions.Default) += ",";
 				ToCSVFile += FString::FromInt(MatDataSet[i].bUseTranslucencyVertexFog) + ","; // Apply Fogging
 				ToCSVFile += FString::FromInt(MatDataSet[i].bComputeFogPerPixel) + ",";
 				ToCSVFile += FString::FromInt(MatDataSet[i].bOutputTranslucentVelocity) + ","; // Output Velocity
@@ -941,13 +2347,13 @@ public:
 				ToCSVFile += FString::FromInt(MatDataSet[i].bUsePlanarForwardReflections) + ",";
 				/////////////////////////
 
-				ToCSVFile += MatDataSet[i].AssetPath + ",";
+				InStringPool.AppendTo(ToCSVFile, MatDataSet[i].AssetPath) += ",";
 				ToCSVFile += FString::FromInt(MatDataSet[i].UniqueId) + ",";
-				for (TArray<int32>::TIterator It(MatDataSet[i].UsedTexturesIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[MatDataSet[i].UsedTexturesIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += ",";
-				for (TArray<int32>::TIterator It(MatDataSet[i].MatInsIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[MatDataSet[i].MatInsIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += "\n";
 			}
 
@@ -955,7 +2361,7 @@ public:
 		}
 	}
 
-	static void PrintMaterialInstancesTableToCSVString(TArray<FSceneMaterialInstanceDataSet>& InMaterialInstancesTable, TMap<FString, FString>& OutCSVStrings)
+	static void PrintMaterialInstancesTableToCSVString(TArray<FSceneMaterialInstanceDataSet>& InMaterialInstancesTable, const FStringPool& InStringPool, const FIndexPool& InIndexPool, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings)
 	{
 		// MaterialInstancesTable...
 		if (InMaterialInstancesTable.IsValidIndex(0))
@@ -966,19 +2372,61 @@ public:
 			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,");
 			ToCSVFile += TEXT("NumRefs,");
 			ToCSVFile += TEXT("ParentName,"); ToCSVFile += TEXT("ParentId,");
+			// Overrides
+			ToCSVFile += TEXT("Overrides Scalar Parameters,");
+			ToCSVFile += TEXT("Overrides Vector Parameters,");
+			ToCSVFile += TEXT("Overrides Texture Parameters,");
+			ToCSVFile += TEXT("Overrides Static Switches,");
+			ToCSVFile += TEXT("Overrides Static Component Masks,");
+			ToCSVFile += TEXT("Has Static Parameter Overrides,");
+			// Unique shader map
+			ToCSVFile += TEXT("Unique Shader Map,");
+			ToCSVFile += TEXT("Stats Base Pass Shader Instructions,");
+			ToCSVFile += TEXT("Stats Base Pass Vertex Shader,");
+			ToCSVFile += TEXT("Stats Texture Samplers,");
+			ToCSVFile += TEXT("Shader Map Permutations,");
+			ToCSVFile += TEXT("Shader Map (KB),");
+			ToCSVFile += TEXT("Shader Map Used Vertex Factories (Primitives),");
+			ToCSVFile += TEXT("Shader Map Uncompiled Vertex Factories (Primitives),");
 			ToCSVFile += TEXT("AssetPath,"); ToCSVFile += TEXT("UniqueId,");
 			ToCSVFile += TEXT("UsedTexturesIds\n");
 			for (int32 i = 0; i < MatInsDataSet.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
-				ToCSVFile += MatInsDataSet[i].Name + ",";
+				InStringPool.AppendTo(ToCSVFile, MatInsDataSet[i].Name) += ",";
 				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumRefs) + ",";
-				ToCSVFile += MatInsDataSet[i].ParentName + ",";
+				InStringPool.AppendTo(ToCSVFile, MatInsDataSet[i].ParentName) += ",";
 				ToCSVFile += FString::FromInt(MatInsDataSet[i].ParentIndex) + ",";
-				ToCSVFile += MatInsDataSet[i].AssetPath + ",";
+				// Overrides
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumScalarOverrides) + ",";
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumVectorOverrides) + ",";
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumTextureOverrides) + ",";
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumStaticSwitchOverrides) + ",";
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumStaticComponentMaskOverrides) + ",";
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].bHasStaticParameterOverrides) + ",";
+				// Unique shader map
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].bHasUniqueShaderMap) + ",";
+				if (!MatInsDataSet[i].bHasUniqueShaderMap)
+				{
+					ToCSVFile += TEXT("n/a,n/a,n/a,");
+				}
+				else if (MatInsDataSet[i].UniqueShaderMapStats.bPending)
+				{
+					ToCSVFile += TEXT("Pending,Pending,Pending,");
+				}
+				else
+				{
+					ToCSVFile += FString::FromInt(MatInsDataSet[i].UniqueShaderMapStats.BPSCount) + ",";
+					ToCSVFile += FString::FromInt(MatInsDataSet[i].UniqueShaderMapStats.BPSVertex) + ",";
+					ToCSVFile += "\"_" + MatInsDataSet[i].UniqueShaderMapStats.TexSamplers + "\",";
+				}
+				ToCSVFile += FString::FromInt(MatInsDataSet[i].NumShaderPermutations) + ",";
+				FFloatFormatter::Append(ToCSVFile, MatInsDataSet[i].ShaderMapBytes / 1024.0f, InPrecisions.KB) += ",";
+				AppendUsedVertexFactories(ToCSVFile, MatInsDataSet[i].UsedVertexFactories, MatInsDataSet[i].CompiledVertexFactories);
+				InStringPool.AppendTo(ToCSVFile, MatInsDataSet[i].AssetPath) += ",";
 				ToCSVFile += FString::FromInt(MatInsDataSet[i].UniqueId) + ",";
-				for (TArray<int32>::TIterator It(MatInsDataSet[i].UsedTexturesIndices); It; ++It)
-					ToCSVFile += "\\" + FString::FromInt(*It);
+				for (int32 Index : InIndexPool[MatInsDataSet[i].UsedTexturesIndices])
+					ToCSVFile += "\\" + FString::FromInt(Index);
 				ToCSVFile += "\n";
 			}
 
@@ -986,7 +2434,7 @@ public:
 		}
 	}
 
-	static void PrintTexturesTableToCSVString(TArray<FSceneTextureDataSet>& InTexturesTable, TMap<FString, FString>& OutCSVStrings) 
+	static void PrintTexturesTableToCSVString(TArray<FSceneTextureDataSet>& InTexturesTable, const FStringPool& InStringPool, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings) 
 	{
 		// TexturesTable...
 		if (InTexturesTable.IsValidIndex(0))
@@ -999,18 +2447,9 @@ public:
 			ToCSVFile += TEXT("CurrentSize,"); ToCSVFile += TEXT("PixelFormat,");
 			ToCSVFile += TEXT("CurrentKB,"); ToCSVFile += TEXT("FullyLoadedKB,");
 
-			// Special Format Size...
-			ToCSVFile += TEXT("PVRTC2 (KB),");
-			ToCSVFile += TEXT("PVRTC4 (KB),");
-			ToCSVFile += TEXT("ASTC_4x4 (KB),");
-			ToCSVFile += TEXT("ASTC_6x6 (KB),");
-			ToCSVFile += TEXT("ASTC_8x8 (KB),");
-			ToCSVFile += TEXT("ASTC_10x10 (KB),");
-			ToCSVFile += TEXT("ASTC_12x12 (KB),");
-
 			ToCSVFile += TEXT("SourceSize,"); ToCSVFile += TEXT("SourceFormat,");
 			ToCSVFile += TEXT("Compression Without Alpha,");
-			ToCSVFile += TEXT("LODBias,");
+			ToCSVFile += TEXT("LODBias,"); ToCSVFile += TEXT("LODGroup,");
 			ToCSVFile += TEXT("NumResidentMips,"); ToCSVFile += TEXT("NumMipsAllowed,");
 			ToCSVFile += TEXT("CurrentMips,"); 
 			ToCSVFile += TEXT("CurrentSizeX,"); ToCSVFile += TEXT("CurrentSizeY,");
@@ -1019,27 +2458,19 @@ public:
 			for (int32 i = 0; i < TexDataSet.Num(); ++i)
 			{
 				ToCSVFile += FString::FromInt(i) + ",";
-				ToCSVFile += TexDataSet[i].Name + ",";
+				InStringPool.AppendTo(ToCSVFile, TexDataSet[i].Name) += ",";
 				ToCSVFile += TexDataSet[i].Type + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].NumRefs) + ",";
 				ToCSVFile += TexDataSet[i].CurrentSize + ",";
 				ToCSVFile += TexDataSet[i].PixelFormat + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].CurrentKB) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].FullyLoadedKB) + ",";
-
-				// Special Format Size...
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].PVRTC2) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].PVRTC4) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].ASTC_4x4) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].ASTC_6x6) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].ASTC_8x8) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].ASTC_10x10) + ",";
-				ToCSVFile += FString::SanitizeFloat(TexDataSet[i].ASTC_12x12) + ",";
+				FFloatFormatter::Append(ToCSVFile, TexDataSet[i].CurrentKB, InPrecisions.KB) += ",";
+				FFloatFormatter::Append(ToCSVFile, TexDataSet[i].FullyLoadedKB, InPrecisions.KB) += ",";
 
 				ToCSVFile += TexDataSet[i].SourceSize + ",";
 				ToCSVFile += TexDataSet[i].SourceFormat + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].CompressionNoAlpha) + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].LODBias) + ",";
+				ToCSVFile += FExporterHelper::EnumToStringEx((TextureGroup)TexDataSet[i].LODGroup) + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].NumResidentMips) + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].NumMipsAllowed) + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].CurrentMips) + ",";
@@ -1047,7 +2478,7 @@ public:
 				ToCSVFile += FString::FromInt(TexDataSet[i].CurrentSizeY) + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].SourceSizeX) + ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].SourceSizeY) + ",";
-				ToCSVFile += TexDataSet[i].AssetPath + ",";
+				InStringPool.AppendTo(ToCSVFile, TexDataSet[i].AssetPath) += ",";
 				ToCSVFile += FString::FromInt(TexDataSet[i].UniqueId) + "\n";
 			}
 
@@ -1055,29 +2486,298 @@ public:
 		}
 	}
 
-	static void PrintSceneDataSetToCSVString(FSceneDataSet& InSceneDataSet, TMap<FString, FString>& OutCSVStrings)
+	static void PrintTextureWhatIfToCSVString(TArray<FSceneTextureDataSet>& InTexturesTable, const FStringPool& InStringPool, const TArray<FTextureWhatIfEngine::FScenario>& InScenarios, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings, FTextureWhatIfEngine::FTotals* OutTotals = nullptr)
+	{
+		// TextureWhatIfTable...
+		if (InTexturesTable.IsValidIndex(0) && InScenarios.IsValidIndex(0))
+		{
+			TArray<FSceneTextureDataSet>& TexDataSet = InTexturesTable;
+
+			// Flat batch of dimensions...
+			FTextureWhatIfEngine::FTextureDimensions Dimensions;
+			Dimensions.Reserve(TexDataSet.Num());
+			for (TArray<FSceneTextureDataSet>::TConstIterator It(TexDataSet); It; ++It)
+			{
+				Dimensions.Add((*It).SizeX, (*It).SizeY, (*It).CurrentMips, (*It).Type == TEXT("Cube") ? 6 : 1, (uint8)FMath::Max((*It).LODBias, 0), (*It).LODGroup);
+			}
+
+			TArray<float> ScenariosKB;
+			TArray<double> TotalsKB;
+			FTextureWhatIfEngine::Evaluate(Dimensions, InScenarios, ScenariosKB, TotalsKB);
+
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("LODGroup,");
+			ToCSVFile += TEXT("CurrentKB,"); ToCSVFile += TEXT("FullyLoadedKB,");
+			for (TArray<FTextureWhatIfEngine::FScenario>::TConstIterator It(InScenarios); It; ++It)
+				ToCSVFile += (*It).Name + " (KB),";
+			ToCSVFile += TEXT("AssetPath\n");
+			for (int32 i = 0; i < TexDataSet.Num(); ++i)
+			{
+				ToCSVFile += FString::FromInt(i) + ",";
+				InStringPool.AppendTo(ToCSVFile, TexDataSet[i].Name) += ",";
+				ToCSVFile += FExporterHelper::EnumToStringEx((TextureGroup)TexDataSet[i].LODGroup) + ",";
+				FFloatFormatter::Append(ToCSVFile, TexDataSet[i].CurrentKB, InPrecisions.KB) += ",";
+				FFloatFormatter::Append(ToCSVFile, TexDataSet[i].FullyLoadedKB, InPrecisions.KB) += ",";
+				for (int32 ScenarioIndex = 0; ScenarioIndex < InScenarios.Num(); ++ScenarioIndex)
+					FFloatFormatter::Append(ToCSVFile, ScenariosKB[ScenarioIndex * TexDataSet.Num() + i], InPrecisions.KB) += ",";
+				InStringPool.AppendTo(ToCSVFile, TexDataSet[i].AssetPath) += "\n";
+			}
+
+			OutCSVStrings.Add("TextureWhatIfTable", ToCSVFile);
+
+			// Totals...Every row above is a texture, see TextureWhatIfLevelTotals...
+			if (OutTotals)
+			{
+				OutTotals->CurrentKB = 0.0;
+				OutTotals->FullyLoadedKB = 0.0;
+				for (TArray<FSceneTextureDataSet>::TConstIterator It(TexDataSet); It; ++It)
+				{
+					OutTotals->CurrentKB += (*It).CurrentKB;
+					OutTotals->FullyLoadedKB += (*It).FullyLoadedKB;
+				}
+				OutTotals->ScenariosKB = MoveTemp(TotalsKB);
+			}
+		}
+	}
+
+	/** Sorted by LOD0 triangles...Heaviest owners first... */
+	static void PrintOwnersTableToCSVString(const FSceneDataSet& InSceneDataSet, const TArray<FSceneOwnerDataSet>& InOwnersTable, const FString& InTableName, const FStringPool& InStringPool, const FIndexPool& InIndexPool, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings)
+	{
+		if (InOwnersTable.IsValidIndex(0))
+		{
+			const TArray<FSceneOwnerDataSet>& OwnerDataSet = InOwnersTable;
+
+			int32 MaxLODs = 0;
+			TArray<int32> SortedRows;
+			SortedRows.Reserve(OwnerDataSet.Num());
+			for (int32 i = 0; i < OwnerDataSet.Num(); ++i)
+			{
+				SortedRows.Add(i);
+				MaxLODs = FMath::Max(MaxLODs, OwnerDataSet[i].NumTrianglesPerLOD.Num());
+			}
+			SortedRows.Sort([&OwnerDataSet](int32 A, int32 B)
+			{
+				const uint64 TrianglesA = OwnerDataSet[A].NumTrianglesPerLOD.Num() > 0 ? OwnerDataSet[A].NumTrianglesPerLOD[0] : 0;
+				const uint64 TrianglesB = OwnerDataSet[B].NumTrianglesPerLOD.Num() > 0 ? OwnerDataSet[B].NumTrianglesPerLOD[0] : 0;
+				return TrianglesA > TrianglesB;
+			});
+
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("ClassName,");
+			ToCSVFile += TEXT("NumActors,"); ToCSVFile += TEXT("NumComponents,"); ToCSVFile += TEXT("NumInstances,");
+			ToCSVFile += TEXT("NumUniqueMaterials,"); ToCSVFile += TEXT("CurrentTextureKB,"); ToCSVFile += TEXT("FullyLoadedTextureKB,");
+			for (int32 LOD = 0; LOD < MaxLODs; ++LOD)
+				ToCSVFile += "NumTrianglesLOD" + FString::FromInt(LOD) + ",";
+			ToCSVFile += TEXT("\n");
+
+			TBitArray<> UsedTextures;
+			for (int32 i = 0; i < SortedRows.Num(); ++i)
+			{
+				const FSceneOwnerDataSet& Row = OwnerDataSet[SortedRows[i]];
+
+				// Unique textures of all materials...
+				UsedTextures.Init(false, InSceneDataSet.TexturesTable.Num());
+				for (TSet<int32>::TConstIterator It(Row.UsedMaterialsIndices); It; ++It)
+					for (int32 TextureIndex : InIndexPool[InSceneDataSet.MaterialsTable[*It].UsedTexturesIndices])
+						UsedTextures[TextureIndex] = true;
+				for (TSet<int32>::TConstIterator It(Row.UsedMaterialIntancesIndices); It; ++It)
+					for (int32 TextureIndex : InIndexPool[InSceneDataSet.MaterialInstancesTable[*It].UsedTexturesIndices])
+						UsedTextures[TextureIndex] = true;
+				float CurrentTextureKB = 0.f, FullyLoadedTextureKB = 0.f;
+				for (TConstSetBitIterator<> It(UsedTextures); It; ++It)
+				{
+					CurrentTextureKB += InSceneDataSet.TexturesTable[It.GetIndex()].CurrentKB;
+					FullyLoadedTextureKB += InSceneDataSet.TexturesTable[It.GetIndex()].FullyLoadedKB;
+				}
+
+				ToCSVFile += FString::FromInt(i) + ",";
+				InStringPool.AppendTo(ToCSVFile, Row.Name) += ",";
+				InStringPool.AppendTo(ToCSVFile, Row.ClassName) += ",";
+				ToCSVFile += FString::FromInt(Row.NumActors) + ",";
+				ToCSVFile += FString::FromInt(Row.NumComponents) + ",";
+				ToCSVFile += FString::FromInt(Row.NumInstances) + ",";
+				ToCSVFile += FString::FromInt(Row.UsedMaterialsIndices.Num() + Row.UsedMaterialIntancesIndices.Num()) + ",";
+				FFloatFormatter::Append(ToCSVFile, CurrentTextureKB, InPrecisions.KB) += ",";
+				FFloatFormatter::Append(ToCSVFile, FullyLoadedTextureKB, InPrecisions.KB) += ",";
+				for (int32 LOD = 0; LOD < MaxLODs; ++LOD)
+					ToCSVFile += (Row.NumTrianglesPerLOD.IsValidIndex(LOD) ? LexToString(Row.NumTrianglesPerLOD[LOD]) : FString()) + ",";
+				ToCSVFile += TEXT("\n");
+			}
+
+			OutCSVStrings.Add(InTableName, ToCSVFile);
+		}
+	}
+
+	static void PrintSceneDataSetToCSVString(FSceneDataSet& InSceneDataSet, const FStringPool& InStringPool, const FIndexPool& InIndexPool, const FFloatFormatter::FPrecisions& InPrecisions, TMap<FString, FString>& OutCSVStrings, bool bWithMaterialsTables = true)
 	{
-		PrintStaticMeshesTableToCSVString(InSceneDataSet.StaticMeshesTable, OutCSVStrings);
-		PrintSkeletalMeshesTableToCSVString(InSceneDataSet.SkeletalMeshesTable, OutCSVStrings);
+		PrintStaticMeshesTableToCSVString(InSceneDataSet.StaticMeshesTable, InStringPool, InIndexPool, OutCSVStrings);
+		PrintSkeletalMeshesTableToCSVString(InSceneDataSet.SkeletalMeshesTable, InStringPool, InIndexPool, OutCSVStrings);
 		PrintLandscapesTableToCSVString(InSceneDataSet.LandscapesTable, OutCSVStrings);
 
-		PrintPrimitiveTransformsToCSVString(InSceneDataSet.PrimitiveTransforms, OutCSVStrings);
-		PrintBoundsTableToCSVString(InSceneDataSet.BoundsTable, OutCSVStrings);
-		PrintMaterialsTableToCSVString(InSceneDataSet.MaterialsTable, OutCSVStrings);
-		PrintMaterialInstancesTableToCSVString(InSceneDataSet.MaterialInstancesTable, OutCSVStrings);
-		PrintTexturesTableToCSVString(InSceneDataSet.TexturesTable, OutCSVStrings);
+		PrintPrimitiveTransformsToCSVString(InSceneDataSet.PrimitiveTransforms, InPrecisions, OutCSVStrings);
+		PrintBoundsTableToCSVString(InSceneDataSet.BoundsTable, InPrecisions, OutCSVStrings);
+		if (bWithMaterialsTables)
+		{
+			PrintMaterialsTableToCSVString(InSceneDataSet.MaterialsTable, InStringPool, InIndexPool, InPrecisions, OutCSVStrings);
+			PrintMaterialInstancesTableToCSVString(InSceneDataSet.MaterialInstancesTable, InStringPool, InIndexPool, InPrecisions, OutCSVStrings);
+		}
+		PrintTexturesTableToCSVString(InSceneDataSet.TexturesTable, InStringPool, InPrecisions, OutCSVStrings);
+
+		PrintOwnersTableToCSVString(InSceneDataSet, InSceneDataSet.OwnersTable, TEXT("OwnersTable"), InStringPool, InIndexPool, InPrecisions, OutCSVStrings);
+		PrintOwnersTableToCSVString(InSceneDataSet, InSceneDataSet.ActorClassesTable, TEXT("ActorClassesTable"), InStringPool, InIndexPool, InPrecisions, OutCSVStrings);
 	}
 
-	/** Main Entry Second... */
-	static void ExportSceneDataToCSV(FScene* InScene, TMap<FPrimitiveComponentId, UPrimitiveComponent*>& InPrimitivesTable, TMap<FString, bool>& OutResultPathsStates, const FString& InOutputPath, const FString& InTablePrefix)
+	static void SaveCSVStringsToFiles(TMap<FString, FString>& InCSVStrings, const FString& InFilePrefix, const FString& InFileSuffix, const FExportSettings& InSettings, TMap<FString, bool>& OutResultPathsStates)
+	{
+		for (TMap<FString, FString>::TIterator It(InCSVStrings); It; ++It)
+		{
+			FString SavedFilePath = InFilePrefix + (*It).Key + InFileSuffix + ".csv";
+
+			bool ResultsStates = InSettings.CompressionFormat != NAME_None
+				? FCompressedFileWriter::SaveStringToFile((*It).Value, SavedFilePath, InSettings.CompressionFormat, InSettings.CompressionChunkKB * 1024)
+				: FFileHelper::SaveStringToFile((*It).Value, SavedFilePath.GetCharArray().GetData(), FFileHelper::EEncodingOptions::ForceUTF8);
+
+			OutResultPathsStates.Add(SavedFilePath, ResultsStates);
+		}
+	}
+
+	static bool SaveSceneDataSetsToBinaryFile(const TArray<FSceneDataSet>& InPerLODSceneDataSets, const FStringPool& InStringPool, const FIndexPool& InIndexPool, const FString& InFilePath)
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*InFilePath));
+		if (!Writer)
+			return false;
+
+		FExporterHelper::SaveSceneDataSetsToBinary(InPerLODSceneDataSets, InStringPool, InIndexPool, *Writer);
+		return Writer->Close();
+	}
+
+	/** Rows of all LODs in one file...Names are ids into the Strings columns, spans are (Offset, Count) into the Indices column... */
+	static void SaveSceneDataSetsToBinary(const TArray<FSceneDataSet>& InPerLODSceneDataSets, const FStringPool& InStringPool, const FIndexPool& InIndexPool, FArchive& OutWriter)
+	{
+		const FSceneDataSet& BaseDataSet = InPerLODSceneDataSets[0];
+		FBinaryTableWriter Writer;
+
+		// Strings as UTF-8...Offsets has one more elem, string i is [Offsets[i], Offsets[i + 1] - 1), null terminated...
+		TArray<uint32> StringOffsets;
+		TArray<uint8>  StringChars;
+		StringOffsets.Reserve(InStringPool.Num() + 1);
+		for (FStringPool::FId Id = 0; Id < (FStringPool::FId)InStringPool.Num(); ++Id)
+		{
+			FTCHARToUTF8 StringUTF8(InStringPool[Id], InStringPool.Len(Id));
+			StringOffsets.Add(StringChars.Num());
+			StringChars.Append((const uint8*)StringUTF8.Get(), StringUTF8.Length());
+			StringChars.Add(0);
+		}
+		StringOffsets.Add(StringChars.Num());
+		Writer.AddColumn(TEXT("Strings.Offsets"), StringOffsets.GetData(), StringOffsets.Num());
+		Writer.AddColumn(TEXT("Strings.Chars"), StringChars.GetData(), StringChars.Num());
+		Writer.AddColumn(TEXT("Indices"), InIndexPool.GetData(), InIndexPool.Num());
+
+		Writer.AddColumn(TEXT("Transforms"), BaseDataSet.PrimitiveTransforms.GetData(), BaseDataSet.PrimitiveTransforms.Num());
+		Writer.AddColumn(TEXT("Bounds.Origin"), BaseDataSet.BoundsTable, [](const FBoxSphereBounds& Row) { return Row.Origin; });
+		Writer.AddColumn(TEXT("Bounds.BoxExtent"), BaseDataSet.BoundsTable, [](const FBoxSphereBounds& Row) { return Row.BoxExtent; });
+		Writer.AddColumn(TEXT("Bounds.SphereRadius"), BaseDataSet.BoundsTable, [](const FBoxSphereBounds& Row) { return Row.SphereRadius; });
+
+		TArray<FSceneStaticMeshDataSet> StaticMeshes;
+		TArray<FSceneSkeletalMeshDataSet> SkeletalMeshes;
+		for (TArray<FSceneDataSet>::TConstIterator It(InPerLODSceneDataSets); It; ++It)
+		{
+			StaticMeshes.Append((*It).StaticMeshesTable);
+			SkeletalMeshes.Append((*It).SkeletalMeshesTable);
+		}
+
+		Writer.AddColumn(TEXT("StaticMeshes.Name"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.Name; });
+		Writer.AddColumn(TEXT("StaticMeshes.OwnerName"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.OwnerName; });
+		Writer.AddColumn(TEXT("StaticMeshes.AssetPath"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.AssetPath; });
+		Writer.AddColumn(TEXT("StaticMeshes.UniqueId"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.UniqueId; });
+		Writer.AddColumn(TEXT("StaticMeshes.CurrentLOD"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.CurrentLOD; });
+		Writer.AddColumn(TEXT("StaticMeshes.NumLODs"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.NumLODs; });
+		Writer.AddColumn(TEXT("StaticMeshes.NumVertices"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.NumVertices; });
+		Writer.AddColumn(TEXT("StaticMeshes.NumTriangles"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.NumTriangles; });
+		Writer.AddColumn(TEXT("StaticMeshes.NumInstances"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.NumInstances; });
+		Writer.AddColumn(TEXT("StaticMeshes.BoundsIndices"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.BoundsIndices; });
+		Writer.AddColumn(TEXT("StaticMeshes.TransformsIndices"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.TransformsIndices; });
+		Writer.AddColumn(TEXT("StaticMeshes.UsedMaterials"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.UsedMaterialsIndices; });
+		Writer.AddColumn(TEXT("StaticMeshes.UsedMaterialInstances"), StaticMeshes, [](const FSceneStaticMeshDataSet& Row) { return Row.UsedMaterialIntancesIndices; });
+
+		Writer.AddColumn(TEXT("SkeletalMeshes.Name"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.Name; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.OwnerName"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.OwnerName; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.AssetPath"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.AssetPath; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.UniqueId"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.UniqueId; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.CurrentLOD"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.CurrentLOD; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.NumLODs"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.NumLODs; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.NumVertices"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.NumVertices; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.NumTriangles"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.NumTriangles; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.NumSections"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.NumSections; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.BoundsIndex"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.BoundsIndex; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.TransformsIndex"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.TransformsIndex; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.UsedMaterials"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.UsedMaterialsIndices; });
+		Writer.AddColumn(TEXT("SkeletalMeshes.UsedMaterialInstances"), SkeletalMeshes, [](const FSceneSkeletalMeshDataSet& Row) { return Row.UsedMaterialIntancesIndices; });
+
+		const TArray<FSceneMaterialDataSet>& Materials = BaseDataSet.MaterialsTable;
+		Writer.AddColumn(TEXT("Materials.Name"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.Name; });
+		Writer.AddColumn(TEXT("Materials.AssetPath"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.AssetPath; });
+		Writer.AddColumn(TEXT("Materials.UniqueId"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.UniqueId; });
+		Writer.AddColumn(TEXT("Materials.NumRefs"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.NumRefs; });
+		Writer.AddColumn(TEXT("Materials.NumInstances"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.NumInstances; });
+		Writer.AddColumn(TEXT("Materials.BPSCount"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.BPSCount; });
+		Writer.AddColumn(TEXT("Materials.BPSVertex"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.BPSVertex; });
+		Writer.AddColumn(TEXT("Materials.NumShaderPermutations"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.NumShaderPermutations; });
+		Writer.AddColumn(TEXT("Materials.ShaderMapBytes"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.ShaderMapBytes; });
+		Writer.AddColumn(TEXT("Materials.MaterialInstances"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.MatInsIndices; });
+		Writer.AddColumn(TEXT("Materials.UsedTextures"), Materials, [](const FSceneMaterialDataSet& Row) { return Row.UsedTexturesIndices; });
+
+		const TArray<FSceneMaterialInstanceDataSet>& MaterialInstances = BaseDataSet.MaterialInstancesTable;
+		Writer.AddColumn(TEXT("MaterialInstances.Name"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.Name; });
+		Writer.AddColumn(TEXT("MaterialInstances.AssetPath"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.AssetPath; });
+		Writer.AddColumn(TEXT("MaterialInstances.UniqueId"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.UniqueId; });
+		Writer.AddColumn(TEXT("MaterialInstances.NumRefs"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.NumRefs; });
+		Writer.AddColumn(TEXT("MaterialInstances.ParentIndex"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.ParentIndex; });
+		Writer.AddColumn(TEXT("MaterialInstances.NumShaderPermutations"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.NumShaderPermutations; });
+		Writer.AddColumn(TEXT("MaterialInstances.ShaderMapBytes"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.ShaderMapBytes; });
+		Writer.AddColumn(TEXT("MaterialInstances.UsedTextures"), MaterialInstances, [](const FSceneMaterialInstanceDataSet& Row) { return Row.UsedTexturesIndices; });
+
+		const TArray<FSceneTextureDataSet>& Textures = BaseDataSet.TexturesTable;
+		Writer.AddColumn(TEXT("Textures.Name"), Textures, [](const FSceneTextureDataSet& Row) { return Row.Name; });
+		Writer.AddColumn(TEXT("Textures.AssetPath"), Textures, [](const FSceneTextureDataSet& Row) { return Row.AssetPath; });
+		Writer.AddColumn(TEXT("Textures.UniqueId"), Textures, [](const FSceneTextureDataSet& Row) { return Row.UniqueId; });
+		Writer.AddColumn(TEXT("Textures.NumRefs"), Textures, [](const FSceneTextureDataSet& Row) { return Row.NumRefs; });
+		Writer.AddColumn(TEXT("Textures.LODBias"), Textures, [](const FSceneTextureDataSet& Row) { return Row.LODBias; });
+		Writer.AddColumn(TEXT("Textures.CurrentKB"), Textures, [](const FSceneTextureDataSet& Row) { return Row.CurrentKB; });
+		Writer.AddColumn(TEXT("Textures.FullyLoadedKB"), Textures, [](const FSceneTextureDataSet& Row) { return Row.FullyLoadedKB; });
+		Writer.AddColumn(TEXT("Textures.SizeX"), Textures, [](const FSceneTextureDataSet& Row) { return Row.SizeX; });
+		Writer.AddColumn(TEXT("Textures.SizeY"), Textures, [](const FSceneTextureDataSet& Row) { return Row.SizeY; });
+		Writer.AddColumn(TEXT("Textures.NumResidentMips"), Textures, [](const FSceneTextureDataSet& Row) { return Row.NumResidentMips; });
+		Writer.AddColumn(TEXT("Textures.LODGroup"), Textures, [](const FSceneTextureDataSet& Row) { return Row.LODGroup; });
+
+		Writer.Save(OutWriter);
+	}
+
+	/** Tables of the primitives without shader stats and files...One data set per LOD... */
+	static bool GatherSceneDataSets(FScene* InScene, TMap<FPrimitiveComponentId, UPrimitiveComponent*>& InPrimitivesTable, const FString& InTablePrefix, FExportContext& InOutContext, TArray<FSceneDataSet>& OutPerLODSceneDataSets)
 	{
 		if (InScene && InScene->PrimitiveComponentIds.IsValidIndex(0))
 		{
-			TArray<FExporterHelper::FSceneDataSet> PerLODSceneDataSets;
+			TArray<FExporterHelper::FSceneDataSet>& PerLODSceneDataSets = OutPerLODSceneDataSets;
 			// Default array num is 1...And this is the base data set of all...
 			uint16 MaxLODs = 1;
+			PerLODSceneDataSets.Reset();
 			PerLODSceneDataSets.AddZeroed(1);
 
+			FExporterHelper::FGatherCache GatherCache;
+
+			// Vertex factories from the scene proxies...Read before the loop, it may enqueue render commands...
+			TMap<const UPrimitiveComponent*, FVertexFactoryNames> PrimitiveVertexFactories;
+			FExporterHelper::GetPrimitiveVertexFactories(InPrimitivesTable, PrimitiveVertexFactories);
+
+			// Index lists of all rows...Per primitive temporaries are on the mem stack...
+			FIndexPool& IndexPool = InOutContext.IndexPool;
+			TArray<UMaterialInterface*> UsedMaterials;
+
+			// Root of the scene rollup...
+			PerLODSceneDataSets[0].Rollup.AddNode(INDEX_NONE, FSceneRollup::ENodeType::World, InOutContext.StringPool.Add(InTablePrefix));
+			TArray<UTexture*> UsedTextures;
+
 			for (TArray<FPrimitiveComponentId>::TIterator It_0(InScene->PrimitiveComponentIds); It_0; ++It_0)
 			{
 				FPrimitiveComponentId InPrimitiveComponentId = (*It_0);
@@ -1087,12 +2787,16 @@ public:
 					UPrimitiveComponent* InPrimitiveComponent = InPrimitivesTable[InPrimitiveComponentId];
 					if (!InPrimitiveComponent) continue;
 
-					TArray<UMaterialInterface*> UsedMaterials;
+					FMemMark Mark(FMemStack::Get());
+					UsedMaterials.Reset();
 
 					int32		  BoundsIndex = -1;
 					int32		  TransformsIndex = -1;
-					TArray<int32> UsedMaterialsIndices;
-					TArray<int32> UsedMaterialIntancesIndices;
+					TArray<int32, TMemStackAllocator<>> UsedMaterialsIndices;
+					TArray<int32, TMemStackAllocator<>> UsedMaterialIntancesIndices;
+					FGatherCache::FMaterialSetup MaterialSetup;
+					MaterialSetup.TextureKB = 0.f;
+					TArray<uint32, TInlineAllocator<8>> TrianglesPerLOD;
 
 					// Do Cast...
 					UStaticMeshComponent*	StaticMeshComponent = Cast<UStaticMeshComponent>(InPrimitiveComponent);
@@ -1113,91 +2817,109 @@ public:
 						TransformsIndex = PerLODSceneDataSets[0].PrimitiveTransforms.Num();
 						PerLODSceneDataSets[0].PrimitiveTransforms.Add(InPrimitiveComponent->GetRenderMatrix());
 
-						InPrimitiveComponent->GetUsedMaterials(UsedMaterials);
-						for (TArray<UMaterialInterface*>::TIterator It_1(UsedMaterials); It_1; ++It_1)
+						// Vertex factories of this primitive...Counted once on every shader map they render with...
+						FVertexFactoryNames VertexFactoryNames;
+						if (const FVertexFactoryNames* ProxyVertexFactoryNames = PrimitiveVertexFactories.Find(InPrimitiveComponent))
+							VertexFactoryNames = *ProxyVertexFactoryNames;
+						else
 						{
-							UMaterialInterface* InMaterial = (*It_1);
-							if (!InMaterial) continue;
-
-							// Do Cast...
-							UMaterial*			  Material = Cast<UMaterial>(InMaterial);
-							UMaterialInstance* MaterialIns = Cast<UMaterialInstance>(InMaterial);
-
-							TArray<int32> UsedTexturesIndices;
-							TArray<UTexture*> UsedTextures;
-							InMaterial->GetUsedTextures(UsedTextures, EMaterialQualityLevel::Num, false, GMaxRHIFeatureLevel, true);
-							FExporterHelper::UpdateTexturesTable<UTexture>(UsedTextures, PerLODSceneDataSets[0].TexturesTable, true, &UsedTexturesIndices);
-
-							FExporterHelper::FSceneMaterialDataSet MaterialDataSet;
-							if (Material)
-							{
-								MaterialDataSet.Init(Material, UsedTexturesIndices);
-
-								int32 IndexMat = -1;
-								/// IndexMat = PerLODSceneDataSets[0].MaterialsTable.AddUnique(MaterialDataSet);
-
-								if (PerLODSceneDataSets[0].MaterialsTable.Find(MaterialDataSet, IndexMat))
-								{
-									PerLODSceneDataSets[0].MaterialsTable[IndexMat].NumRefs++;
-								}
-								else
-								{
-									IndexMat = PerLODSceneDataSets[0].MaterialsTable.Add(MaterialDataSet);
-								}
+							const FName VertexFactoryName = FExporterHelper::GetPrimitiveVertexFactoryName(InPrimitiveComponent);
+							if (VertexFactoryName != NAME_None)
+								VertexFactoryNames.Add(VertexFactoryName);
+						}
 
-								UsedMaterialsIndices.Add(IndexMat);
-							}
-							else if (MaterialIns)
+						// Same mesh and override materials resolve to the same rows...Only the references are counted again...
+						FGatherCache::FMaterialSetupKey MaterialSetupKey;
+						const bool bHasMaterialSetupKey = FExporterHelper::GetMaterialSetupKey(InPrimitiveComponent, MaterialSetupKey);
+						const FGatherCache::FMaterialSetup* CachedMaterialSetup = bHasMaterialSetupKey ? GatherCache.MaterialSetups.Find(MaterialSetupKey) : nullptr;
+						if (CachedMaterialSetup)
+						{
+							FExporterHelper::AddMaterialSetupRefs(PerLODSceneDataSets[0], IndexPool, *CachedMaterialSetup);
+							MaterialSetup = *CachedMaterialSetup;
+						}
+						else
+						{
+							InPrimitiveComponent->GetUsedMaterials(UsedMaterials);
+							for (TArray<UMaterialInterface*>::TIterator It_1(UsedMaterials); It_1; ++It_1)
 							{
-								FExporterHelper::FSceneMaterialInstanceDataSet MaterialInsDataSet;
-
-								MaterialInsDataSet.UniqueId = MaterialIns->GetUniqueID();
-								MaterialInsDataSet.Name = MaterialIns->GetName();
-								MaterialInsDataSet.AssetPath = MaterialIns->GetPathName();
-								MaterialInsDataSet.UsedTexturesIndices = UsedTexturesIndices;
-								MaterialInsDataSet.ParentName = MaterialIns->Parent->GetName();
-
-								FExporterHelper::FSceneMaterialDataSet MatInsParent;
-								uint32 TempUniqueId = MaterialIns->Parent->GetUniqueID();
-								MatInsParent.UniqueId = MaterialIns->Parent->GetMaterial()->GetUniqueID();
+								UMaterialInterface* InMaterial = (*It_1);
+								if (!InMaterial) continue;
 
-								// Parent Mat Relevance...
-								int32 ParentIndex = -1;
-								if (PerLODSceneDataSets[0].MaterialsTable.Find(MatInsParent, ParentIndex))
-								{
-									PerLODSceneDataSets[0].MaterialsTable[ParentIndex].NumRefs++;
-								}
-								else
-								{
-									// @todo...When add new Mat to Table...Update Tex Table data...
-									TArray<int32> ParentMatUsedTexIndices;
-									TArray<UTexture*> NewMatUsedTextures;
-									MaterialIns->Parent->GetMaterial()->GetUsedTextures(NewMatUsedTextures, EMaterialQualityLevel::Num, false, GMaxRHIFeatureLevel, true);
-									FExporterHelper::UpdateTexturesTable<UTexture>(NewMatUsedTextures, PerLODSceneDataSets[0].TexturesTable, true, &ParentMatUsedTexIndices);
-									MatInsParent.Init(MaterialIns->Parent->GetMaterial(), ParentMatUsedTexIndices);
-									// After...
-									ParentIndex = PerLODSceneDataSets[0].MaterialsTable.Add(MatInsParent);
-								}
-								MaterialInsDataSet.ParentIndex = ParentIndex;
+								// Do Cast...
+								UMaterial*			  Material = Cast<UMaterial>(InMaterial);
+								UMaterialInstance* MaterialIns = Cast<UMaterialInstance>(InMaterial);
 
-								int32 IndexMatIns = -1;
-								/// IndexMatIns = PerLODSceneDataSets[0].MaterialInstancesTable.AddUnique(MaterialInsDataSet);
+								const FIndexSpan UsedTexturesIndices = FExporterHelper::ResolveUsedTextures(InMaterial, PerLODSceneDataSets[0].TexturesTable, InOutContext, GatherCache, UsedTextures);
 
-								if (PerLODSceneDataSets[0].MaterialInstancesTable.Find(MaterialInsDataSet, IndexMatIns))
+								if (Material)
 								{
-									PerLODSceneDataSets[0].MaterialInstancesTable[IndexMatIns].NumRefs++;
+									int32 IndexMat = -1;
+									if (int32* CachedIndexMat = GatherCache.MaterialRows.Find(Material))
+									{
+										IndexMat = *CachedIndexMat;
+										PerLODSceneDataSets[0].MaterialsTable[IndexMat].NumRefs++;
+									}
+									else
+									{
+										FExporterHelper::FSceneMaterialDataSet MaterialDataSet;
+										MaterialDataSet.Init(Material, UsedTexturesIndices, InOutContext.StringPool);
+										IndexMat = PerLODSceneDataSets[0].MaterialsTable.Add(MaterialDataSet);
+										GatherCache.MaterialRows.Add(Material, IndexMat);
+									}
+
+									UsedMaterialsIndices.Add(IndexMat);
 								}
-								else
+								else if (MaterialIns)
 								{
-									MaterialInsDataSet.NumRefs = 1;
-									IndexMatIns = PerLODSceneDataSets[0].MaterialInstancesTable.Add(MaterialInsDataSet);
+									int32 IndexMatIns = -1;
+									int32 ParentIndex = -1;
+									if (int32* CachedIndexMatIns = GatherCache.MaterialInstanceRows.Find(MaterialIns))
+									{
+										// Parent chain already resolved...
+										IndexMatIns = *CachedIndexMatIns;
+										ParentIndex = PerLODSceneDataSets[0].MaterialInstancesTable[IndexMatIns].ParentIndex;
+										PerLODSceneDataSets[0].MaterialInstancesTable[IndexMatIns].NumRefs++;
+										PerLODSceneDataSets[0].MaterialsTable[ParentIndex].NumRefs++;
+									}
+									else
+									{
+										// Parent Mat Relevance...
+										UMaterial* ParentMaterial = MaterialIns->GetMaterial();
+										if (int32* CachedParentIndex = GatherCache.MaterialRows.Find(ParentMaterial))
+										{
+											ParentIndex = *CachedParentIndex;
+											PerLODSceneDataSets[0].MaterialsTable[ParentIndex].NumRefs++;
+										}
+										else
+										{
+											// New Mat to Table...Update Tex Table data too...
+											const FIndexSpan ParentMatUsedTexIndices = FExporterHelper::ResolveUsedTextures(ParentMaterial, PerLODSceneDataSets[0].TexturesTable, InOutContext, GatherCache, UsedTextures);
+											FExporterHelper::FSceneMaterialDataSet MatInsParent;
+											MatInsParent.Init(ParentMaterial, ParentMatUsedTexIndices, InOutContext.StringPool);
+											// After...
+											ParentIndex = PerLODSceneDataSets[0].MaterialsTable.Add(MatInsParent);
+											GatherCache.MaterialRows.Add(ParentMaterial, ParentIndex);
+										}
+
+										FExporterHelper::FSceneMaterialInstanceDataSet MaterialInsDataSet;
+										MaterialInsDataSet.Init(MaterialIns, UsedTexturesIndices, InOutContext.StringPool);
+										MaterialInsDataSet.ParentIndex = ParentIndex;
+										IndexMatIns = PerLODSceneDataSets[0].MaterialInstancesTable.Add(MaterialInsDataSet);
+										GatherCache.MaterialInstanceRows.Add(MaterialIns, IndexMatIns);
+									}
+
+									PerLODSceneDataSets[0].MaterialsTable[ParentIndex].NumInstances++;
+									UsedMaterialIntancesIndices.Add(IndexMatIns);
 								}
-
-								PerLODSceneDataSets[0].MaterialsTable[ParentIndex].NumInstances++;
-								PerLODSceneDataSets[0].MaterialsTable[ParentIndex].MatInsIndices.AddUnique(IndexMatIns); // Use Add to Repeated marks
-								UsedMaterialIntancesIndices.Add(IndexMatIns);
 							}
+
+							MaterialSetup.UsedMaterialsIndices = IndexPool.Add(UsedMaterialsIndices);
+							MaterialSetup.UsedMaterialIntancesIndices = IndexPool.Add(UsedMaterialIntancesIndices);
+							MaterialSetup.TextureKB = FExporterHelper::GetMaterialSetupTextureKB(PerLODSceneDataSets[0], IndexPool, MaterialSetup);
+							if (bHasMaterialSetupKey)
+								GatherCache.MaterialSetups.Add(MaterialSetupKey, MaterialSetup);
 						}
+						FExporterHelper::AddVertexFactoryRefs(PerLODSceneDataSets[0], IndexPool, MaterialSetup, VertexFactoryNames);
 					}
 
 					// ...If...
@@ -1208,29 +2930,27 @@ public:
 						{
 							FExporterHelper::FSceneStaticMeshDataSet StaticMeshDataSet;
 							StaticMeshDataSet.UniqueId = StaticMesh->GetUniqueID();
-							StaticMeshDataSet.Name = StaticMesh->GetName();
-							StaticMeshDataSet.AssetPath = StaticMesh->GetPathName();
-							StaticMeshDataSet.OwnerName = StaticMeshComponent->GetOwner()->GetName();
-							// Remove xxx_number...
-							int32 FindLastIndex = -1; // INDEX_NONE
-							if (StaticMeshDataSet.OwnerName.FindLastChar('_', FindLastIndex))
-								StaticMeshDataSet.OwnerName.RemoveAt(FindLastIndex, StaticMeshDataSet.OwnerName.Len() - FindLastIndex);
-
-							// Init First Elem...
-							StaticMeshDataSet.BoundsIndices.AddZeroed(1);
-							StaticMeshDataSet.TransformsIndices.AddZeroed(1);
-							// First is Mesh...Rest is Instance...
-							StaticMeshDataSet.BoundsIndices[0] = BoundsIndex;
-							StaticMeshDataSet.TransformsIndices[0] = TransformsIndex;
-
-							StaticMeshDataSet.UsedMaterialsIndices = UsedMaterialsIndices;
-							StaticMeshDataSet.UsedMaterialIntancesIndices = UsedMaterialIntancesIndices;
+							StaticMeshDataSet.Name = InOutContext.StringPool.Add(StaticMesh->GetName());
+							StaticMeshDataSet.Component = StaticMeshComponent;
+							StaticMeshDataSet.AssetPath = InOutContext.StringPool.Add(StaticMesh->GetPathName());
+							// Remove xxx_number...The number suffix of a name is kept apart by FName...
+							StaticMeshDataSet.OwnerName = InOutContext.StringPool.Add(FName(StaticMeshComponent->GetOwner()->GetFName(), NAME_NO_NUMBER_INTERNAL));
+
+							StaticMeshDataSet.UsedMaterialsIndices = MaterialSetup.UsedMaterialsIndices;
+							StaticMeshDataSet.UsedMaterialIntancesIndices = MaterialSetup.UsedMaterialIntancesIndices;
+
+							StaticMeshDataSet.NumInstances = InstancedStaticMeshComponent ? InstancedStaticMeshComponent->PerInstanceSMData.Num() : 0;
+							// First is Mesh...Rest is Instance...Filled in place...
+							StaticMeshDataSet.BoundsIndices = IndexPool.AddUninitialized(1 + StaticMeshDataSet.NumInstances);
+							StaticMeshDataSet.TransformsIndices = IndexPool.AddUninitialized(1 + StaticMeshDataSet.NumInstances);
+							TArrayView<int32> BoundsIndices = IndexPool[StaticMeshDataSet.BoundsIndices];
+							TArrayView<int32> TransformsIndices = IndexPool[StaticMeshDataSet.TransformsIndices];
+							BoundsIndices[0] = BoundsIndex;
+							TransformsIndices[0] = TransformsIndex;
 
 							// Fill Bounds, Trans Ins...
-							StaticMeshDataSet.NumInstances = 0;
 							if (InstancedStaticMeshComponent)
 							{
-								StaticMeshDataSet.NumInstances = InstancedStaticMeshComponent->PerInstanceSMData.Num();
 								FBoxSphereBounds CurrentInsMeshBounds = StaticMesh->GetBounds();
 								for (uint32 i = 0; i < StaticMeshDataSet.NumInstances; ++i)
 								{
@@ -1238,11 +2958,11 @@ public:
 									CurrentInsMeshBounds.Origin = FVector(TransIns.M[3][0], TransIns.M[3][1], TransIns.M[3][2]);
 
 									BoundsIndex = PerLODSceneDataSets[0].BoundsTable.Num();
-									StaticMeshDataSet.BoundsIndices.Add(BoundsIndex);
+									BoundsIndices[1 + i] = BoundsIndex;
 									PerLODSceneDataSets[0].BoundsTable.Add(CurrentInsMeshBounds);
 
 									TransformsIndex = PerLODSceneDataSets[0].PrimitiveTransforms.Num();
-									StaticMeshDataSet.TransformsIndices.Add(TransformsIndex);
+									TransformsIndices[1 + i] = TransformsIndex;
 									PerLODSceneDataSets[0].PrimitiveTransforms.Add(TransIns);
 								}
 							}
@@ -1263,6 +2983,21 @@ public:
 								StaticMeshDataSet.NumTriangles = CurrentLODRes->GetNumTriangles();
 
 								PerLODSceneDataSets[CurrentLOD].StaticMeshesTable.Add(StaticMeshDataSet);
+								TrianglesPerLOD.Add(StaticMeshDataSet.NumTriangles);
+							}
+
+							const uint32 NumCopies = InstancedStaticMeshComponent ? StaticMeshDataSet.NumInstances : 1;
+							FExporterHelper::AddOwnerRefs(PerLODSceneDataSets[0], GatherCache, InOutContext.StringPool, IndexPool, StaticMeshComponent->GetOwner(), MaterialSetup, TrianglesPerLOD, NumCopies);
+
+							// LOD0 costs of all copies...
+							if (LODs > 0)
+							{
+								FSceneRollup::FCosts Costs;
+								Costs.NumTriangles = (uint64)TrianglesPerLOD[0] * NumCopies;
+								Costs.NumDrawCalls = StaticMesh->RenderData->LODResources[0].Sections.Num();
+								Costs.NumMaterialSlots = MaterialSetup.UsedMaterialsIndices.Num() + MaterialSetup.UsedMaterialIntancesIndices.Num();
+								Costs.TextureKB = MaterialSetup.TextureKB;
+								FExporterHelper::AddRollupNodes(PerLODSceneDataSets[0], GatherCache, InOutContext.StringPool, StaticMeshComponent, StaticMesh, Costs);
 							}
 						}
 					}
@@ -1274,19 +3009,17 @@ public:
 						{
 							FExporterHelper::FSceneSkeletalMeshDataSet SkeletalMeshDataSet;
 							SkeletalMeshDataSet.UniqueId = SkeletalMesh->GetUniqueID();
-							SkeletalMeshDataSet.Name = SkeletalMesh->GetName();
-							SkeletalMeshDataSet.AssetPath = SkeletalMesh->GetPathName();
-							SkeletalMeshDataSet.OwnerName = SkeletalMeshComponent->GetOwner()->GetName();
-							// Remove xxx_number...
-							int32 FindLastIndex = -1; // INDEX_NONE
-							if (SkeletalMeshDataSet.OwnerName.FindLastChar('_', FindLastIndex))
-								SkeletalMeshDataSet.OwnerName.RemoveAt(FindLastIndex, SkeletalMeshDataSet.OwnerName.Len() - FindLastIndex);
+							SkeletalMeshDataSet.Name = InOutContext.StringPool.Add(SkeletalMesh->GetName());
+							SkeletalMeshDataSet.Component = SkeletalMeshComponent;
+							SkeletalMeshDataSet.AssetPath = InOutContext.StringPool.Add(SkeletalMesh->GetPathName());
+							// Remove xxx_number...The number suffix of a name is kept apart by FName...
+							SkeletalMeshDataSet.OwnerName = InOutContext.StringPool.Add(FName(SkeletalMeshComponent->GetOwner()->GetFName(), NAME_NO_NUMBER_INTERNAL));
 
 							SkeletalMeshDataSet.BoundsIndex = BoundsIndex;
 							SkeletalMeshDataSet.TransformsIndex = TransformsIndex;
 
-							SkeletalMeshDataSet.UsedMaterialsIndices = UsedMaterialsIndices;
-							SkeletalMeshDataSet.UsedMaterialIntancesIndices = UsedMaterialIntancesIndices;
+							SkeletalMeshDataSet.UsedMaterialsIndices = MaterialSetup.UsedMaterialsIndices;
+							SkeletalMeshDataSet.UsedMaterialIntancesIndices = MaterialSetup.UsedMaterialIntancesIndices;
 
 							uint16 LODs = RenderData->LODRenderData.Num();
 							MaxLODs = LODs < MaxLODs ? MaxLODs : LODs;
@@ -1307,6 +3040,19 @@ public:
 									SkeletalMeshDataSet.NumTriangles += CurrentLODRes->RenderSections[i].NumTriangles;
 
 								PerLODSceneDataSets[CurrentLOD].SkeletalMeshesTable.Add(SkeletalMeshDataSet);
+								TrianglesPerLOD.Add(SkeletalMeshDataSet.NumTriangles);
+							}
+
+							FExporterHelper::AddOwnerRefs(PerLODSceneDataSets[0], GatherCache, InOutContext.StringPool, IndexPool, SkeletalMeshComponent->GetOwner(), MaterialSetup, TrianglesPerLOD, 1);
+
+							if (LODs > 0)
+							{
+								FSceneRollup::FCosts Costs;
+								Costs.NumTriangles = TrianglesPerLOD[0];
+								Costs.NumDrawCalls = RenderData->LODRenderData[0].RenderSections.Num();
+								Costs.NumMaterialSlots = MaterialSetup.UsedMaterialsIndices.Num() + MaterialSetup.UsedMaterialIntancesIndices.Num();
+								Costs.TextureKB = MaterialSetup.TextureKB;
+								FExporterHelper::AddRollupNodes(PerLODSceneDataSets[0], GatherCache, InOutContext.StringPool, SkeletalMeshComponent, SkeletalMesh, Costs);
 							}
 						}
 					}
@@ -1314,82 +3060,129 @@ public:
 					{
 						LandscapeComponent->GetName();
 					}
+
+					InOutContext.MemStackPeakBytes = FMath::Max<SIZE_T>(InOutContext.MemStackPeakBytes, FMemStack::Get().GetByteCount());
 				}
 			}
 
+			FExporterHelper::BuildMaterialInstancesIndices(PerLODSceneDataSets[0], IndexPool);
+			PerLODSceneDataSets[0].Rollup.Aggregate();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/** Main Entry Second... */
+	static void ExportSceneDataToCSV(FScene* InScene, TMap<FPrimitiveComponentId, UPrimitiveComponent*>& InPrimitivesTable, TMap<FString, bool>& OutResultPathsStates, const FString& InOutputPath, const FString& InTablePrefix, FExportContext& InOutContext, TArray<FSceneDataSet>* OutPerLODSceneDataSets = nullptr)
+	{
+		TArray<FExporterHelper::FSceneDataSet> PerLODSceneDataSets;
+		if (FExporterHelper::GatherSceneDataSets(InScene, InPrimitivesTable, InTablePrefix, InOutContext, PerLODSceneDataSets))
+		{
+			const uint16 MaxLODs = PerLODSceneDataSets.Num();
+			FIndexPool& IndexPool = InOutContext.IndexPool;
+
+			// Shader stats of all gathered materials...Shader maps not finalized are queued once per export and compiled meanwhile...
+			FExporterHelper::GatherMaterialsStats(PerLODSceneDataSets[0].MaterialsTable, InOutContext, InOutContext.Settings.bUseAssetCache ? &InOutContext.AssetCache : nullptr);
+			FExporterHelper::QueuePendingMaterialInstanceStats(PerLODSceneDataSets[0].MaterialInstancesTable, InOutContext);
+
+			// Rest of the tables first...
+			TArray<TMap<FString, FString>> PerLODCSVStrings;
+			PerLODCSVStrings.AddDefaulted(MaxLODs);
+			for (uint16 CurrentLOD = 0; CurrentLOD < MaxLODs; ++CurrentLOD)
+				FExporterHelper::PrintSceneDataSetToCSVString(PerLODSceneDataSets[CurrentLOD], InOutContext.StringPool, IndexPool, InOutContext.Settings.FloatPrecisions, PerLODCSVStrings[CurrentLOD], false);
+
+			// Texture memory what-if...
+			FExporterHelper::PrintTextureWhatIfToCSVString(PerLODSceneDataSets[0].TexturesTable, InOutContext.StringPool, InOutContext.Settings.TextureWhatIfScenarios, InOutContext.Settings.FloatPrecisions, PerLODCSVStrings[0], &InOutContext.TextureWhatIfTotals.Add(InTablePrefix));
+
 			// Save to CSV Files...
 			for (uint16 CurrentLOD = 0; CurrentLOD < MaxLODs; ++CurrentLOD)
 			{
-				TMap<FString, FString> CSVStrings;
-				FExporterHelper::PrintSceneDataSetToCSVString(PerLODSceneDataSets[CurrentLOD], CSVStrings);
+				FExporterHelper::SaveCSVStringsToFiles(PerLODCSVStrings[CurrentLOD], InOutputPath + "/" + InTablePrefix + "_", "_LOD" + FString::FromInt(CurrentLOD), InOutContext.Settings, OutResultPathsStates);
+			}
 
-				for (TMap<FString, FString>::TIterator It(CSVStrings); It; ++It)
-				{
-					FString SavedFilePath = InOutputPath + "/" + InTablePrefix + "_" + (*It).Key + "_LOD" + FString::FromInt(CurrentLOD) + ".csv";
+			// Scene cost rollup of the World and every Level...Full tree in binary, top nodes in json...
+			const FSceneRollup& Rollup = PerLODSceneDataSets[0].Rollup;
+			const FString RollupFilePrefix = InOutputPath + "/" + InTablePrefix + "_SceneRollup";
+			OutResultPathsStates.Add(RollupFilePrefix + ".bin", Rollup.SaveToFile(RollupFilePrefix + ".bin", InOutContext.StringPool));
+			OutResultPathsStates.Add(RollupFilePrefix + "Top.json", FFileHelper::SaveStringToFile(
+				Rollup.PrintTopNodesToJsonString(InOutContext.StringPool, InOutContext.Settings.RollupTopN), *(RollupFilePrefix + "Top.json"), FFileHelper::EEncodingOptions::ForceUTF8));
+
+			// Material rows waiting for shader maps are patched after all passes, see FinishPendingMaterialStats()...
+			FPendingMaterialStatsPass Pass;
+			Pass.OutputPath = InOutputPath;
+			Pass.TablePrefix = InTablePrefix;
+			Pass.OutPerLODSceneDataSets = OutPerLODSceneDataSets;
+			Pass.PerLODSceneDataSets = MoveTemp(PerLODSceneDataSets);
+			if (FExporterHelper::HasPendingMaterialStats(Pass.PerLODSceneDataSets[0]))
+				InOutContext.PendingMaterialStatsPasses.Add(MoveTemp(Pass));
+			else
+				FExporterHelper::SavePendingMaterialStatsPass(Pass, InOutContext, OutResultPathsStates);
+		}
+	}
+
+	/** Primitives of the persistent and loaded streaming levels, all and per level... */
+	static void GatherPrimitives(UWorld* InWorld, TMap<ULevel*, TMap<FPrimitiveComponentId, UPrimitiveComponent*>>& OutPerLevelComps, TMap<FPrimitiveComponentId, UPrimitiveComponent*>& OutPrimitivesTable)
+	{
+		TArray<ULevel*> Levels;
 
-					bool ResultsStates = FFileHelper::SaveStringToFile((*It).Value, SavedFilePath.GetCharArray().GetData(), FFileHelper::EEncodingOptions::ForceUTF8);
+		// Add main level.
+		Levels.AddUnique(InWorld->PersistentLevel);
 
-					OutResultPathsStates.Add(SavedFilePath, ResultsStates);
+		// Add secondary levels.
+		for (ULevelStreaming* StreamingLevel : InWorld->GetStreamingLevels())
+		{
+			if (StreamingLevel)
+			{
+				if (ULevel* Level = StreamingLevel->GetLoadedLevel())
+				{
+					Levels.AddUnique(Level);
 				}
 			}
 		}
-	}
 
-	/** Main Entry First... */
-	static void ExportSceneDataToCSV(TMap<FString, bool>& OutResultPathsStates, const FString& InOutputPath)
-	{
-		UWorld* World = FExporterHelper::GetWorld();
+		TMap<FPrimitiveComponentId, UPrimitiveComponent*> EmptyPrims; EmptyPrims.Empty();
+		for (TArray<ULevel*>::TIterator It(Levels); It; ++It)
+		{
+			OutPerLevelComps.Add((*It), EmptyPrims);
+		}
 
-		if (World)
+		// Iterate UPrimitiveComponent...
+		for (TObjectIterator<UPrimitiveComponent> It; It; ++It)
 		{
-			TMap<ULevel*, TMap<FPrimitiveComponentId, UPrimitiveComponent*>> PerLevelComps;
+			AActor* Owner = (*It)->GetOwner();
 
-			TMap<FPrimitiveComponentId, UPrimitiveComponent*> PrimitivesTable;
-			// Build PrimitivesTable...
+			if (Owner != nullptr && !Owner->HasAnyFlags(RF_ClassDefaultObject))
 			{
-				TArray<ULevel*> Levels;
+				ULevel* CheckLevel = Owner->GetLevel();
 
-				// Add main level.
-				Levels.AddUnique(World->PersistentLevel);
-
-				// Add secondary levels.
-				for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
-				{
-					if (StreamingLevel)
-					{
-						if (ULevel* Level = StreamingLevel->GetLoadedLevel())
-						{
-							Levels.AddUnique(Level);
-						}
-					}
-				}
-
-				TMap<FPrimitiveComponentId, UPrimitiveComponent*> EmptyPrims; EmptyPrims.Empty();
-				for (TArray<ULevel*>::TIterator It(Levels); It; ++It)
+				if (CheckLevel != nullptr && (Levels.Contains(CheckLevel)))
 				{
-					PerLevelComps.Add((*It), EmptyPrims);
+					UPrimitiveComponent* InPrimitiveComponent = (*It);
+				
+					OutPerLevelComps[CheckLevel].Add(InPrimitiveComponent->ComponentId, InPrimitiveComponent);
+					// Build PrimitivesTable...
+					OutPrimitivesTable.Add(InPrimitiveComponent->ComponentId, InPrimitiveComponent);
 				}
+			}
+		}
+	}
 
-				// Iterate UPrimitiveComponent...
-				for (TObjectIterator<UPrimitiveComponent> It; It; ++It)
-				{
-					AActor* Owner = (*It)->GetOwner();
+	/** Main Entry First... */
+	static void ExportSceneDataToCSV(TMap<FString, bool>& OutResultPathsStates, const FString& InOutputPath, FExportContext& InOutContext)
+	{
+		UWorld* World = FExporterHelper::GetWorld();
 
-					if (Owner != nullptr && !Owner->HasAnyFlags(RF_ClassDefaultObject))
-					{
-						ULevel* CheckLevel = Owner->GetLevel();
+		if (World)
+		{
+			const FString AssetCacheFilePath = InOutputPath + "/AssetAnalysisCache.bin";
+			if (InOutContext.Settings.bUseAssetCache)
+				InOutContext.AssetCache.Load(AssetCacheFilePath);
 
-						if (CheckLevel != nullptr && (Levels.Contains(CheckLevel)))
-						{
-							UPrimitiveComponent* InPrimitiveComponent = (*It);
-						
-							PerLevelComps[CheckLevel].Add(InPrimitiveComponent->ComponentId, InPrimitiveComponent);
-							// Build PrimitivesTable...
-							PrimitivesTable.Add(InPrimitiveComponent->ComponentId, InPrimitiveComponent);
-						}
-					}
-				}
-			}
+			TMap<ULevel*, TMap<FPrimitiveComponentId, UPrimitiveComponent*>> PerLevelComps;
+			TMap<FPrimitiveComponentId, UPrimitiveComponent*> PrimitivesTable;
+			FExporterHelper::GatherPrimitives(World, PerLevelComps, PrimitivesTable);
 
 			FScene* Scene = (FScene*)World->Scene;
 
@@ -1429,7 +3222,8 @@ public:
 #endif
 			FString WorldName = World->GetName();
 						
-			ExportSceneDataToCSV(Scene, PrimitivesTable, OutResultPathsStates, InOutputPath + "/World_" + WorldName, WorldName);
+			InOutContext.WorldName = WorldName;
+			ExportSceneDataToCSV(Scene, PrimitivesTable, OutResultPathsStates, InOutputPath + "/World_" + WorldName, WorldName, InOutContext, &InOutContext.WorldSceneDataSets);
 
 			TArray<UTexture2D*> WorldTotalLitShadowMaps;
 			for (TMap<ULevel*, TMap<FPrimitiveComponentId, UPrimitiveComponent*>>::TIterator It(PerLevelComps); It; ++It)
@@ -1437,7 +3231,7 @@ public:
 				/// FString LevelName = (*It).Key->GetFullGroupName(true);
 				FString LevelName = (*It).Key->GetOuter()->GetName();
 
-				ExportSceneDataToCSV(Scene, (*It).Value, OutResultPathsStates, InOutputPath + "/" + LevelName, LevelName);
+				ExportSceneDataToCSV(Scene, (*It).Value, OutResultPathsStates, InOutputPath + "/" + LevelName, LevelName, InOutContext);
 
 				// Export Per Level LightMaps & ShadowMaps...
 				TArray<UTexture2D*> PerLevelLitShadowMaps;
@@ -1446,31 +3240,49 @@ public:
 
 				World->GetLightMapsAndShadowMaps((*It).Key, PerLevelLitShadowMaps);
 				WorldTotalLitShadowMaps.Append(PerLevelLitShadowMaps);
-				UpdateTexturesTable<UTexture2D>(PerLevelLitShadowMaps, PerLevelLSTexturesTable);
-				PrintTexturesTableToCSVString(PerLevelLSTexturesTable, CSVStrings);
+				UpdateTexturesTable<UTexture2D>(PerLevelLitShadowMaps, PerLevelLSTexturesTable, InOutContext.StringPool);
+				PrintTexturesTableToCSVString(PerLevelLSTexturesTable, InOutContext.StringPool, InOutContext.Settings.FloatPrecisions, CSVStrings);
 
-				// Save to CSV Files...
+				// Save to CSV Files...Same compression as the other tables...
 				if (CSVStrings.Num() > 0)
 				{
-					FString SavedFilePath = InOutputPath + "/" + LevelName + "/" + LevelName + "_LightMapsAndShadowMaps.csv";
-					bool ResultsStates = FFileHelper::SaveStringToFile(CSVStrings["TexturesTable"], SavedFilePath.GetCharArray().GetData(), FFileHelper::EEncodingOptions::ForceUTF8);
-					OutResultPathsStates.Add(SavedFilePath, ResultsStates);
+					TMap<FString, FString> LSMapsCSVStrings;
+					LSMapsCSVStrings.Add(TEXT("LightMapsAndShadowMaps"), MoveTemp(CSVStrings["TexturesTable"]));
+					FExporterHelper::SaveCSVStringsToFiles(LSMapsCSVStrings, InOutputPath + "/" + LevelName + "/" + LevelName + "_", FString(), InOutContext.Settings, OutResultPathsStates);
 				}				
 			}
 
+			// Material tables of the passes waiting for shader maps...
+			FExporterHelper::FinishPendingMaterialStats(InOutContext, OutResultPathsStates);
+
 			// World Total LightMaps & ShadowMaps...
 			TArray<FSceneTextureDataSet> WorldTotalLSTexturesTable;
 			TMap<FString, FString> TotalLSMapsCSVStrings;
-			UpdateTexturesTable<UTexture2D>(WorldTotalLitShadowMaps, WorldTotalLSTexturesTable);
-			PrintTexturesTableToCSVString(WorldTotalLSTexturesTable, TotalLSMapsCSVStrings);
+			UpdateTexturesTable<UTexture2D>(WorldTotalLitShadowMaps, WorldTotalLSTexturesTable, InOutContext.StringPool);
+			PrintTexturesTableToCSVString(WorldTotalLSTexturesTable, InOutContext.StringPool, InOutContext.Settings.FloatPrecisions, TotalLSMapsCSVStrings);
 			
-			// Save to CSV Files...
+			// Save to CSV Files...Same compression as the other tables...
 			if (TotalLSMapsCSVStrings.Num() > 0)
 			{
-				FString SavedFilePath = InOutputPath + "/World_" + WorldName + "/" + WorldName + "_LightMapsAndShadowMaps.csv";
-				bool ResultsStates = FFileHelper::SaveStringToFile(TotalLSMapsCSVStrings["TexturesTable"], SavedFilePath.GetCharArray().GetData(), FFileHelper::EEncodingOptions::ForceUTF8);
-				OutResultPathsStates.Add(SavedFilePath, ResultsStates);
-			}		
+				TMap<FString, FString> LSMapsCSVStrings;
+				LSMapsCSVStrings.Add(TEXT("LightMapsAndShadowMaps"), MoveTemp(TotalLSMapsCSVStrings["TexturesTable"]));
+				FExporterHelper::SaveCSVStringsToFiles(LSMapsCSVStrings, InOutputPath + "/World_" + WorldName + "/" + WorldName + "_", FString(), InOutContext.Settings, OutResultPathsStates);
+			}
+
+			InOutContext.Notes.Add(FString::Printf(TEXT("[String Pool] %d unique names and asset paths, %.1f KB."),
+				InOutContext.StringPool.Num(), InOutContext.StringPool.GetAllocatedSize() / 1024.f));
+			if (InOutContext.Settings.bUseAssetCache)
+			{
+				const bool bSaved = InOutContext.AssetCache.Save();
+				OutResultPathsStates.Add(AssetCacheFilePath, bSaved);
+				InOutContext.Notes.Add(FString::Printf(TEXT("[Asset Cache] %d unchanged assets loaded, %d analysed, %d entries."),
+					InOutContext.AssetCache.GetNumHits(), InOutContext.AssetCache.GetNumMisses(), InOutContext.AssetCache.Num()));
+			}
+			const FIndexPool& IndexPool = InOutContext.IndexPool;
+			InOutContext.Notes.Add(FString::Printf(TEXT("[Index Pool] %d index lists, one TArray each would be at least %d allocations of %.1f KB, the pool made %d of %.1f KB, mem stack peak %.1f KB, process peak %.1f MB."),
+				IndexPool.GetNumSpans(), IndexPool.GetNumRowArrayAllocations(), IndexPool.GetRowArrayAllocatedSize() / 1024.f,
+				IndexPool.GetNumAllocations(), IndexPool.GetAllocatedSize() / 1024.f,
+				InOutContext.MemStackPeakBytes / 1024.f, FPlatformMemory::GetStats().PeakUsedPhysical / (1024.f * 1024.f)));
 		}				
 	}
 };
\ No newline at end of file
@@ -0,0 +1,191 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/Reverse.h"
+
+/** Float to text for the CSV tables...Written straight into the table string, no FString per value... */
+class FFloatFormatter
+{
+public:
+
+	// Shortest text that reads back to the same float...
+	static const int32 RoundTrip = -1;
+
+	/** Decimals per kind of column...Loaded from [FloatFormat]... */
+	struct FPrecisions
+	{
+		int32 Transforms;
+		int32 Bounds;
+		int32 KB;
+		int32 Default;
+		// Transforms and bounds as quantized deltas to the previous row, see PrintQuantizedDeltasToCSVString()...
+		bool bDeltaTransforms;
+
+		FPrecisions() : Transforms(4), Bounds(2), KB(1), Default(RoundTrip), bDeltaTransforms(false) {}
+	};
+
+	static FString& Append(FString& OutStr, float InValue, int32 InPrecision = RoundTrip)
+	{
+		TCHAR Buffer[MaxChars];
+		OutStr.AppendChars(Buffer, Format(Buffer, InValue, InPrecision));
+		return OutStr;
+	}
+
+	/** Totals...Round trip is to float precision... */
+	static FString& Append(FString& OutStr, double InValue, int32 InPrecision)
+	{
+		TCHAR Buffer[MaxChars];
+		OutStr.AppendChars(Buffer, InPrecision >= 0 ? FormatFixed(Buffer, InValue, InPrecision) : Format(Buffer, (float)InValue, RoundTrip));
+		return OutStr;
+	}
+
+	static FString& AppendInteger(FString& OutStr, int64 InValue)
+	{
+		TCHAR Buffer[24];
+		TCHAR* End = Buffer + UE_ARRAY_COUNT(Buffer);
+		TCHAR* Out = End;
+		uint64 Abs = InValue < 0 ? 0 - (uint64)InValue : (uint64)InValue;
+		do
+		{
+			*--Out = TEXT('0') + (TCHAR)(Abs % 10);
+			Abs /= 10;
+		} while (Abs != 0);
+		if (InValue < 0)
+			*--Out = TEXT('-');
+
+		OutStr.AppendChars(Out, (int32)(End - Out));
+		return OutStr;
+	}
+
+	/** Fixed mode prints up to InPrecision decimals, trailing zeros trimmed...Returns the num of chars... */
+	static int32 Format(TCHAR* OutBuffer, float InValue, int32 InPrecision = RoundTrip)
+	{
+		return InPrecision >= 0 ? FormatFixed(OutBuffer, InValue, InPrecision) : FormatRoundTrip(OutBuffer, InValue);
+	}
+
+	static const int32 MaxChars = 64;
+
+private:
+
+	static int32 FormatFixed(TCHAR* OutBuffer, double InValue, int32 InPrecision)
+	{
+		if (!FMath::IsFinite(InValue))
+			return FormatNonFinite(OutBuffer, InValue);
+
+		InPrecision = FMath::Min(InPrecision, 9);
+		const double Scaled = FMath::RoundToDouble(FMath::Abs(InValue) * GetPow10(InPrecision));
+		// Beyond exact integers of a double...
+		if (Scaled >= 9.0e15)
+			return FormatRoundTrip(OutBuffer, (float)InValue);
+
+		const uint64 Digits = (uint64)Scaled;
+		TCHAR* Out = OutBuffer;
+		if (InValue < 0.0 && Digits != 0)
+			*Out++ = TEXT('-');
+		return (int32)(WriteDecimal(Out, Digits, InPrecision) - OutBuffer);
+	}
+
+	/** Fewest significant digits that read back exactly...Most values of the tables need far less than 9... */
+	static int32 FormatRoundTrip(TCHAR* OutBuffer, float InValue)
+	{
+		if (!FMath::IsFinite(InValue))
+			return FormatNonFinite(OutBuffer, InValue);
+
+		TCHAR* Out = OutBuffer;
+		if (InValue < 0.f)
+			*Out++ = TEXT('-');
+
+		const double Abs = FMath::Abs((double)InValue);
+		if (Abs == 0.0)
+			return (int32)(WriteDecimal(Out, 0, 0) - OutBuffer);
+
+		// Decimal exponent of the first digit...Plain text range only, tiny and huge values are printed in scientific...
+		int32 Exponent = FMath::FloorToInt(FMath::LogX(10.f, (float)Abs));
+		if (Exponent < MinPlainExponent - 1 || Exponent > MaxPlainExponent + 1)
+			return FormatFallback(OutBuffer, InValue);
+		if (ScaleByPow10(Abs, -Exponent) < 1.0)
+			Exponent--;
+		else if (ScaleByPow10(Abs, -Exponent) >= 10.0)
+			Exponent++;
+		if (Exponent < MinPlainExponent || Exponent > MaxPlainExponent)
+			return FormatFallback(OutBuffer, InValue);
+
+		for (int32 NumDigits = 1; NumDigits <= 9; ++NumDigits)
+		{
+			// Powers of ten of the plain range are exact doubles...
+			const int32 Decimals = NumDigits - 1 - Exponent;
+			const double Digits = FMath::RoundToDouble(ScaleByPow10(Abs, Decimals));
+			if ((float)ScaleByPow10(Digits, -Decimals) == (float)Abs)
+				return (int32)(WriteDecimal(Out, (uint64)Digits, FMath::Max(Decimals, 0), FMath::Max(-Decimals, 0)) - OutBuffer);
+		}
+
+		return FormatFallback(OutBuffer, InValue);
+	}
+
+	/** Digits x 10^-Decimals, followed by NumZeros...At least one decimal like SanitizeFloat... */
+	static TCHAR* WriteDecimal(TCHAR* Out, uint64 InDigits, int32 InDecimals, int32 InNumZeros = 0)
+	{
+		// Most significant first, padded to one integer digit...
+		TCHAR Digits[40];
+		int32 NumDigits = 0;
+		do
+		{
+			Digits[NumDigits++] = TEXT('0') + (TCHAR)(InDigits % 10);
+			InDigits /= 10;
+		} while (InDigits != 0 || NumDigits <= InDecimals);
+		Algo::Reverse(Digits, NumDigits);
+
+		const int32 NumIntegerDigits = NumDigits - InDecimals;
+		int32 FractionEnd = NumDigits;
+		while (FractionEnd > NumIntegerDigits && Digits[FractionEnd - 1] == TEXT('0'))
+			FractionEnd--;
+
+		for (int32 i = 0; i < NumIntegerDigits; ++i)
+			*Out++ = Digits[i];
+		for (int32 i = 0; i < InNumZeros; ++i)
+			*Out++ = TEXT('0');
+		*Out++ = TEXT('.');
+		if (FractionEnd == NumIntegerDigits)
+			*Out++ = TEXT('0');
+		for (int32 i = NumIntegerDigits; i < FractionEnd; ++i)
+			*Out++ = Digits[i];
+		return Out;
+	}
+
+	static int32 FormatNonFinite(TCHAR* OutBuffer, double InValue)
+	{
+		const TCHAR* Text = FMath::IsNaN(InValue) ? TEXT("nan") : InValue < 0.0 ? TEXT("-inf") : TEXT("inf");
+		FCString::Strcpy(OutBuffer, MaxChars, Text);
+		return FCString::Strlen(OutBuffer);
+	}
+
+	/** Scientific...Rare in the tables, so printf is fine... */
+	static int32 FormatFallback(TCHAR* OutBuffer, float InValue)
+	{
+		int32 NumChars = 0;
+		for (int32 NumDigits = 1; NumDigits <= 9; ++NumDigits)
+		{
+			NumChars = FCString::Snprintf(OutBuffer, MaxChars, TEXT("%.*g"), NumDigits, InValue);
+			if (FCString::Atof(OutBuffer) == InValue)
+				break;
+		}
+		return NumChars;
+	}
+
+	/** Exact up to 10^22... */
+	static double GetPow10(int32 InExponent)
+	{
+		static const double Pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		return Pow10[FMath::Clamp(InExponent, 0, 22)];
+	}
+
+	static double ScaleByPow10(double InValue, int32 InExponent)
+	{
+		return InExponent >= 0 ? InValue * GetPow10(InExponent) : InValue / GetPow10(-InExponent);
+	}
+
+	static const int32 MinPlainExponent = -7;
+	static const int32 MaxPlainExponent = 15;
+};
@@ -0,0 +1,108 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Offset and count into a FIndexPool...Zeroed is the empty list... */
+struct FIndexSpan
+{
+	int32 Offset;
+	int32 Count;
+
+	FIndexSpan() : Offset(0), Count(0) {}
+
+	int32 Num() const { return Count; }
+};
+
+/** Index lists of all rows of one export in one linear pool...Released at once with the export...
+ *  Also counts what one TArray per list would have allocated, for the before and after of the export notes...
+ */
+class FIndexPool
+{
+public:
+
+	FIndexPool() : NumSpans(0), NumAllocations(0), RowArrayBytes(0) {}
+
+	template<typename AllocatorType>
+	FIndexSpan Add(const TArray<int32, AllocatorType>& InIndices)
+	{
+		return Add(InIndices.GetData(), InIndices.Num());
+	}
+
+	FIndexSpan Add(const int32* InIndices, int32 InNum)
+	{
+		FIndexSpan Span;
+		if (InNum <= 0)
+			return Span;
+
+		const int32 OldMax = Indices.Max();
+		Span.Offset = Indices.Num();
+		Span.Count = InNum;
+		Indices.Append(InIndices, InNum);
+		CountSpan(OldMax, InNum);
+
+		return Span;
+	}
+
+	/** Uninitialized span to be filled in place... */
+	FIndexSpan AddUninitialized(int32 InNum)
+	{
+		FIndexSpan Span;
+		if (InNum <= 0)
+			return Span;
+
+		const int32 OldMax = Indices.Max();
+		Span.Offset = Indices.AddUninitialized(InNum);
+		Span.Count = InNum;
+		CountSpan(OldMax, InNum);
+
+		return Span;
+	}
+
+	/** Only valid until the next Add()... */
+	TArrayView<const int32> operator[](const FIndexSpan& InSpan) const
+	{
+		return TArrayView<const int32>(Indices.GetData() + InSpan.Offset, InSpan.Count);
+	}
+
+	TArrayView<int32> operator[](const FIndexSpan& InSpan)
+	{
+		return TArrayView<int32>(Indices.GetData() + InSpan.Offset, InSpan.Count);
+	}
+
+	int32 Num() const { return Indices.Num(); }
+	const int32* GetData() const { return Indices.GetData(); }
+	int32 GetNumSpans() const { return NumSpans; }
+	// Growths of the pool...
+	int32 GetNumAllocations() const { return NumAllocations; }
+	// One exact fit TArray per list, a lower bound, arrays grown by Add or AddUnique reallocate more...
+	int32 GetNumRowArrayAllocations() const { return NumSpans; }
+	SIZE_T GetRowArrayAllocatedSize() const { return RowArrayBytes; }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Indices.GetAllocatedSize();
+	}
+
+	void Reset()
+	{
+		Indices.Empty();
+		NumSpans = NumAllocations = 0;
+		RowArrayBytes = 0;
+	}
+
+private:
+
+	void CountSpan(int32 InOldMax, int32 InNum)
+	{
+		NumSpans++;
+		NumAllocations += Indices.Max() != InOldMax ? 1 : 0;
+		RowArrayBytes += FMemory::QuantizeSize(InNum * sizeof(int32));
+	}
+
+	TArray<int32> Indices;
+	int32 NumSpans;
+	int32 NumAllocations;
+	SIZE_T RowArrayBytes;
+};
@@ -0,0 +1,234 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+
+/** Same mesh with the same materials placed as many separate components...Candidates for ISM/HISM...
+ *  One pass over the static mesh rows with a hash map, then one more over the members of the groups...
+ */
+class FInstancingDetector
+{
+public:
+
+	/** Components that could be one instanced component...Materials are compared by content, not by span... */
+	struct FGroupKey
+	{
+		uint32 MeshId;
+		uint16 NumLODs;
+		int16  ForcedLOD; // 0 is auto...
+		int16  MinLOD;
+		TArrayView<const int32> Materials;
+		TArrayView<const int32> MaterialInstances;
+
+		bool operator==(const FGroupKey& InOther) const
+		{
+			return MeshId == InOther.MeshId && NumLODs == InOther.NumLODs && ForcedLOD == InOther.ForcedLOD && MinLOD == InOther.MinLOD
+				&& Materials.Num() == InOther.Materials.Num() && MaterialInstances.Num() == InOther.MaterialInstances.Num()
+				&& FMemory::Memcmp(Materials.GetData(), InOther.Materials.GetData(), Materials.Num() * sizeof(int32)) == 0
+				&& FMemory::Memcmp(MaterialInstances.GetData(), InOther.MaterialInstances.GetData(), MaterialInstances.Num() * sizeof(int32)) == 0;
+		}
+
+		friend uint32 GetTypeHash(const FGroupKey& InKey)
+		{
+			uint32 Hash = HashCombine(InKey.MeshId, (uint32)InKey.NumLODs | ((uint32)(uint16)InKey.ForcedLOD << 16));
+			Hash = HashCombine(Hash, (uint32)(uint16)InKey.MinLOD);
+			Hash = FCrc::MemCrc32(InKey.Materials.GetData(), InKey.Materials.Num() * sizeof(int32), Hash);
+			return FCrc::MemCrc32(InKey.MaterialInstances.GetData(), InKey.MaterialInstances.Num() * sizeof(int32), Hash);
+		}
+	};
+
+	struct FGroup
+	{
+		int32 FirstRow; // Name, materials and triangles of the group...
+		int32 NumComponents;
+		int32 NumClusters;
+		int32 FirstCluster; // See FResult::Clusters...
+		int64 DrawCallsBefore;
+		int64 DrawCallsAfter;
+	};
+
+	/** Components of one group inside one cube of ClusterSize...One HISM each keeps culling per cluster... */
+	struct FCluster
+	{
+		FIntVector Cell;
+		FVector Center; // Mean bounds center...
+		int32 NumComponents;
+	};
+
+	struct FResult
+	{
+		TArray<FGroup> Groups; // Most draw calls saved first...
+		TArray<FCluster> Clusters;
+	};
+
+	/** Draw calls as material slots per component and per cluster, sections are not in the tables... */
+	static void FindGroups(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FIndexPool& InIndexPool, int32 InMinGroupSize, float InClusterSize, FResult& OutResult)
+	{
+		OutResult.Groups.Reset();
+		OutResult.Clusters.Reset();
+
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+
+		// Key -> Candidate...Rows of a candidate are linked through NextRow, no array per candidate...
+		TMap<FGroupKey, int32> CandidateIndices;
+		CandidateIndices.Reserve(Rows.Num() / 4);
+		TArray<int32> CandidateHeads;
+		TArray<int32> CandidateCounts;
+		TArray<int32> NextRow;
+		NextRow.Init(INDEX_NONE, Rows.Num());
+
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+		{
+			const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[Row];
+			const UStaticMeshComponent* Component = Cast<UStaticMeshComponent>(StaticMesh.Component.Get());
+			// Already instanced, even with no instances yet...
+			if (StaticMesh.NumInstances > 0 || Cast<UInstancedStaticMeshComponent>(Component))
+				continue;
+
+			FGroupKey Key;
+			Key.MeshId = StaticMesh.UniqueId;
+			Key.NumLODs = StaticMesh.NumLODs;
+			Key.ForcedLOD = 0;
+			Key.MinLOD = 0;
+			if (Component)
+			{
+				Key.ForcedLOD = (int16)Component->ForcedLodModel;
+				Key.MinLOD = Component->bOverrideMinLOD ? (int16)Component->MinLOD : 0;
+			}
+			Key.Materials = InIndexPool[StaticMesh.UsedMaterialsIndices];
+			Key.MaterialInstances = InIndexPool[StaticMesh.UsedMaterialIntancesIndices];
+
+			const int32* CandidateIndex = CandidateIndices.Find(Key);
+			if (CandidateIndex)
+			{
+				NextRow[Row] = CandidateHeads[*CandidateIndex];
+				CandidateHeads[*CandidateIndex] = Row;
+				CandidateCounts[*CandidateIndex]++;
+			}
+			else
+			{
+				CandidateIndices.Add(Key, CandidateHeads.Add(Row));
+				CandidateCounts.Add(1);
+			}
+		}
+
+		// Clusters of every group above the threshold...
+		TMap<FIntVector, int32> CellClusters;
+		for (int32 Candidate = 0; Candidate < CandidateHeads.Num(); ++Candidate)
+		{
+			if (CandidateCounts[Candidate] < InMinGroupSize)
+				continue;
+
+			FGroup& Group = OutResult.Groups[OutResult.Groups.AddUninitialized()];
+			Group.FirstRow = CandidateHeads[Candidate];
+			Group.NumComponents = CandidateCounts[Candidate];
+			Group.FirstCluster = OutResult.Clusters.Num();
+
+			CellClusters.Reset();
+			for (int32 Row = CandidateHeads[Candidate]; Row != INDEX_NONE; Row = NextRow[Row])
+			{
+				const FVector Center = InSceneDataSet.BoundsTable[InIndexPool[Rows[Row].BoundsIndices][0]].Origin;
+				const FIntVector Cell(FMath::FloorToInt(Center.X / InClusterSize), FMath::FloorToInt(Center.Y / InClusterSize), FMath::FloorToInt(Center.Z / InClusterSize));
+
+				int32* ClusterIndex = CellClusters.Find(Cell);
+				if (!ClusterIndex)
+				{
+					FCluster& Cluster = OutResult.Clusters[OutResult.Clusters.AddZeroed()];
+					Cluster.Cell = Cell;
+					ClusterIndex = &CellClusters.Add(Cell, OutResult.Clusters.Num() - 1);
+				}
+				FCluster& Cluster = OutResult.Clusters[*ClusterIndex];
+				Cluster.Center += Center;
+				Cluster.NumComponents++;
+			}
+			for (int32 i = Group.FirstCluster; i < OutResult.Clusters.Num(); ++i)
+				OutResult.Clusters[i].Center /= (float)OutResult.Clusters[i].NumComponents;
+
+			const int64 NumSlots = FMath::Max(Rows[Group.FirstRow].UsedMaterialsIndices.Num() + Rows[Group.FirstRow].UsedMaterialIntancesIndices.Num(), 1);
+			Group.NumClusters = OutResult.Clusters.Num() - Group.FirstCluster;
+			Group.DrawCallsBefore = Group.NumComponents * NumSlots;
+			Group.DrawCallsAfter = Group.NumClusters * NumSlots;
+		}
+
+		OutResult.Groups.Sort([](const FGroup& A, const FGroup& B)
+		{
+			return (A.DrawCallsBefore - A.DrawCallsAfter) > (B.DrawCallsBefore - B.DrawCallsAfter);
+		});
+	}
+
+	static void PrintInstancingToCSVString(const FExporterHelper::FSceneDataSet& InSceneDataSet, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+
+		FResult Result;
+		FindGroups(InSceneDataSet, InOutContext.IndexPool, Settings.InstancingMinGroupSize, Settings.InstancingClusterSize, Result);
+		if (Result.Groups.Num() == 0)
+			return;
+
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+
+		int64 NumDrawCallsSaved = 0;
+		int32 NumComponents = 0;
+
+		// InstancingGroups...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,");
+			ToCSVFile += TEXT("NumComponents,"); ToCSVFile += TEXT("NumClusters,");
+			ToCSVFile += TEXT("NumMaterials,"); ToCSVFile += TEXT("NumTriangles,");
+			ToCSVFile += TEXT("DrawCallsBefore,"); ToCSVFile += TEXT("DrawCallsAfter,"); ToCSVFile += TEXT("DrawCallsSaved,");
+			ToCSVFile += TEXT("AssetPath\n");
+			for (int32 i = 0; i < Result.Groups.Num(); ++i)
+			{
+				const FGroup& Group = Result.Groups[i];
+				const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[Group.FirstRow];
+				ToCSVFile += FString::FromInt(i) + ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, StaticMesh.Name) += ",";
+				ToCSVFile += FString::FromInt(Group.NumComponents) + ",";
+				ToCSVFile += FString::FromInt(Group.NumClusters) + ",";
+				ToCSVFile += FString::FromInt(StaticMesh.UsedMaterialsIndices.Num() + StaticMesh.UsedMaterialIntancesIndices.Num()) + ",";
+				ToCSVFile += FString::FromInt(StaticMesh.NumTriangles) + ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Group.DrawCallsBefore) += ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Group.DrawCallsAfter) += ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Group.DrawCallsBefore - Group.DrawCallsAfter) += ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, StaticMesh.AssetPath) += "\n";
+
+				NumDrawCallsSaved += Group.DrawCallsBefore - Group.DrawCallsAfter;
+				NumComponents += Group.NumComponents;
+			}
+
+			OutCSVStrings.Add("InstancingGroups", ToCSVFile);
+		}
+
+		// InstancingClusters...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("GroupId,"); ToCSVFile += TEXT("CellX,"); ToCSVFile += TEXT("CellY,"); ToCSVFile += TEXT("CellZ,");
+			ToCSVFile += TEXT("CenterX,"); ToCSVFile += TEXT("CenterY,"); ToCSVFile += TEXT("CenterZ,");
+			ToCSVFile += TEXT("NumComponents\n");
+			for (int32 i = 0; i < Result.Groups.Num(); ++i)
+			{
+				const FGroup& Group = Result.Groups[i];
+				for (int32 ClusterIndex = Group.FirstCluster; ClusterIndex < Group.FirstCluster + Group.NumClusters; ++ClusterIndex)
+				{
+					const FCluster& Cluster = Result.Clusters[ClusterIndex];
+					ToCSVFile += FString::FromInt(i) + ",";
+					ToCSVFile += FString::FromInt(Cluster.Cell.X) + ",";
+					ToCSVFile += FString::FromInt(Cluster.Cell.Y) + ",";
+					ToCSVFile += FString::FromInt(Cluster.Cell.Z) + ",";
+					FFloatFormatter::Append(ToCSVFile, Cluster.Center.X, Precisions.Bounds) += ",";
+					FFloatFormatter::Append(ToCSVFile, Cluster.Center.Y, Precisions.Bounds) += ",";
+					FFloatFormatter::Append(ToCSVFile, Cluster.Center.Z, Precisions.Bounds) += ",";
+					ToCSVFile += FString::FromInt(Cluster.NumComponents) + "\n";
+				}
+			}
+
+			OutCSVStrings.Add("InstancingClusters", ToCSVFile);
+		}
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[Instancing] %d groups of at least %d components, %d components, about %lld draw calls saved with one instanced component per %.0f cluster."),
+			Result.Groups.Num(), Settings.InstancingMinGroupSize, NumComponents, NumDrawCallsSaved, Settings.InstancingClusterSize));
+	}
+};
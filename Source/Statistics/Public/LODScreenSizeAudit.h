@@ -0,0 +1,353 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "NavigationSystem.h"
+
+/** LOD screen sizes of the static meshes checked against where the player can be...
+ *
+ *  Player positions: random points of the navmesh, or an XY grid dropped on the first surface below, roofs included...
+ *  Every instance switches LOD i at Radius / (tan(FOV / 2) * ScreenSize[i]), the engine LOD selection in distances...
+ *  Four instances per SIMD register against every position within ViewDistance...
+ *  High LODs unused: LOD0 drawn in less than MinLODUsage of the visible positions...
+ *  Low LODs late   : more than MaxDenseShare of the visible positions draw over MaxTrianglesPerPixel...
+ */
+class FLODScreenSizeAudit
+{
+public:
+
+	struct FMeshResult
+	{
+		int32 MeshRow; // First row of the mesh in StaticMeshesTable...
+		int32 NumLODs;
+		int32 NumInstances;
+		uint32 NumTriangles[MAX_STATIC_MESH_LODS];
+		float ScreenSizes[MAX_STATIC_MESH_LODS];
+		int64 LODUses[MAX_STATIC_MESH_LODS]; // Visible positions per LOD...
+		int64 NumDense;
+		int64 NumVisible;
+	};
+
+	struct FInstanceResult
+	{
+		int32 Mesh; // See FResult::Meshes...
+		int32 BoundsIndex;
+		float Radius;
+		float NearestDistance;
+	};
+
+	struct FResult
+	{
+		TArray<FVector> Positions;
+		TArray<FMeshResult> Meshes;
+		TArray<FInstanceResult> Instances;
+		float DistanceScale; // Switch distance of LOD i is DistanceScale * Radius / ScreenSizes[i]...
+		int32 MaxLODs;
+		bool bNavMesh;
+	};
+
+	/** Player eye positions...Navmesh when asked for and built, the grid otherwise... */
+	static bool GetPlayerPositions(UWorld* InWorld, const FExporterHelper::FSceneDataSet& InSceneDataSet, const FExporterHelper::FExportSettings& InSettings, TArray<FVector>& OutPositions)
+	{
+		OutPositions.Reset();
+		if (!InWorld)
+			return false;
+
+		const FVector EyeOffset(0.f, 0.f, InSettings.LODAuditEyeHeight);
+		UNavigationSystemV1* NavSystem = InSettings.bLODAuditNavMesh ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(InWorld) : nullptr;
+		if (NavSystem && NavSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate))
+		{
+			FNavLocation Location;
+			for (int32 i = 0; i < InSettings.LODAuditMaxPositions; ++i)
+			{
+				if (NavSystem->GetRandomPoint(Location))
+					OutPositions.Add(Location.Location + EyeOffset);
+			}
+			if (OutPositions.Num() > 0)
+				return true;
+		}
+
+		FBox SceneBox(EForceInit::ForceInit);
+		for (TArray<FBoxSphereBounds>::TConstIterator It(InSceneDataSet.BoundsTable); It; ++It)
+			SceneBox += (*It).GetBox();
+		if (!SceneBox.IsValid)
+			return false;
+
+		// Cells grow until the grid fits in MaxPositions...
+		float CellSize = InSettings.LODAuditGridCellSize;
+		int32 NumX = 0, NumY = 0;
+		do
+		{
+			NumX = FMath::Max(FMath::CeilToInt((SceneBox.Max.X - SceneBox.Min.X) / CellSize), 1);
+			NumY = FMath::Max(FMath::CeilToInt((SceneBox.Max.Y - SceneBox.Min.Y) / CellSize), 1);
+			CellSize *= 2.f;
+		} while ((int64)NumX * NumY > InSettings.LODAuditMaxPositions);
+		CellSize *= 0.5f;
+
+		FCollisionQueryParams QueryParams(FName(TEXT("LODScreenSizeAudit")), false);
+		FHitResult Hit;
+		for (int32 Y = 0; Y < NumY; ++Y)
+		{
+			for (int32 X = 0; X < NumX; ++X)
+			{
+				const FVector2D Cell(SceneBox.Min.X + (X + 0.5f) * CellSize, SceneBox.Min.Y + (Y + 0.5f) * CellSize);
+				const FVector Start(Cell, SceneBox.Max.Z + 1.f);
+				const FVector End(Cell, SceneBox.Min.Z - 1.f);
+				if (InWorld->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, QueryParams))
+					OutPositions.Add(Hit.ImpactPoint + EyeOffset);
+			}
+		}
+		return false;
+	}
+
+	static void Audit(UWorld* InWorld, const FExporterHelper::FSceneDataSet& InSceneDataSet, const FIndexPool& InIndexPool, const FExporterHelper::FExportSettings& InSettings, FResult& OutResult)
+	{
+		OutResult.Meshes.Reset();
+		OutResult.Instances.Reset();
+		OutResult.MaxLODs = 1;
+		OutResult.bNavMesh = GetPlayerPositions(InWorld, InSceneDataSet, InSettings, OutResult.Positions);
+
+		// Same projection as FTextureStreamingSimulator...ScreenSize is the bounds diameter over the screen height...
+		const float TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(InSettings.StreamingFOV, 1.f, 170.f) * 0.5f));
+		OutResult.DistanceScale = 1.f / TanHalfFOV;
+
+		// Meshes and their instances...Forced LODs never switch...
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+		TMap<uint32, int32> MeshIndices;
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+		{
+			const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[Row];
+			const UStaticMeshComponent* Component = Cast<UStaticMeshComponent>(StaticMesh.Component.Get());
+			const UStaticMesh* Mesh = Component ? Component->GetStaticMesh() : nullptr;
+			if (!Mesh || !Mesh->RenderData || Component->ForcedLodModel > 0)
+				continue;
+
+			const int32* MeshIndex = MeshIndices.Find(StaticMesh.UniqueId);
+			if (!MeshIndex)
+			{
+				FMeshResult& MeshResult = OutResult.Meshes[OutResult.Meshes.AddZeroed()];
+				MeshResult.MeshRow = Row;
+				MeshResult.NumLODs = FMath::Min(Mesh->RenderData->LODResources.Num(), MAX_STATIC_MESH_LODS);
+				for (int32 LODIndex = 0; LODIndex < MeshResult.NumLODs; ++LODIndex)
+				{
+					MeshResult.NumTriangles[LODIndex] = Mesh->RenderData->LODResources[LODIndex].GetNumTriangles();
+					MeshResult.ScreenSizes[LODIndex] = Mesh->RenderData->ScreenSize[LODIndex].Default;
+				}
+				OutResult.MaxLODs = FMath::Max(OutResult.MaxLODs, MeshResult.NumLODs);
+				MeshIndex = &MeshIndices.Add(StaticMesh.UniqueId, OutResult.Meshes.Num() - 1);
+			}
+
+			// First bounds is the component...Instanced components only count their instances...
+			TArrayView<const int32> BoundsIndices = InIndexPool[StaticMesh.BoundsIndices];
+			for (int32 i = StaticMesh.NumInstances > 0 ? 1 : 0; i < BoundsIndices.Num(); ++i)
+			{
+				FInstanceResult& Instance = OutResult.Instances[OutResult.Instances.AddUninitialized()];
+				Instance.Mesh = *MeshIndex;
+				Instance.BoundsIndex = BoundsIndices[i];
+				Instance.Radius = InSceneDataSet.BoundsTable[Instance.BoundsIndex].SphereRadius;
+				Instance.NearestDistance = MAX_flt;
+				OutResult.Meshes[*MeshIndex].NumInstances++;
+			}
+		}
+
+		const int32 NumInstances = OutResult.Instances.Num();
+		const int32 NumPositions = OutResult.Positions.Num();
+		if (NumInstances == 0 || NumPositions == 0)
+			return;
+
+		// Structure of arrays padded to whole registers...Padding lanes are never visible...
+		const int32 NumGroups = (NumInstances + 3) / 4;
+		const int32 NumPadded = NumGroups * 4;
+		const int32 NumThresholds = OutResult.MaxLODs - 1;
+		TArray<float> CentersX, CentersY, CentersZ, DenseLimits, Thresholds;
+		CentersX.Init(MAX_flt, NumPadded);
+		CentersY.Init(MAX_flt, NumPadded);
+		CentersZ.Init(MAX_flt, NumPadded);
+		DenseLimits.Init(0.f, NumPadded);
+		Thresholds.Init(MAX_flt, FMath::Max(NumThresholds, 1) * NumPadded); // Squared switch distance of LOD 1..N, NumPadded per LOD...
+		for (int32 Index = 0; Index < NumInstances; ++Index)
+		{
+			const FInstanceResult& Instance = OutResult.Instances[Index];
+			const FMeshResult& MeshResult = OutResult.Meshes[Instance.Mesh];
+			const FVector& Center = InSceneDataSet.BoundsTable[Instance.BoundsIndex].Origin;
+			CentersX[Index] = Center.X;
+			CentersY[Index] = Center.Y;
+			CentersZ[Index] = Center.Z;
+
+			// Triangles * Distance^2 above this is over MaxTrianglesPerPixel...Pixels of the bounds disc...
+			const float PixelRadiusAtOne = 0.5f * InSettings.StreamingScreenHeight * OutResult.DistanceScale * Instance.Radius;
+			DenseLimits[Index] = InSettings.LODAuditMaxTrianglesPerPixel * PI * FMath::Square(PixelRadiusAtOne);
+
+			for (int32 LODIndex = 1; LODIndex < MeshResult.NumLODs; ++LODIndex)
+			{
+				const float SwitchDistance = OutResult.DistanceScale * Instance.Radius / FMath::Max(MeshResult.ScreenSizes[LODIndex], KINDA_SMALL_NUMBER);
+				Thresholds[(LODIndex - 1) * NumPadded + Index] = FMath::Square(SwitchDistance);
+			}
+		}
+
+		// Per instance, no contention...Summed per mesh afterwards...
+		TArray<int32> LODUses, NumDense, NumVisible;
+		LODUses.AddZeroed(NumPadded * MAX_STATIC_MESH_LODS);
+		NumDense.AddZeroed(NumPadded);
+		NumVisible.AddZeroed(NumPadded);
+
+		const TArray<FVector>& Positions = OutResult.Positions;
+		const float ViewDistanceSquared = FMath::Square(InSettings.LODAuditViewDistance);
+		ParallelFor(NumGroups, [&](int32 Group)
+		{
+			const int32 Base = Group * 4;
+			const int32 LaneMask = (1 << FMath::Min(NumInstances - Base, 4)) - 1;
+			const VectorRegister CenterX = VectorLoad(&CentersX[Base]);
+			const VectorRegister CenterY = VectorLoad(&CentersY[Base]);
+			const VectorRegister CenterZ = VectorLoad(&CentersZ[Base]);
+			const VectorRegister ViewDistance2 = VectorSetFloat1(ViewDistanceSquared);
+			VectorRegister Nearest2 = VectorSetFloat1(MAX_flt);
+
+			MS_ALIGN(16) float Distances2[4] GCC_ALIGN(16);
+			MS_ALIGN(16) float LODs[4] GCC_ALIGN(16);
+			for (int32 Position = 0; Position < NumPositions; ++Position)
+			{
+				const VectorRegister DeltaX = VectorSubtract(CenterX, VectorSetFloat1(Positions[Position].X));
+				const VectorRegister DeltaY = VectorSubtract(CenterY, VectorSetFloat1(Positions[Position].Y));
+				const VectorRegister DeltaZ = VectorSubtract(CenterZ, VectorSetFloat1(Positions[Position].Z));
+				const VectorRegister Distance2 = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ)));
+				Nearest2 = VectorMin(Nearest2, Distance2);
+
+				const int32 VisibleMask = VectorMaskBits(VectorCompareGE(ViewDistance2, Distance2)) & LaneMask;
+				if (VisibleMask == 0)
+					continue;
+
+				// LOD is the number of switch distances passed...
+				VectorRegister LOD = VectorZero();
+				for (int32 Threshold = 0; Threshold < NumThresholds; ++Threshold)
+					LOD = VectorAdd(LOD, VectorBitwiseAnd(VectorCompareGT(Distance2, VectorLoad(&Thresholds[Threshold * NumPadded + Base])), VectorOne()));
+
+				VectorStoreAligned(Distance2, Distances2);
+				VectorStoreAligned(LOD, LODs);
+				for (int32 Lane = 0; Lane < 4; ++Lane)
+				{
+					if (!(VisibleMask & (1 << Lane)))
+						continue;
+
+					const int32 Index = Base + Lane;
+					const int32 LODIndex = (int32)LODs[Lane];
+					LODUses[Index * MAX_STATIC_MESH_LODS + LODIndex]++;
+					NumVisible[Index]++;
+					if (OutResult.Meshes[OutResult.Instances[Index].Mesh].NumTriangles[LODIndex] * Distances2[Lane] > DenseLimits[Index])
+						NumDense[Index]++;
+				}
+			}
+
+			VectorStoreAligned(Nearest2, Distances2);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				if (LaneMask & (1 << Lane))
+					OutResult.Instances[Base + Lane].NearestDistance = FMath::Sqrt(Distances2[Lane]);
+			}
+		});
+
+		for (int32 Index = 0; Index < NumInstances; ++Index)
+		{
+			FMeshResult& MeshResult = OutResult.Meshes[OutResult.Instances[Index].Mesh];
+			for (int32 LODIndex = 0; LODIndex < MAX_STATIC_MESH_LODS; ++LODIndex)
+				MeshResult.LODUses[LODIndex] += LODUses[Index * MAX_STATIC_MESH_LODS + LODIndex];
+			MeshResult.NumDense += NumDense[Index];
+			MeshResult.NumVisible += NumVisible[Index];
+		}
+	}
+
+	static bool IsHighLODUnused(const FMeshResult& InMesh, const FExporterHelper::FExportSettings& InSettings)
+	{
+		return InMesh.NumLODs > 1 && InMesh.NumVisible > 0 && InMesh.LODUses[0] < InSettings.LODAuditMinLODUsage * InMesh.NumVisible;
+	}
+
+	static bool IsLowLODLate(const FMeshResult& InMesh, const FExporterHelper::FExportSettings& InSettings)
+	{
+		return InMesh.NumVisible > 0 && InMesh.NumDense > InSettings.LODAuditMaxDenseShare * InMesh.NumVisible;
+	}
+
+	static void PrintLODAuditToCSVString(UWorld* InWorld, const FExporterHelper::FSceneDataSet& InSceneDataSet, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+		const double StartTime = FPlatformTime::Seconds();
+
+		FResult Result;
+		Audit(InWorld, InSceneDataSet, InOutContext.IndexPool, Settings, Result);
+		if (Result.Meshes.Num() == 0 || Result.Positions.Num() == 0)
+			return;
+
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+		int32 NumHighLODsUnused = 0;
+		int32 NumLowLODsLate = 0;
+
+		// LODScreenSizeAudit...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("NumInstances,"); ToCSVFile += TEXT("NumLODs,"); ToCSVFile += TEXT("NumVisible,");
+			for (int32 LODIndex = 0; LODIndex < Result.MaxLODs; ++LODIndex)
+				ToCSVFile += FString::Printf(TEXT("LOD%dUsage,"), LODIndex);
+			ToCSVFile += TEXT("DenseShare,"); ToCSVFile += TEXT("HighLODsUnused,"); ToCSVFile += TEXT("LowLODsLate,");
+			ToCSVFile += TEXT("AssetPath\n");
+			for (TArray<FMeshResult>::TConstIterator It(Result.Meshes); It; ++It)
+			{
+				const FMeshResult& MeshResult = (*It);
+				const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[MeshResult.MeshRow];
+				const double NumVisible = FMath::Max<double>(MeshResult.NumVisible, 1.0);
+				const bool bHighLODsUnused = IsHighLODUnused(MeshResult, Settings);
+				const bool bLowLODsLate = IsLowLODLate(MeshResult, Settings);
+
+				InOutContext.StringPool.AppendTo(ToCSVFile, StaticMesh.Name) += ",";
+				ToCSVFile += FString::FromInt(MeshResult.NumInstances) + ",";
+				ToCSVFile += FString::FromInt(MeshResult.NumLODs) + ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, MeshResult.NumVisible) += ",";
+				for (int32 LODIndex = 0; LODIndex < Result.MaxLODs; ++LODIndex)
+					FFloatFormatter::Append(ToCSVFile, (float)(MeshResult.LODUses[LODIndex] / NumVisible), Precisions.Default) += ",";
+				FFloatFormatter::Append(ToCSVFile, (float)(MeshResult.NumDense / NumVisible), Precisions.Default) += ",";
+				ToCSVFile += bHighLODsUnused ? TEXT("True,") : TEXT("False,");
+				ToCSVFile += bLowLODsLate ? TEXT("True,") : TEXT("False,");
+				InOutContext.StringPool.AppendTo(ToCSVFile, StaticMesh.AssetPath) += "\n";
+
+				NumHighLODsUnused += bHighLODsUnused ? 1 : 0;
+				NumLowLODsLate += bLowLODsLate ? 1 : 0;
+			}
+
+			OutCSVStrings.Add("LODScreenSizeAudit", ToCSVFile);
+		}
+
+		// LODSwitchDistances...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("BoundsIndex,"); ToCSVFile += TEXT("Radius,"); ToCSVFile += TEXT("NearestDistance,");
+			for (int32 LODIndex = 1; LODIndex < Result.MaxLODs; ++LODIndex)
+				ToCSVFile += FString::Printf(TEXT("LOD%dDistance,"), LODIndex);
+			ToCSVFile += TEXT("AssetPath\n");
+			for (TArray<FInstanceResult>::TConstIterator It(Result.Instances); It; ++It)
+			{
+				const FInstanceResult& Instance = (*It);
+				const FMeshResult& MeshResult = Result.Meshes[Instance.Mesh];
+				InOutContext.StringPool.AppendTo(ToCSVFile, Rows[MeshResult.MeshRow].Name) += ",";
+				ToCSVFile += FString::FromInt(Instance.BoundsIndex) + ",";
+				FFloatFormatter::Append(ToCSVFile, Instance.Radius, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Instance.NearestDistance, Precisions.Bounds) += ",";
+				// Empty past the last LOD of the mesh...
+				for (int32 LODIndex = 1; LODIndex < Result.MaxLODs; ++LODIndex)
+				{
+					if (LODIndex < MeshResult.NumLODs)
+						FFloatFormatter::Append(ToCSVFile, Result.DistanceScale * Instance.Radius / FMath::Max(MeshResult.ScreenSizes[LODIndex], KINDA_SMALL_NUMBER), Precisions.Bounds);
+					ToCSVFile += TEXT(",");
+				}
+				InOutContext.StringPool.AppendTo(ToCSVFile, Rows[MeshResult.MeshRow].AssetPath) += "\n";
+			}
+
+			OutCSVStrings.Add("LODSwitchDistances", ToCSVFile);
+		}
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[LOD Audit] %d meshes, %d instances against %d %s positions, %d with LOD0 almost never drawn, %d drawing over %.2f triangles per pixel too often, %.2f s."),
+			Result.Meshes.Num(), Result.Instances.Num(), Result.Positions.Num(), Result.bNavMesh ? TEXT("navmesh") : TEXT("grid"),
+			NumHighLODsUnused, NumLowLODsLate, Settings.LODAuditMaxTrianglesPerPixel, FPlatformTime::Seconds() - StartTime));
+	}
+};
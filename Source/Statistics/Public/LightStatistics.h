@@ -0,0 +1,359 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "Async/ParallelFor.h"
+#include "Components/LightComponent.h"
+#include "Components/LocalLightComponent.h"
+#include "Components/DirectionalLightComponent.h"
+#include "Engine/TextureLightProfile.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+/** Lights of the World and what they cost in deferred shading...
+ *  Shadow casters are found in the primitive octree of the scene, one query per light on all cores...
+ */
+class FLightStatistics
+{
+public:
+
+	struct FSceneLightDataSet
+	{
+	public:
+
+		FStringPool::FId Name;
+		FStringPool::FId OwnerName;
+		FStringPool::FId IESProfile;	// None without...
+		FStringPool::FId LightFunction; // None without...
+
+		const TCHAR* Type;
+		const TCHAR* Mobility;
+
+		FVector Position;
+		float   Radius; // Attenuation radius...0 for directional lights...
+		float   Intensity;
+		float   ShadowResolutionScale;
+		int32   MaxShadowResolution; // Shadow map size of the light filling the screen...Cube faces for point lights...
+		int32   NumCascades;		 // Directional lights...
+
+		// Overlap...Only dynamic lights, static lights are baked...
+		uint32 NumAffectedPrimitives;
+		uint32 NumShadowCasters;
+		uint64 NumShadowCasterTriangles;
+
+		uint8 bCastShadows : 1;
+		uint8 bCastDynamicShadows : 1;
+		uint8 bDynamic : 1; // Stationary or Movable...Lit per pixel every frame...
+		uint8 bDirectional : 1;
+
+		// Transient...Only valid during export...
+		const ULightComponent* Component;
+	};
+
+	/** Dynamic lights overlapping every XY cell...NumX * NumY counts, X fastest... */
+	struct FLightGrid
+	{
+		FVector2D Origin;
+		float	  CellSize;
+		int32	  NumX;
+		int32	  NumY;
+		TArray<int32> NumLights;
+	};
+
+	static void GatherLights(UWorld* InWorld, FStringPool& InOutStringPool, TArray<FSceneLightDataSet>& OutLights)
+	{
+		OutLights.Reset();
+
+		IConsoleVariable* MaxResolution = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Shadow.MaxResolution"));
+		IConsoleVariable* MaxCSMResolution = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Shadow.MaxCSMResolution"));
+		const FStringPool::FId NoneId = InOutStringPool.Add(FString(TEXT("None")));
+
+		for (TObjectIterator<ULightComponent> It; It; ++It)
+		{
+			const ULightComponent* LightComponent = *It;
+			if (LightComponent->GetWorld() != InWorld || !LightComponent->IsRegistered() || !LightComponent->IsVisible() || LightComponent->IsPendingKill())
+				continue;
+
+			FSceneLightDataSet& Light = OutLights[OutLights.AddZeroed()];
+			Light.Component = LightComponent;
+			Light.Name = InOutStringPool.Add(LightComponent->GetFName());
+			Light.OwnerName = LightComponent->GetOwner() ? InOutStringPool.Add(LightComponent->GetOwner()->GetFName()) : NoneId;
+			Light.IESProfile = LightComponent->IESTexture ? InOutStringPool.Add(LightComponent->IESTexture->GetFName()) : NoneId;
+			Light.LightFunction = LightComponent->LightFunctionMaterial ? InOutStringPool.Add(LightComponent->LightFunctionMaterial->GetFName()) : NoneId;
+
+			switch (LightComponent->GetLightType())
+			{
+			case LightType_Directional: Light.Type = TEXT("Directional"); break;
+			case LightType_Point:		Light.Type = TEXT("Point"); break;
+			case LightType_Spot:		Light.Type = TEXT("Spot"); break;
+			case LightType_Rect:		Light.Type = TEXT("Rect"); break;
+			default:					Light.Type = TEXT("Unknown"); break;
+			}
+			switch (LightComponent->Mobility)
+			{
+			case EComponentMobility::Static:	 Light.Mobility = TEXT("Static"); break;
+			case EComponentMobility::Stationary: Light.Mobility = TEXT("Stationary"); break;
+			default:							 Light.Mobility = TEXT("Movable"); break;
+			}
+
+			Light.Position = LightComponent->GetComponentLocation();
+			Light.Intensity = LightComponent->Intensity;
+			Light.ShadowResolutionScale = LightComponent->ShadowResolutionScale;
+			Light.bCastShadows = LightComponent->CastShadows;
+			Light.bCastDynamicShadows = LightComponent->CastShadows && LightComponent->CastDynamicShadows;
+			Light.bDynamic = LightComponent->Mobility != EComponentMobility::Static;
+			Light.bDirectional = LightComponent->GetLightType() == LightType_Directional;
+
+			if (const ULocalLightComponent* LocalLight = Cast<ULocalLightComponent>(LightComponent))
+				Light.Radius = LocalLight->AttenuationRadius;
+
+			IConsoleVariable* Resolution = Light.bDirectional ? MaxCSMResolution : MaxResolution;
+			const int32 MaxShadowResolution = Resolution ? Resolution->GetInt() : 2048;
+			Light.MaxShadowResolution = Light.bCastDynamicShadows ? FMath::Min(MaxShadowResolution, FMath::RoundToInt(MaxShadowResolution * Light.ShadowResolutionScale)) : 0;
+
+			if (const UDirectionalLightComponent* DirectionalLight = Cast<UDirectionalLightComponent>(LightComponent))
+				Light.NumCascades = Light.bCastDynamicShadows ? DirectionalLight->DynamicShadowCascades : 0;
+		}
+	}
+
+	/** Triangles of every gathered primitive, all instances...Primitives not in the tables have none... */
+	static void GetPrimitiveTriangles(const FExporterHelper::FSceneDataSet& InSceneDataSet, TMap<FPrimitiveComponentId, uint64>& OutTriangles)
+	{
+		OutTriangles.Reset();
+		for (TArray<FExporterHelper::FSceneStaticMeshDataSet>::TConstIterator It(InSceneDataSet.StaticMeshesTable); It; ++It)
+		{
+			if (const UPrimitiveComponent* Component = (*It).Component.Get())
+				OutTriangles.Add(Component->ComponentId, (uint64)(*It).NumTriangles * FMath::Max((*It).NumInstances, 1u));
+		}
+		for (TArray<FExporterHelper::FSceneSkeletalMeshDataSet>::TConstIterator It(InSceneDataSet.SkeletalMeshesTable); It; ++It)
+		{
+			if (const UPrimitiveComponent* Component = (*It).Component.Get())
+				OutTriangles.Add(Component->ComponentId, (*It).NumTriangles);
+		}
+	}
+
+	/** Primitives and shadow casters inside every dynamic light...Read only queries of the octree, the render thread must be idle...
+	 *  Stationary local lights only shadow movable primitives every frame, static ones are in their precomputed shadow maps...
+	 */
+	static void QueryLightOverlaps(const FScene* InScene, const TMap<FPrimitiveComponentId, uint64>& InTriangles, TArray<FSceneLightDataSet>& InOutLights)
+	{
+		const FScenePrimitiveOctree& Octree = InScene->PrimitiveOctree;
+
+		// Directional lights reach everything...The whole octree once for all of them...
+		uint32 NumScenePrimitives = 0;
+		uint32 NumSceneShadowCasters = 0;
+		uint64 NumSceneShadowCasterTriangles = 0;
+		if (InOutLights.ContainsByPredicate([](const FSceneLightDataSet& InLight) { return InLight.bDirectional && InLight.bDynamic; }))
+		{
+			for (FScenePrimitiveOctree::TConstIterator<> It(Octree); It.HasPendingNodes(); It.Advance())
+			{
+				const FScenePrimitiveOctree::FNode& Node = It.GetCurrentNode();
+				for (FScenePrimitiveOctree::ElementConstIt ElementIt(Node.GetElementIt()); ElementIt; ++ElementIt)
+				{
+					const FPrimitiveSceneInfoCompact& Primitive = *ElementIt;
+					NumScenePrimitives++;
+					if (Primitive.bCastDynamicShadow)
+					{
+						const uint64* Triangles = InTriangles.Find(Primitive.PrimitiveSceneInfo->PrimitiveComponentId);
+						NumSceneShadowCasters++;
+						NumSceneShadowCasterTriangles += Triangles ? *Triangles : 0;
+					}
+				}
+				FOREACH_OCTREE_CHILD_NODE(ChildRef)
+				{
+					if (Node.HasChild(ChildRef))
+						It.PushChild(ChildRef);
+				}
+			}
+		}
+
+		ParallelFor(InOutLights.Num(), [&](int32 LightIndex)
+		{
+			FSceneLightDataSet& Light = InOutLights[LightIndex];
+			if (!Light.bDynamic)
+				return;
+
+			if (Light.bDirectional)
+			{
+				Light.NumAffectedPrimitives = NumScenePrimitives;
+				Light.NumShadowCasters = Light.bCastDynamicShadows ? NumSceneShadowCasters : 0;
+				Light.NumShadowCasterTriangles = Light.bCastDynamicShadows ? NumSceneShadowCasterTriangles : 0;
+				return;
+			}
+
+			const bool bStationary = Light.Component->Mobility == EComponentMobility::Stationary;
+			const FSphere Sphere = Light.Component->GetBoundingSphere();
+			for (FScenePrimitiveOctree::TConstElementBoxIterator<> It(Octree, FBoxCenterAndExtent(Sphere.Center, FVector(Sphere.W))); It.HasPendingElements(); It.Advance())
+			{
+				const FPrimitiveSceneInfoCompact& Primitive = It.GetCurrentElement();
+				// Cone of spot lights, sphere of the others...
+				if (!Light.Component->AffectsBounds(Primitive.Bounds))
+					continue;
+
+				Light.NumAffectedPrimitives++;
+				if (Light.bCastDynamicShadows && Primitive.bCastDynamicShadow && (!bStationary || Primitive.Proxy->IsMovable()))
+				{
+					const uint64* Triangles = InTriangles.Find(Primitive.PrimitiveSceneInfo->PrimitiveComponentId);
+					Light.NumShadowCasters++;
+					Light.NumShadowCasterTriangles += Triangles ? *Triangles : 0;
+				}
+			}
+		});
+	}
+
+	/** XY footprint of the dynamic local lights...Directional lights are in every cell and not counted... */
+	static void BuildLightGrid(const TArray<FSceneLightDataSet>& InLights, float InCellSize, int32 InMaxCells, FLightGrid& OutGrid)
+	{
+		OutGrid.NumX = OutGrid.NumY = 0;
+		OutGrid.NumLights.Reset();
+
+		TArray<FSphere> Spheres;
+		FBox2D Extent(ForceInit);
+		for (TArray<FSceneLightDataSet>::TConstIterator It(InLights); It; ++It)
+		{
+			if (!(*It).bDynamic || (*It).bDirectional)
+				continue;
+			const FSphere Sphere = (*It).Component->GetBoundingSphere();
+			Spheres.Add(Sphere);
+			Extent += FVector2D(Sphere.Center.X - Sphere.W, Sphere.Center.Y - Sphere.W);
+			Extent += FVector2D(Sphere.Center.X + Sphere.W, Sphere.Center.Y + Sphere.W);
+		}
+		if (Spheres.Num() == 0)
+			return;
+
+		// Coarser cells until the grid fits...
+		OutGrid.CellSize = InCellSize;
+		const FVector2D Size = Extent.GetSize();
+		while ((int64)(FMath::FloorToInt(Size.X / OutGrid.CellSize) + 1) * (FMath::FloorToInt(Size.Y / OutGrid.CellSize) + 1) > InMaxCells)
+			OutGrid.CellSize *= 2.f;
+
+		OutGrid.Origin = Extent.Min;
+		OutGrid.NumX = FMath::FloorToInt(Size.X / OutGrid.CellSize) + 1;
+		OutGrid.NumY = FMath::FloorToInt(Size.Y / OutGrid.CellSize) + 1;
+		OutGrid.NumLights.AddZeroed(OutGrid.NumX * OutGrid.NumY);
+
+		// Lights write to shared cells...
+		ParallelFor(Spheres.Num(), [&Spheres, &OutGrid](int32 SphereIndex)
+		{
+			const FSphere& Sphere = Spheres[SphereIndex];
+			const float CellSize = OutGrid.CellSize;
+			const int32 MinX = FMath::Clamp(FMath::FloorToInt((Sphere.Center.X - Sphere.W - OutGrid.Origin.X) / CellSize), 0, OutGrid.NumX - 1);
+			const int32 MaxX = FMath::Clamp(FMath::FloorToInt((Sphere.Center.X + Sphere.W - OutGrid.Origin.X) / CellSize), 0, OutGrid.NumX - 1);
+			const int32 MinY = FMath::Clamp(FMath::FloorToInt((Sphere.Center.Y - Sphere.W - OutGrid.Origin.Y) / CellSize), 0, OutGrid.NumY - 1);
+			const int32 MaxY = FMath::Clamp(FMath::FloorToInt((Sphere.Center.Y + Sphere.W - OutGrid.Origin.Y) / CellSize), 0, OutGrid.NumY - 1);
+			for (int32 Y = MinY; Y <= MaxY; ++Y)
+			{
+				for (int32 X = MinX; X <= MaxX; ++X)
+				{
+					// Circle against cell rectangle...
+					const FVector2D CellMin(OutGrid.Origin.X + X * CellSize, OutGrid.Origin.Y + Y * CellSize);
+					const float DX = FMath::Max3(CellMin.X - Sphere.Center.X, 0.f, Sphere.Center.X - (CellMin.X + CellSize));
+					const float DY = FMath::Max3(CellMin.Y - Sphere.Center.Y, 0.f, Sphere.Center.Y - (CellMin.Y + CellSize));
+					if (DX * DX + DY * DY <= Sphere.W * Sphere.W)
+						FPlatformAtomics::InterlockedIncrement(&OutGrid.NumLights[Y * OutGrid.NumX + X]);
+				}
+			}
+		});
+	}
+
+	static void PrintLightsToCSVString(UWorld* InWorld, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		if (!InWorld || !InWorld->Scene || !InOutContext.WorldSceneDataSets.IsValidIndex(0))
+			return;
+
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+
+		TArray<FSceneLightDataSet> Lights;
+		GatherLights(InWorld, InOutContext.StringPool, Lights);
+		if (Lights.Num() == 0)
+			return;
+
+		TMap<FPrimitiveComponentId, uint64> Triangles;
+		GetPrimitiveTriangles(InOutContext.WorldSceneDataSets[0], Triangles);
+
+		// The octree belongs to the render thread...Nothing is enqueued until the queries are done...
+		FlushRenderingCommands();
+		QueryLightOverlaps((const FScene*)InWorld->Scene, Triangles, Lights);
+
+		FLightGrid Grid;
+		BuildLightGrid(Lights, Settings.LightGridCellSize, Settings.LightGridMaxCells, Grid);
+
+		// LightsTable...
+		int32 NumDynamic = 0;
+		uint64 NumShadowCasterTriangles = 0;
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("Owner,");
+			ToCSVFile += TEXT("Type,"); ToCSVFile += TEXT("Mobility,");
+			ToCSVFile += TEXT("X,"); ToCSVFile += TEXT("Y,"); ToCSVFile += TEXT("Z,");
+			ToCSVFile += TEXT("Radius,"); ToCSVFile += TEXT("Intensity,");
+			ToCSVFile += TEXT("CastShadows,"); ToCSVFile += TEXT("CastDynamicShadows,");
+			ToCSVFile += TEXT("IESProfile,"); ToCSVFile += TEXT("LightFunction,");
+			ToCSVFile += TEXT("ShadowResolutionScale,"); ToCSVFile += TEXT("MaxShadowResolution,"); ToCSVFile += TEXT("NumCascades,");
+			ToCSVFile += TEXT("NumAffectedPrimitives,"); ToCSVFile += TEXT("NumShadowCasters,"); ToCSVFile += TEXT("NumShadowCasterTriangles\n");
+			for (int32 i = 0; i < Lights.Num(); ++i)
+			{
+				const FSceneLightDataSet& Light = Lights[i];
+				ToCSVFile += FString::FromInt(i) + ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, Light.Name) += ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, Light.OwnerName) += ",";
+				ToCSVFile += FString(Light.Type) + ",";
+				ToCSVFile += FString(Light.Mobility) + ",";
+				FFloatFormatter::Append(ToCSVFile, Light.Position.X, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Light.Position.Y, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Light.Position.Z, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Light.Radius, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Light.Intensity, Precisions.Default) += ",";
+				ToCSVFile += FString(Light.bCastShadows ? TEXT("True") : TEXT("False")) + ",";
+				ToCSVFile += FString(Light.bCastDynamicShadows ? TEXT("True") : TEXT("False")) + ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, Light.IESProfile) += ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, Light.LightFunction) += ",";
+				FFloatFormatter::Append(ToCSVFile, Light.ShadowResolutionScale, Precisions.Default) += ",";
+				ToCSVFile += FString::FromInt(Light.MaxShadowResolution) + ",";
+				ToCSVFile += FString::FromInt(Light.NumCascades) + ",";
+				ToCSVFile += FString::FromInt(Light.NumAffectedPrimitives) + ",";
+				ToCSVFile += FString::FromInt(Light.NumShadowCasters) + ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Light.NumShadowCasterTriangles) += "\n";
+
+				NumDynamic += Light.bDynamic ? 1 : 0;
+				NumShadowCasterTriangles += Light.NumShadowCasterTriangles;
+			}
+
+			OutCSVStrings.Add("LightsTable", ToCSVFile);
+		}
+
+		// LightOverlapGrid...Only cells with lights...
+		int32 MaxOverlap = 0;
+		if (Grid.NumLights.Num() > 0)
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("CellX,"); ToCSVFile += TEXT("CellY,");
+			ToCSVFile += TEXT("MinX,"); ToCSVFile += TEXT("MinY,"); ToCSVFile += TEXT("CellSize,");
+			ToCSVFile += TEXT("NumDynamicLights\n");
+			for (int32 Y = 0; Y < Grid.NumY; ++Y)
+			{
+				for (int32 X = 0; X < Grid.NumX; ++X)
+				{
+					const int32 NumLights = Grid.NumLights[Y * Grid.NumX + X];
+					if (NumLights == 0) continue;
+
+					ToCSVFile += FString::FromInt(X) + ",";
+					ToCSVFile += FString::FromInt(Y) + ",";
+					FFloatFormatter::Append(ToCSVFile, Grid.Origin.X + X * Grid.CellSize, Precisions.Bounds) += ",";
+					FFloatFormatter::Append(ToCSVFile, Grid.Origin.Y + Y * Grid.CellSize, Precisions.Bounds) += ",";
+					FFloatFormatter::Append(ToCSVFile, Grid.CellSize, Precisions.Bounds) += ",";
+					ToCSVFile += FString::FromInt(NumLights) + "\n";
+
+					MaxOverlap = FMath::Max(MaxOverlap, NumLights);
+				}
+			}
+
+			OutCSVStrings.Add("LightOverlapGrid", ToCSVFile);
+		}
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[Lights] %d lights, %d dynamic, up to %d dynamic lights over one %.0f cell, %llu shadow caster triangles."),
+			Lights.Num(), NumDynamic, MaxOverlap, Grid.NumLights.Num() > 0 ? Grid.CellSize : Settings.LightGridCellSize, NumShadowCasterTriangles));
+	}
+};
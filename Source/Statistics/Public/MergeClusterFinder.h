@@ -0,0 +1,380 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+/** Small static primitives with the same materials close to each other...Candidates for a merged mesh or a HLOD cluster...
+ *
+ *  Candidates are bucketed by material list, every bucket gets an implicit k-d tree over its bounds centers...
+ *  Buckets are built and clustered in parallel, large buckets also split their top levels in parallel...
+ *  A cluster is every unassigned candidate within MergeRadius of a seed, seeds in tree order...
+ *  Merging keeps the triangles, slots of the same material become one section of the merged mesh...Baking an HLOD proxy is not simulated...
+ */
+class FMergeClusterFinder
+{
+public:
+
+	/** Material list of a candidate...Compared by content, not by span... */
+	struct FBucketKey
+	{
+		TArrayView<const int32> Materials;
+		TArrayView<const int32> MaterialInstances;
+
+		bool operator==(const FBucketKey& InOther) const
+		{
+			return Materials.Num() == InOther.Materials.Num() && MaterialInstances.Num() == InOther.MaterialInstances.Num()
+				&& FMemory::Memcmp(Materials.GetData(), InOther.Materials.GetData(), Materials.Num() * sizeof(int32)) == 0
+				&& FMemory::Memcmp(MaterialInstances.GetData(), InOther.MaterialInstances.GetData(), MaterialInstances.Num() * sizeof(int32)) == 0;
+		}
+
+		friend uint32 GetTypeHash(const FBucketKey& InKey)
+		{
+			const uint32 Hash = FCrc::MemCrc32(InKey.Materials.GetData(), InKey.Materials.Num() * sizeof(int32));
+			return FCrc::MemCrc32(InKey.MaterialInstances.GetData(), InKey.MaterialInstances.Num() * sizeof(int32), Hash);
+		}
+
+		/** Sections of the merged mesh, a material in several slots is one... */
+		int32 CountUniqueMaterials() const
+		{
+			TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<16>> Unique;
+			for (int32 Material : Materials)
+				Unique.Add(Material);
+			int32 NumUnique = Unique.Num();
+			Unique.Reset();
+			for (int32 MaterialInstance : MaterialInstances)
+				Unique.Add(MaterialInstance);
+			return NumUnique + Unique.Num();
+		}
+	};
+
+	struct FCluster
+	{
+		int32 FirstMember; // See FResult::Members...
+		int32 NumMembers;
+		int32 NumUniqueMeshes;
+		int64 NumMaterialSlots;	  // Summed over the members...
+		int32 NumUniqueMaterials; // Of the merged mesh...
+		FVector Center; // Seed...
+		float Radius;	// Farthest member center...
+		int64 DrawCallsBefore;
+		int64 DrawCallsAfter;
+		uint64 NumTriangles;
+	};
+
+	struct FResult
+	{
+		TArray<FCluster> Clusters; // Most draw calls saved first...
+		TArray<int32> Members;	   // Rows of StaticMeshesTable...
+		int32 NumCandidates;
+		int32 NumBuckets;
+		double BuildSeconds;
+		double ClusterSeconds;
+	};
+
+	static void FindClusters(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FIndexPool& InIndexPool, const FExporterHelper::FExportSettings& InSettings, FResult& OutResult)
+	{
+		OutResult.Clusters.Reset();
+		OutResult.Members.Reset();
+		OutResult.NumCandidates = OutResult.NumBuckets = 0;
+		OutResult.BuildSeconds = OutResult.ClusterSeconds = 0.0;
+
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Candidates and their material buckets...
+		TArray<int32> CandidateRows;
+		TArray<int32> CandidateBuckets;
+		TArray<FVector> Centers;
+		TMap<FBucketKey, int32> BucketIndices;
+		TArray<int32> BucketUniqueMaterials;
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+		{
+			const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[Row];
+			const UPrimitiveComponent* Component = StaticMesh.Component.Get();
+			if (StaticMesh.NumInstances > 0 || !Component || Cast<UInstancedStaticMeshComponent>(Component) || Component->Mobility != EComponentMobility::Static)
+				continue;
+
+			const FBoxSphereBounds& Bounds = InSceneDataSet.BoundsTable[InIndexPool[StaticMesh.BoundsIndices][0]];
+			if (Bounds.SphereRadius > InSettings.MergeMaxPrimitiveRadius)
+				continue;
+
+			FBucketKey Key;
+			Key.Materials = InIndexPool[StaticMesh.UsedMaterialsIndices];
+			Key.MaterialInstances = InIndexPool[StaticMesh.UsedMaterialIntancesIndices];
+			const int32* BucketIndex = BucketIndices.Find(Key);
+			if (!BucketIndex)
+			{
+				BucketIndex = &BucketIndices.Add(Key, BucketIndices.Num());
+				BucketUniqueMaterials.Add(Key.CountUniqueMaterials());
+			}
+
+			CandidateRows.Add(Row);
+			CandidateBuckets.Add(*BucketIndex);
+			Centers.Add(Bounds.Origin);
+		}
+
+		const int32 NumCandidates = CandidateRows.Num();
+		const int32 NumBuckets = BucketIndices.Num();
+		OutResult.NumCandidates = NumCandidates;
+		OutResult.NumBuckets = NumBuckets;
+		if (NumCandidates < InSettings.MergeMinClusterSize)
+			return;
+
+		// Counting sort by bucket...Every bucket is one range of Order...
+		TArray<int32> BucketStarts;
+		BucketStarts.AddZeroed(NumBuckets + 1);
+		for (int32 Bucket : CandidateBuckets)
+			BucketStarts[Bucket + 1]++;
+		for (int32 i = 0; i < NumBuckets; ++i)
+			BucketStarts[i + 1] += BucketStarts[i];
+
+		TArray<int32> Order;
+		Order.SetNumUninitialized(NumCandidates);
+		{
+			TArray<int32> WriteOffsets = BucketStarts;
+			for (int32 Candidate = 0; Candidate < NumCandidates; ++Candidate)
+				Order[WriteOffsets[CandidateBuckets[Candidate]]++] = Candidate;
+		}
+
+		ParallelFor(NumBuckets, [&Order, &Centers, &BucketStarts](int32 Bucket)
+		{
+			BuildTree(Order.GetData(), Centers, BucketStarts[Bucket], BucketStarts[Bucket + 1], 0);
+		});
+
+		const double BuildTime = FPlatformTime::Seconds();
+		OutResult.BuildSeconds = BuildTime - StartTime;
+
+		// Buckets never share candidates, every one clusters on its own...
+		TArray<TArray<FCluster>> BucketClusters;
+		TArray<TArray<int32>> BucketMembers;
+		BucketClusters.SetNum(NumBuckets);
+		BucketMembers.SetNum(NumBuckets);
+		TArray<uint8> Assigned;
+		Assigned.AddZeroed(NumCandidates);
+
+		const float RadiusSquared = FMath::Square(InSettings.MergeRadius);
+		ParallelFor(NumBuckets, [&](int32 Bucket)
+		{
+			const int32 Begin = BucketStarts[Bucket];
+			const int32 End = BucketStarts[Bucket + 1];
+			if (End - Begin < InSettings.MergeMinClusterSize)
+				return;
+
+			TArray<int32> Found;
+			TSet<uint32> UniqueMeshes;
+			for (int32 i = Begin; i < End; ++i)
+			{
+				const int32 Seed = Order[i];
+				if (Assigned[Seed])
+					continue;
+
+				Found.Reset();
+				QueryTree(Order.GetData(), Centers, Assigned, Begin, End, 0, Centers[Seed], RadiusSquared, Found);
+				if (Found.Num() < InSettings.MergeMinClusterSize)
+					continue;
+
+				FCluster& Cluster = BucketClusters[Bucket][BucketClusters[Bucket].AddZeroed()];
+				Cluster.FirstMember = BucketMembers[Bucket].Num();
+				Cluster.NumMembers = Found.Num();
+				Cluster.Center = Centers[Seed];
+
+				UniqueMeshes.Reset();
+				for (int32 Candidate : Found)
+				{
+					Assigned[Candidate] = 1;
+					const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[CandidateRows[Candidate]];
+					BucketMembers[Bucket].Add(CandidateRows[Candidate]);
+					UniqueMeshes.Add(StaticMesh.UniqueId);
+					Cluster.Radius = FMath::Max(Cluster.Radius, FVector::Dist(Centers[Candidate], Cluster.Center));
+					Cluster.NumTriangles += StaticMesh.NumTriangles;
+				}
+
+				// Same materials in the whole bucket...
+				const FExporterHelper::FSceneStaticMeshDataSet& SeedMesh = Rows[CandidateRows[Seed]];
+				const int32 NumSlots = SeedMesh.UsedMaterialsIndices.Num() + SeedMesh.UsedMaterialIntancesIndices.Num();
+				Cluster.NumUniqueMeshes = UniqueMeshes.Num();
+				Cluster.NumMaterialSlots = (int64)NumSlots * Found.Num();
+				Cluster.NumUniqueMaterials = BucketUniqueMaterials[Bucket];
+				Cluster.DrawCallsBefore = (int64)FMath::Max(NumSlots, 1) * Found.Num();
+				Cluster.DrawCallsAfter = FMath::Max(Cluster.NumUniqueMaterials, 1);
+			}
+		});
+
+		for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+		{
+			const int32 MemberOffset = OutResult.Members.Num();
+			OutResult.Members.Append(BucketMembers[Bucket]);
+			for (FCluster& Cluster : BucketClusters[Bucket])
+			{
+				Cluster.FirstMember += MemberOffset;
+				OutResult.Clusters.Add(Cluster);
+			}
+		}
+		OutResult.Clusters.Sort([](const FCluster& A, const FCluster& B)
+		{
+			return (A.DrawCallsBefore - A.DrawCallsAfter) > (B.DrawCallsBefore - B.DrawCallsAfter);
+		});
+
+		OutResult.ClusterSeconds = FPlatformTime::Seconds() - BuildTime;
+	}
+
+	static void PrintMergeClustersToCSVString(const FExporterHelper::FSceneDataSet& InSceneDataSet, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+
+		FResult Result;
+		FindClusters(InSceneDataSet, InOutContext.IndexPool, Settings, Result);
+		if (Result.Clusters.Num() == 0)
+			return;
+
+		int64 NumDrawCallsSaved = 0;
+		int32 NumMerged = 0;
+
+		// MergeClusters...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("NumPrimitives,"); ToCSVFile += TEXT("NumUniqueMeshes,");
+			ToCSVFile += TEXT("CenterX,"); ToCSVFile += TEXT("CenterY,"); ToCSVFile += TEXT("CenterZ,"); ToCSVFile += TEXT("Radius,");
+			ToCSVFile += TEXT("DrawCallsBefore,"); ToCSVFile += TEXT("DrawCallsAfter,");
+			ToCSVFile += TEXT("NumTriangles,"); ToCSVFile += TEXT("NumMaterialSlots,"); ToCSVFile += TEXT("NumUniqueMaterials\n");
+			for (int32 i = 0; i < Result.Clusters.Num(); ++i)
+			{
+				const FCluster& Cluster = Result.Clusters[i];
+				ToCSVFile += FString::FromInt(i) + ",";
+				ToCSVFile += FString::FromInt(Cluster.NumMembers) + ",";
+				ToCSVFile += FString::FromInt(Cluster.NumUniqueMeshes) + ",";
+				FFloatFormatter::Append(ToCSVFile, Cluster.Center.X, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Cluster.Center.Y, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Cluster.Center.Z, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Cluster.Radius, Precisions.Bounds) += ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Cluster.DrawCallsBefore) += ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Cluster.DrawCallsAfter) += ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Cluster.NumTriangles) += ",";
+				FFloatFormatter::AppendInteger(ToCSVFile, Cluster.NumMaterialSlots) += ",";
+				ToCSVFile += FString::FromInt(Cluster.NumUniqueMaterials) + "\n";
+
+				NumDrawCallsSaved += Cluster.DrawCallsBefore - Cluster.DrawCallsAfter;
+				NumMerged += Cluster.NumMembers;
+			}
+
+			OutCSVStrings.Add("MergeClusters", ToCSVFile);
+		}
+
+		// MergeClusterMembers...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("ClusterId,"); ToCSVFile += TEXT("StaticMeshId,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("Owner\n");
+			for (int32 i = 0; i < Result.Clusters.Num(); ++i)
+			{
+				const FCluster& Cluster = Result.Clusters[i];
+				for (int32 Member = Cluster.FirstMember; Member < Cluster.FirstMember + Cluster.NumMembers; ++Member)
+				{
+					const int32 Row = Result.Members[Member];
+					ToCSVFile += FString::FromInt(i) + ",";
+					ToCSVFile += FString::FromInt(Row) + ",";
+					InOutContext.StringPool.AppendTo(ToCSVFile, Rows[Row].Name) += ",";
+					InOutContext.StringPool.AppendTo(ToCSVFile, Rows[Row].OwnerName) += "\n";
+				}
+			}
+
+			OutCSVStrings.Add("MergeClusterMembers", ToCSVFile);
+		}
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[Mesh Merge] %d clusters of %d primitives (%d candidates in %d material lists), about %lld draw calls saved, tree %.1f ms, clustering %.1f ms."),
+			Result.Clusters.Num(), NumMerged, Result.NumCandidates, Result.NumBuckets, NumDrawCallsSaved, Result.BuildSeconds * 1000.0, Result.ClusterSeconds * 1000.0));
+	}
+
+private:
+
+	// Ranges above this size build their halves in parallel...
+	static const int32 ParallelBuildSize = 16 * 1024;
+
+	/** Median of [InBegin, InEnd) on the axis of the depth in the middle, smaller left, larger right...Recursive... */
+	static void BuildTree(int32* InOutOrder, const TArray<FVector>& InCenters, int32 InBegin, int32 InEnd, int32 InDepth)
+	{
+		if (InEnd - InBegin <= 1)
+			return;
+
+		const int32 Axis = InDepth % 3;
+		const int32 Middle = InBegin + (InEnd - InBegin) / 2;
+		SelectNth(InOutOrder, InCenters, InBegin, InEnd, Middle, Axis);
+
+		if (InEnd - InBegin >= ParallelBuildSize)
+		{
+			ParallelFor(2, [InOutOrder, &InCenters, InBegin, InEnd, Middle, InDepth](int32 Half)
+			{
+				if (Half == 0)
+					BuildTree(InOutOrder, InCenters, InBegin, Middle, InDepth + 1);
+				else
+					BuildTree(InOutOrder, InCenters, Middle + 1, InEnd, InDepth + 1);
+			});
+		}
+		else
+		{
+			BuildTree(InOutOrder, InCenters, InBegin, Middle, InDepth + 1);
+			BuildTree(InOutOrder, InCenters, Middle + 1, InEnd, InDepth + 1);
+		}
+	}
+
+	/** Quickselect...Element InNth ends in place, no larger one before it, no smaller one after it... */
+	static void SelectNth(int32* InOutOrder, const TArray<FVector>& InCenters, int32 InBegin, int32 InEnd, int32 InNth, int32 InAxis)
+	{
+		int32 Left = InBegin;
+		int32 Right = InEnd - 1;
+		while (Left < Right)
+		{
+			const float Pivot = InCenters[InOutOrder[Left + (Right - Left) / 2]][InAxis];
+			int32 i = Left;
+			int32 j = Right;
+			while (i <= j)
+			{
+				while (InCenters[InOutOrder[i]][InAxis] < Pivot) ++i;
+				while (Pivot < InCenters[InOutOrder[j]][InAxis]) --j;
+				if (i <= j)
+					Swap(InOutOrder[i++], InOutOrder[j--]);
+			}
+			if (InNth <= j)
+				Right = j;
+			else if (InNth >= i)
+				Left = i;
+			else
+				break;
+		}
+	}
+
+	/** Unassigned candidates of [InBegin, InEnd) within the radius... */
+	static void QueryTree(const int32* InOrder, const TArray<FVector>& InCenters, const TArray<uint8>& InAssigned, int32 InBegin, int32 InEnd, int32 InDepth, const FVector& InCenter, float InRadiusSquared, TArray<int32>& OutFound)
+	{
+		while (InEnd > InBegin)
+		{
+			const int32 Axis = InDepth % 3;
+			const int32 Middle = InBegin + (InEnd - InBegin) / 2;
+			const int32 Candidate = InOrder[Middle];
+			const FVector& Point = InCenters[Candidate];
+			if (!InAssigned[Candidate] && FVector::DistSquared(Point, InCenter) <= InRadiusSquared)
+				OutFound.Add(Candidate);
+
+			const float Delta = InCenter[Axis] - Point[Axis];
+			const bool bBothSides = Delta * Delta <= InRadiusSquared;
+			// Far side by recursion, near side in the loop...
+			if (Delta < 0.f)
+			{
+				if (bBothSides)
+					QueryTree(InOrder, InCenters, InAssigned, Middle + 1, InEnd, InDepth + 1, InCenter, InRadiusSquared, OutFound);
+				InEnd = Middle;
+			}
+			else
+			{
+				if (bBothSides)
+					QueryTree(InOrder, InCenters, InAssigned, InBegin, Middle, InDepth + 1, InCenter, InRadiusSquared, OutFound);
+				InBegin = Middle + 1;
+			}
+			InDepth++;
+		}
+	}
+};
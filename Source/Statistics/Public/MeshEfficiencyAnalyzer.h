@@ -0,0 +1,212 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+/** Rasterization cost of every LOD of the static meshes of the scene, beyond the triangle count...
+ *
+ *  ACMR/ATVR: vertices transformed per triangle and per used vertex, with a FIFO post transform cache of VertexCacheSize...
+ *  Areas    : object space, four triangles per SIMD register...
+ *  Sub-pixel: triangles facing the camera below one pixel at the screen size the LOD switches in at, its largest on screen...
+ *  Every (mesh, LOD) pair is one parallel task, every mesh asset is done once...
+ */
+class FMeshEfficiencyAnalyzer
+{
+public:
+
+	struct FLODMetrics
+	{
+		int32 MeshRow; // First row of the mesh in StaticMeshesTable...
+		int32 LODIndex;
+		uint32 NumTriangles;
+		uint32 NumVertices;
+		float ScreenSize;
+		float ACMR;
+		float ATVR;
+		float AverageTriangleArea;
+		float SubPixelShare;
+	};
+
+	/** Index and position buffers are kept on the CPU in the editor... */
+	static void AnalyzeLOD(const FStaticMeshLODResources& InLOD, int32 InCacheSize, float InPixelsPerUnit, FLODMetrics& OutMetrics)
+	{
+		const FIndexArrayView Indices = InLOD.IndexBuffer.GetArrayView();
+		const FPositionVertexBuffer& Positions = InLOD.VertexBuffers.PositionVertexBuffer;
+		const uint32 NumVertices = Positions.GetNumVertices();
+		const int32 NumTriangles = Indices.Num() / 3;
+
+		OutMetrics.NumTriangles = NumTriangles;
+		OutMetrics.NumVertices = NumVertices;
+		OutMetrics.ACMR = OutMetrics.ATVR = OutMetrics.AverageTriangleArea = OutMetrics.SubPixelShare = 0.f;
+		if (NumTriangles == 0 || NumVertices == 0)
+			return;
+
+		// A vertex stays cached until CacheSize other vertices were loaded after it...
+		TArray<uint32> LoadedAt;
+		LoadedAt.Init(MAX_uint32, NumVertices);
+		uint32 NumMisses = 0;
+		uint32 NumUsedVertices = 0;
+		for (int32 i = 0; i < NumTriangles * 3; ++i)
+		{
+			const uint32 Vertex = Indices[i];
+			if (Vertex >= NumVertices)
+				continue;
+
+			uint32& Stamp = LoadedAt[Vertex];
+			if (Stamp == MAX_uint32)
+				NumUsedVertices++;
+			else if (NumMisses - Stamp <= (uint32)InCacheSize)
+				continue;
+			Stamp = NumMisses++;
+		}
+
+		// Below a pixel while twice the area is below 2 / PixelsPerUnit squared...Compared squared, no square root...
+		const float SubPixelThreshold = FMath::Square(2.f / FMath::Max(FMath::Square(InPixelsPerUnit), SMALL_NUMBER));
+		const VectorRegister SubPixelThresholdVec = VectorSetFloat1(SubPixelThreshold);
+
+		MS_ALIGN(16) float Coords[9][4] GCC_ALIGN(16);
+		MS_ALIGN(16) float CrossLengths[4] GCC_ALIGN(16);
+		double SumAreas = 0.0;
+		int32 NumSubPixel = 0;
+		for (int32 First = 0; First < NumTriangles; First += 4)
+		{
+			// Transposed to XXXX YYYY ZZZZ per corner...Missing lanes are degenerate and masked out...
+			const int32 NumLanes = FMath::Min(NumTriangles - First, 4);
+			FMemory::Memzero(Coords, sizeof(Coords));
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				for (int32 Corner = 0; Corner < 3; ++Corner)
+				{
+					const uint32 Vertex = Indices[(First + Lane) * 3 + Corner];
+					if (Vertex >= NumVertices)
+						continue;
+
+					const FVector& Position = Positions.VertexPosition(Vertex);
+					Coords[Corner * 3 + 0][Lane] = Position.X;
+					Coords[Corner * 3 + 1][Lane] = Position.Y;
+					Coords[Corner * 3 + 2][Lane] = Position.Z;
+				}
+			}
+
+			const VectorRegister X0 = VectorLoadAligned(Coords[0]), Y0 = VectorLoadAligned(Coords[1]), Z0 = VectorLoadAligned(Coords[2]);
+			const VectorRegister E1X = VectorSubtract(VectorLoadAligned(Coords[3]), X0);
+			const VectorRegister E1Y = VectorSubtract(VectorLoadAligned(Coords[4]), Y0);
+			const VectorRegister E1Z = VectorSubtract(VectorLoadAligned(Coords[5]), Z0);
+			const VectorRegister E2X = VectorSubtract(VectorLoadAligned(Coords[6]), X0);
+			const VectorRegister E2Y = VectorSubtract(VectorLoadAligned(Coords[7]), Y0);
+			const VectorRegister E2Z = VectorSubtract(VectorLoadAligned(Coords[8]), Z0);
+
+			const VectorRegister CrossX = VectorSubtract(VectorMultiply(E1Y, E2Z), VectorMultiply(E1Z, E2Y));
+			const VectorRegister CrossY = VectorSubtract(VectorMultiply(E1Z, E2X), VectorMultiply(E1X, E2Z));
+			const VectorRegister CrossZ = VectorSubtract(VectorMultiply(E1X, E2Y), VectorMultiply(E1Y, E2X));
+			const VectorRegister CrossLength2 = VectorMultiplyAdd(CrossX, CrossX, VectorMultiplyAdd(CrossY, CrossY, VectorMultiply(CrossZ, CrossZ)));
+
+			NumSubPixel += FPlatformMath::CountBits((uint64)(VectorMaskBits(VectorCompareLT(CrossLength2, SubPixelThresholdVec)) & ((1 << NumLanes) - 1)));
+
+			VectorStoreAligned(CrossLength2, CrossLengths);
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				SumAreas += 0.5f * FMath::Sqrt(CrossLengths[Lane]);
+		}
+
+		OutMetrics.ACMR = (float)NumMisses / NumTriangles;
+		OutMetrics.ATVR = NumUsedVertices > 0 ? (float)NumMisses / NumUsedVertices : 0.f;
+		OutMetrics.AverageTriangleArea = (float)(SumAreas / NumTriangles);
+		OutMetrics.SubPixelShare = (float)NumSubPixel / NumTriangles;
+	}
+
+	/** Threshold of the LOD itself, drawn from there down to the threshold of the next one...Same as the switch distances of FLODScreenSizeAudit... */
+	static float GetSwitchScreenSize(const UStaticMesh* InStaticMesh, int32 InLODIndex)
+	{
+		return InStaticMesh->RenderData->ScreenSize[FMath::Min(InLODIndex, MAX_STATIC_MESH_LODS - 1)].Default;
+	}
+
+	static void AnalyzeMeshes(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FExporterHelper::FExportSettings& InSettings, TArray<FLODMetrics>& OutMetrics, int32& OutNumMeshes)
+	{
+		OutMetrics.Reset();
+		OutNumMeshes = 0;
+
+		// One task per LOD of every mesh asset...
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+		TArray<const UStaticMesh*> TaskMeshes;
+		TSet<uint32> VisitedMeshes;
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+		{
+			const UStaticMeshComponent* Component = Cast<UStaticMeshComponent>(Rows[Row].Component.Get());
+			const UStaticMesh* StaticMesh = Component ? Component->GetStaticMesh() : nullptr;
+			if (!StaticMesh || !StaticMesh->RenderData || VisitedMeshes.Contains(Rows[Row].UniqueId))
+				continue;
+
+			VisitedMeshes.Add(Rows[Row].UniqueId);
+			OutNumMeshes++;
+			for (int32 LODIndex = 0; LODIndex < StaticMesh->RenderData->LODResources.Num(); ++LODIndex)
+			{
+				FLODMetrics& Metrics = OutMetrics[OutMetrics.AddZeroed()];
+				Metrics.MeshRow = Row;
+				Metrics.LODIndex = LODIndex;
+				Metrics.ScreenSize = GetSwitchScreenSize(StaticMesh, LODIndex);
+				TaskMeshes.Add(StaticMesh);
+			}
+		}
+
+		ParallelFor(OutMetrics.Num(), [&](int32 Task)
+		{
+			FLODMetrics& Metrics = OutMetrics[Task];
+			const UStaticMesh* StaticMesh = TaskMeshes[Task];
+
+			// Screen size is the bounds diameter over the screen height...
+			const float Radius = FMath::Max(StaticMesh->GetBounds().SphereRadius, KINDA_SMALL_NUMBER);
+			const float PixelsPerUnit = Metrics.ScreenSize * InSettings.StreamingScreenHeight / (2.f * Radius);
+			AnalyzeLOD(StaticMesh->RenderData->LODResources[Metrics.LODIndex], InSettings.VertexCacheSize, PixelsPerUnit, Metrics);
+		});
+	}
+
+	static void PrintMeshEfficiencyToCSVString(const FExporterHelper::FSceneDataSet& InSceneDataSet, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FLODMetrics> Metrics;
+		int32 NumMeshes = 0;
+		AnalyzeMeshes(InSceneDataSet, Settings, Metrics, NumMeshes);
+		if (Metrics.Num() == 0)
+			return;
+
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+		const TArray<FExporterHelper::FSceneStaticMeshDataSet>& Rows = InSceneDataSet.StaticMeshesTable;
+		int32 NumToRebuild = 0;
+
+		FString ToCSVFile;
+		ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("LOD,");
+		ToCSVFile += TEXT("NumTriangles,"); ToCSVFile += TEXT("NumVertices,"); ToCSVFile += TEXT("ScreenSize,");
+		ToCSVFile += TEXT("ACMR,"); ToCSVFile += TEXT("ATVR,");
+		ToCSVFile += TEXT("AverageTriangleArea,"); ToCSVFile += TEXT("SubPixelShare,"); ToCSVFile += TEXT("Rebuild,");
+		ToCSVFile += TEXT("AssetPath\n");
+		for (TArray<FLODMetrics>::TConstIterator It(Metrics); It; ++It)
+		{
+			const FLODMetrics& LODMetrics = (*It);
+			const FExporterHelper::FSceneStaticMeshDataSet& StaticMesh = Rows[LODMetrics.MeshRow];
+			const bool bRebuild = LODMetrics.ACMR > Settings.MaxACMR || LODMetrics.SubPixelShare > Settings.MaxSubPixelTriangleShare;
+			InOutContext.StringPool.AppendTo(ToCSVFile, StaticMesh.Name) += ",";
+			ToCSVFile += FString::FromInt(LODMetrics.LODIndex) + ",";
+			ToCSVFile += FString::FromInt(LODMetrics.NumTriangles) + ",";
+			ToCSVFile += FString::FromInt(LODMetrics.NumVertices) + ",";
+			FFloatFormatter::Append(ToCSVFile, LODMetrics.ScreenSize, Precisions.Default) += ",";
+			FFloatFormatter::Append(ToCSVFile, LODMetrics.ACMR, Precisions.Default) += ",";
+			FFloatFormatter::Append(ToCSVFile, LODMetrics.ATVR, Precisions.Default) += ",";
+			FFloatFormatter::Append(ToCSVFile, LODMetrics.AverageTriangleArea, Precisions.Bounds) += ",";
+			FFloatFormatter::Append(ToCSVFile, LODMetrics.SubPixelShare, Precisions.Default) += ",";
+			ToCSVFile += bRebuild ? TEXT("True,") : TEXT("False,");
+			InOutContext.StringPool.AppendTo(ToCSVFile, StaticMesh.AssetPath) += "\n";
+
+			NumToRebuild += bRebuild ? 1 : 0;
+		}
+
+		OutCSVStrings.Add("MeshLODEfficiency", ToCSVFile);
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[Mesh Efficiency] %d meshes, %d LODs, %d to rebuild with ACMR above %.2f or more than %.0f%% triangles below a pixel, %.2f s."),
+			NumMeshes, Metrics.Num(), NumToRebuild, Settings.MaxACMR, Settings.MaxSubPixelTriangleShare * 100.f, FPlatformTime::Seconds() - StartTime));
+	}
+};
@@ -0,0 +1,77 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+/** Merge sort on all cores...Chunks are sorted in parallel, then merged pairwise in parallel rounds...
+ *  Meant for index arrays...Equal elements keep the order of the chunks, tie break in the predicate for a stable result...
+ */
+class FParallelSort
+{
+public:
+
+	template<typename ElementType, typename PredicateType>
+	static void Sort(TArray<ElementType>& InOutArray, const PredicateType& InLess, int32 InMinChunkSize = 16 * 1024)
+	{
+		const int32 Num = InOutArray.Num();
+		const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+		const int32 NumChunks = FMath::Clamp(Num / FMath::Max(InMinChunkSize, 1), 1, NumWorkers * 2);
+		if (NumChunks <= 1)
+		{
+			::Sort(InOutArray.GetData(), Num, InLess);
+			return;
+		}
+
+		TArray<int32, TInlineAllocator<64>> ChunkStarts;
+		ChunkStarts.SetNumUninitialized(NumChunks + 1);
+		for (int32 i = 0; i <= NumChunks; ++i)
+			ChunkStarts[i] = (int32)((int64)Num * i / NumChunks);
+
+		ElementType* Data = InOutArray.GetData();
+		ParallelFor(NumChunks, [Data, &ChunkStarts, &InLess](int32 ChunkIndex)
+		{
+			::Sort(Data + ChunkStarts[ChunkIndex], ChunkStarts[ChunkIndex + 1] - ChunkStarts[ChunkIndex], InLess);
+		});
+
+		TArray<ElementType> Buffer;
+		Buffer.SetNumUninitialized(Num);
+		ElementType* Source = Data;
+		ElementType* Dest = Buffer.GetData();
+		for (int32 Width = 1; Width < NumChunks; Width *= 2)
+		{
+			const int32 NumMerges = FMath::DivideAndRoundUp(NumChunks, Width * 2);
+			ParallelFor(NumMerges, [Source, Dest, Width, NumChunks, &ChunkStarts, &InLess](int32 MergeIndex)
+			{
+				const int32 First = MergeIndex * Width * 2;
+				const int32 Middle = FMath::Min(First + Width, NumChunks);
+				const int32 Last = FMath::Min(First + Width * 2, NumChunks);
+				Merge(Source + ChunkStarts[First], Source + ChunkStarts[Middle], Source + ChunkStarts[Last], Dest + ChunkStarts[First], InLess);
+			});
+			Swap(Source, Dest);
+		}
+
+		if (Source != Data)
+		{
+			for (int32 i = 0; i < Num; ++i)
+				Data[i] = MoveTemp(Source[i]);
+		}
+	}
+
+private:
+
+	template<typename ElementType, typename PredicateType>
+	static void Merge(ElementType* InFirst, ElementType* InMiddle, ElementType* InLast, ElementType* OutDest, const PredicateType& InLess)
+	{
+		ElementType* Left = InFirst;
+		ElementType* Right = InMiddle;
+		while (Left < InMiddle && Right < InLast)
+			*OutDest++ = InLess(*Right, *Left) ? MoveTemp(*Right++) : MoveTemp(*Left++);
+		while (Left < InMiddle)
+			*OutDest++ = MoveTemp(*Left++);
+		while (Right < InLast)
+			*OutDest++ = MoveTemp(*Right++);
+	}
+};
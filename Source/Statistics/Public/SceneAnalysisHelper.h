@@ -0,0 +1,71 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "TextureStreamingSimulator.h"
+#include "LightStatistics.h"
+#include "InstancingDetector.h"
+#include "MergeClusterFinder.h"
+#include "TextureDuplicateFinder.h"
+#include "MeshEfficiencyAnalyzer.h"
+#include "LODScreenSizeAudit.h"
+
+class FSceneAnalysisHelper
+{
+public:
+
+	/** Main Entry Third...Analyses of the World tables kept by FExporterHelper::ExportSceneDataToCSV()... */
+	static void ExportSceneAnalysesToCSV(TMap<FString, bool>& OutResultPathsStates, const FString& InOutputPath, FExporterHelper::FExportContext& InOutContext)
+	{
+		if (!InOutContext.WorldSceneDataSets.IsValidIndex(0))
+			return;
+
+		// Instances, bounds, materials and textures are only filled in LOD0...
+		const FExporterHelper::FSceneDataSet& WorldSceneDataSet = InOutContext.WorldSceneDataSets[0];
+		const FString& WorldName = InOutContext.WorldName;
+
+		TMap<FString, FString> CSVStrings;
+		FTextureStreamingSimulator::PrintTextureStreamingToCSVString(WorldSceneDataSet, InOutContext, CSVStrings);
+		FSceneAnalysisHelper::PrintTextureWhatIfTotalsToCSVString(InOutContext, CSVStrings);
+		FInstancingDetector::PrintInstancingToCSVString(WorldSceneDataSet, InOutContext, CSVStrings);
+		FMergeClusterFinder::PrintMergeClustersToCSVString(WorldSceneDataSet, InOutContext, CSVStrings);
+		FMeshEfficiencyAnalyzer::PrintMeshEfficiencyToCSVString(WorldSceneDataSet, InOutContext, CSVStrings);
+		FLODScreenSizeAudit::PrintLODAuditToCSVString(FExporterHelper::GetWorld(), WorldSceneDataSet, InOutContext, CSVStrings);
+		FLightStatistics::PrintLightsToCSVString(FExporterHelper::GetWorld(), InOutContext, CSVStrings);
+		FTextureDuplicateFinder::PrintDuplicateTexturesToCSVString(WorldSceneDataSet, InOutContext, CSVStrings);
+
+		// Hashes added after the tables saved the cache...
+		if (InOutContext.Settings.bUseAssetCache)
+			OutResultPathsStates.Add(InOutContext.AssetCache.GetFilePath(), InOutContext.AssetCache.Save());
+
+		// Save to CSV Files...
+		FExporterHelper::SaveCSVStringsToFiles(CSVStrings, InOutputPath + "/World_" + WorldName + "/" + WorldName + "_", FString(), InOutContext.Settings, OutResultPathsStates);
+	}
+
+	/** Total KB of the textures, current and under every what-if scenario, for the World and each Level... */
+	static void PrintTextureWhatIfTotalsToCSVString(const FExporterHelper::FExportContext& InContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const TArray<FTextureWhatIfEngine::FScenario>& Scenarios = InContext.Settings.TextureWhatIfScenarios;
+		if (InContext.TextureWhatIfTotals.Num() == 0 || !Scenarios.IsValidIndex(0))
+			return;
+
+		FString ToCSVFile;
+		ToCSVFile += TEXT("Table,"); ToCSVFile += TEXT("CurrentKB,"); ToCSVFile += TEXT("FullyLoadedKB,");
+		for (TArray<FTextureWhatIfEngine::FScenario>::TConstIterator It(Scenarios); It; ++It)
+			ToCSVFile += (*It).Name + " (KB),";
+		ToCSVFile += TEXT("\n");
+
+		for (TMap<FString, FTextureWhatIfEngine::FTotals>::TConstIterator It(InContext.TextureWhatIfTotals); It; ++It)
+		{
+			ToCSVFile += It.Key() + ",";
+			FFloatFormatter::Append(ToCSVFile, It.Value().CurrentKB, InContext.Settings.FloatPrecisions.KB) += ",";
+			FFloatFormatter::Append(ToCSVFile, It.Value().FullyLoadedKB, InContext.Settings.FloatPrecisions.KB) += ",";
+			for (TArray<double>::TConstIterator It_Total(It.Value().ScenariosKB); It_Total; ++It_Total)
+				FFloatFormatter::Append(ToCSVFile, *It_Total, InContext.Settings.FloatPrecisions.KB) += ",";
+			ToCSVFile += TEXT("\n");
+		}
+
+		OutCSVStrings.Add("TextureWhatIfLevelTotals", ToCSVFile);
+	}
+};
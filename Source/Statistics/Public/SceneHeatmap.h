@@ -0,0 +1,91 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "ExporterHelper.h"
+
+class ULineBatchComponent;
+
+/** Cost of the exported BoundsTable drawn over the level, no export again...
+ *
+ *  Bounds: one box per primitive or instance, only the MaxBoxes most expensive ones...
+ *  Grid  : costs summed per XY cell of CellSize, a box per cell from the lowest to the highest bounds...
+ *  Colors go from green to red up to the 99th percentile, higher costs stay red...
+ *  All boxes are lines of one ULineBatchComponent of our own, one render proxy for the whole overlay...
+ */
+class FSceneHeatmap : public FGCObject
+{
+public:
+
+	enum class EMetric : uint8
+	{
+		Triangles,          // LOD0...
+		DrawCalls,          // Material slots of static meshes, sections of skeletal meshes...
+		TextureKB,          // Unique textures of the used materials, fully loaded...
+		ShaderInstructions, // Base pass pixel shader of the used materials...
+		Num
+	};
+
+	enum class EMode : uint8
+	{
+		Bounds,
+		Grid
+	};
+
+	struct FSettings
+	{
+		EMode Mode;
+		float CellSize;
+		int32 MaxBoxes;
+		float Thickness;
+		bool bForeground;
+
+		FSettings() : Mode(EMode::Bounds), CellSize(5000.f), MaxBoxes(200000), Thickness(0.f), bForeground(false) {}
+
+		void LoadConfig(const FString& InConfigFile)
+		{
+			FString ModeName;
+			if (GConfig->GetString(TEXT("Heatmap"), TEXT("Mode"), ModeName, InConfigFile))
+				Mode = ModeName.Equals(TEXT("Grid"), ESearchCase::IgnoreCase) ? EMode::Grid : EMode::Bounds;
+			GConfig->GetFloat(TEXT("Heatmap"), TEXT("CellSize"), CellSize, InConfigFile);
+			GConfig->GetInt(TEXT("Heatmap"), TEXT("MaxBoxes"), MaxBoxes, InConfigFile);
+			GConfig->GetFloat(TEXT("Heatmap"), TEXT("Thickness"), Thickness, InConfigFile);
+			GConfig->GetBool(TEXT("Heatmap"), TEXT("Foreground"), bForeground, InConfigFile);
+			CellSize = FMath::Max(CellSize, 1.f);
+		}
+	};
+
+	FSceneHeatmap();
+	virtual ~FSceneHeatmap();
+
+	static const TCHAR* GetMetricName(EMetric InMetric);
+
+	/** Cost of every row of BoundsTable, 0 for rows without mesh...Instances cost as much as their mesh... */
+	static void GetBoundsCosts(const FExporterHelper::FExportContext& InContext, EMetric InMetric, TArray<float>& OutCosts);
+
+	/** Replaces the overlay...False without World tables... */
+	bool Show(UWorld* InWorld, const FExporterHelper::FExportContext& InContext, EMetric InMetric, const FSettings& InSettings);
+	void Hide();
+	bool IsShown() const { return LineBatcher != nullptr; }
+
+	// FGCObject...
+	virtual void AddReferencedObjects(FReferenceCollector& InCollector) override;
+
+private:
+
+	struct FHeatBox
+	{
+		FBox Box;
+		float Cost;
+	};
+
+	static void GetBoundsBoxes(const FExporterHelper::FSceneDataSet& InSceneDataSet, const TArray<float>& InCosts, int32 InMaxBoxes, TArray<FHeatBox>& OutBoxes);
+	static void GetGridBoxes(const FExporterHelper::FSceneDataSet& InSceneDataSet, const TArray<float>& InCosts, float InCellSize, TArray<FHeatBox>& OutBoxes);
+	void DrawBoxes(const TArray<FHeatBox>& InBoxes, const FSettings& InSettings);
+
+	ULineBatchComponent* LineBatcher;
+	// The component goes away with its World...
+	FDelegateHandle WorldCleanupHandle;
+};
@@ -0,0 +1,179 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StringPool.h"
+#include "Serialization/BufferArchive.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+/** Scene cost tree...World -> Level -> Actor -> Component -> Asset...Flat nodes, a parent is always before its children... */
+class FSceneRollup
+{
+public:
+
+	enum class ENodeType : uint8
+	{
+		World,
+		Level,
+		Actor,
+		Component,
+		Asset,
+		Num
+	};
+
+	/** Summed up the tree...Shared textures and meshes count at every user... */
+	struct FCosts
+	{
+		uint64 NumTriangles;
+		uint32 NumDrawCalls;
+		uint32 NumMaterialSlots;
+		float  TextureKB;
+		float  MeshKB;
+
+		FCosts() : NumTriangles(0), NumDrawCalls(0), NumMaterialSlots(0), TextureKB(0.f), MeshKB(0.f) {}
+
+		FCosts& operator+=(const FCosts& InOther)
+		{
+			NumTriangles += InOther.NumTriangles;
+			NumDrawCalls += InOther.NumDrawCalls;
+			NumMaterialSlots += InOther.NumMaterialSlots;
+			TextureKB += InOther.TextureKB;
+			MeshKB += InOther.MeshKB;
+			return *this;
+		}
+	};
+
+	int32 AddNode(int32 InParent, ENodeType InType, FStringPool::FId InName, const FCosts& InCosts = FCosts())
+	{
+		check(InParent < Parents.Num());
+
+		Parents.Add(InParent);
+		Types.Add(InType);
+		Names.Add(InName);
+		return Costs.Add(InCosts);
+	}
+
+	/** One reverse pass...Children are always after their parent, so every node is complete before it is added up... */
+	void Aggregate()
+	{
+		for (int32 i = Parents.Num() - 1; i > 0; --i)
+		{
+			if (Parents[i] != INDEX_NONE)
+				Costs[Parents[i]] += Costs[i];
+		}
+	}
+
+	int32 Num() const { return Parents.Num(); }
+
+	/** Magic, version, num nodes, then one array per field...Costs too, NumTriangles of all nodes, then NumDrawCalls...Then the null terminated UTF-8 names... */
+	bool SaveToFile(const FString& InFilePath, const FStringPool& InStringPool) const
+	{
+		const int32 NumNodes = Parents.Num();
+
+		// Names of all nodes in one blob...Each node keeps the offset of its name...
+		TArray<ANSICHAR> NamesBlob;
+		TArray<uint32>	 NameOffsets;
+		TMap<FStringPool::FId, uint32> WrittenNames;
+		NameOffsets.SetNumUninitialized(NumNodes);
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			if (const uint32* Offset = WrittenNames.Find(Names[i]))
+			{
+				NameOffsets[i] = *Offset;
+				continue;
+			}
+
+			FTCHARToUTF8 NameUTF8(InStringPool[Names[i]], InStringPool.Len(Names[i]));
+			NameOffsets[i] = NamesBlob.Num();
+			NamesBlob.Append(NameUTF8.Get(), NameUTF8.Length());
+			NamesBlob.Add('\0');
+			WrittenNames.Add(Names[i], NameOffsets[i]);
+		}
+
+		FBufferArchive Writer;
+		uint32 FileMagic = Magic, FileVersion = Version;
+		int32 NumNodesToWrite = NumNodes, NumNameBytes = NamesBlob.Num();
+		Writer << FileMagic << FileVersion << NumNodesToWrite << NumNameBytes;
+		Writer.Serialize((void*)Parents.GetData(), NumNodes * sizeof(int32));
+		Writer.Serialize((void*)Types.GetData(), NumNodes * sizeof(ENodeType));
+		Writer.Serialize(NameOffsets.GetData(), NumNodes * sizeof(uint32));
+		SerializeCostField(Writer, [](const FCosts& InCosts) { return InCosts.NumTriangles; });
+		SerializeCostField(Writer, [](const FCosts& InCosts) { return InCosts.NumDrawCalls; });
+		SerializeCostField(Writer, [](const FCosts& InCosts) { return InCosts.NumMaterialSlots; });
+		SerializeCostField(Writer, [](const FCosts& InCosts) { return InCosts.TextureKB; });
+		SerializeCostField(Writer, [](const FCosts& InCosts) { return InCosts.MeshKB; });
+		Writer.Serialize(NamesBlob.GetData(), NamesBlob.Num());
+
+		return FFileHelper::SaveArrayToFile(Writer, *InFilePath);
+	}
+
+	/** World totals and the top N nodes of every other type by triangles... */
+	FString PrintTopNodesToJsonString(const FStringPool& InStringPool, int32 InTopN) const
+	{
+		static const TCHAR* TypeNames[] = { TEXT("World"), TEXT("Level"), TEXT("Actor"), TEXT("Component"), TEXT("Asset") };
+
+		TArray<TArray<int32>> NodesPerType;
+		NodesPerType.AddDefaulted((int32)ENodeType::Num);
+		for (int32 i = 0; i < Parents.Num(); ++i)
+			NodesPerType[(int32)Types[i]].Add(i);
+
+		auto MakeNodeObject = [this, &InStringPool](int32 InNode) -> TSharedRef<FJsonObject>
+		{
+			TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
+			NodeObject->SetNumberField(TEXT("Id"), InNode);
+			NodeObject->SetStringField(TEXT("Name"), InStringPool.ToString(Names[InNode]));
+			if (Parents[InNode] != INDEX_NONE)
+				NodeObject->SetStringField(TEXT("Parent"), InStringPool.ToString(Names[Parents[InNode]]));
+			NodeObject->SetNumberField(TEXT("NumTriangles"), (double)Costs[InNode].NumTriangles);
+			NodeObject->SetNumberField(TEXT("NumDrawCalls"), Costs[InNode].NumDrawCalls);
+			NodeObject->SetNumberField(TEXT("NumMaterialSlots"), Costs[InNode].NumMaterialSlots);
+			NodeObject->SetNumberField(TEXT("TextureKB"), Costs[InNode].TextureKB);
+			NodeObject->SetNumberField(TEXT("MeshKB"), Costs[InNode].MeshKB);
+			return NodeObject;
+		};
+
+		TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+		RootObject->SetNumberField(TEXT("NumNodes"), Parents.Num());
+		for (int32 Type = 0; Type < (int32)ENodeType::Num; ++Type)
+		{
+			TArray<int32>& Nodes = NodesPerType[Type];
+			Nodes.Sort([this](int32 A, int32 B) { return Costs[A].NumTriangles > Costs[B].NumTriangles; });
+
+			TArray<TSharedPtr<FJsonValue>> NodeValues;
+			for (int32 i = 0; i < FMath::Min(Nodes.Num(), InTopN); ++i)
+				NodeValues.Add(MakeShared<FJsonValueObject>(MakeNodeObject(Nodes[i])));
+			RootObject->SetArrayField(TypeNames[Type], NodeValues);
+		}
+
+		FString JsonString;
+		TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+		FJsonSerializer::Serialize(RootObject, JsonWriter);
+		return JsonString;
+	}
+
+private:
+
+	/** One contiguous array of a cost field... */
+	template <typename FieldGetterType>
+	void SerializeCostField(FArchive& Ar, FieldGetterType FieldGetter) const
+	{
+		typedef decltype(FieldGetter(FCosts())) FFieldType;
+		TArray<FFieldType> Field;
+		Field.SetNumUninitialized(Costs.Num());
+		for (int32 i = 0; i < Costs.Num(); ++i)
+			Field[i] = FieldGetter(Costs[i]);
+		Ar.Serialize(Field.GetData(), Field.Num() * sizeof(FFieldType));
+	}
+
+	static const uint32 Magic = 0x504C5253; // SRLP
+	static const uint32 Version = 2;
+
+	TArray<int32>			 Parents;
+	TArray<ENodeType>		 Types;
+	TArray<FStringPool::FId> Names;
+	TArray<FCosts>			 Costs;
+};
@@ -7,6 +7,7 @@
 
 class FToolBarBuilder;
 class FMenuBuilder;
+class FStatisticsServer;
 
 class FStatisticsModule : public IModuleInterface
 {
@@ -28,4 +29,6 @@ private:
 
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
+	// Only with [LiveServer] Enabled...
+	TSharedPtr<FStatisticsServer> StatisticsServer;
 };
@@ -0,0 +1,141 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeRWLock.h"
+#include "ExporterHelper.h"
+#include "SceneIndex.h"
+#include "ServerConnection.h"
+
+class FSocket;
+class FRunnableThread;
+class AActor;
+
+/** Scene statistics for external viewers and scripts on a loopback TCP port, no export needed...
+ *
+ *  Wire format, spatial index and request framing are shared with Tools/StatisticsClient, see Protocol.h, SceneIndex.h and ServerConnection.h...
+ *  The stand-in server of the load test answers with the same code...
+ *
+ *  The World tables are gathered on the game thread on the first query, for new levels and for materials not in the tables,
+ *  at most every RefreshSeconds...Moved, added, deleted and edited actors are patched into the index on the next tick...
+ *  Queries are answered on the server thread under a read lock of the index, patches take the write lock...
+ *  Sockets never block, answers queue per connection and a client that does not read only stalls itself...
+ *
+ *  Little endian, every message is a 12 bytes header followed by its payload...
+ *  Header       : uint32 PayloadSize, uint16 Query, uint16 Status (0 in requests), uint32 RequestId (echoed)...
+ *  Info         : -> uint32 Version, uint32 NumPrimitives, uint32 NumStaticMeshes, uint32 NumSkeletalMeshes, uint32 NumMaterials,
+ *                    uint32 NumTextures, float GatherMs, float Age, FVector BoundsMin, FVector BoundsMax...
+ *                 Version counts gathers and patches, Age is the time since the last of them...
+ *  BoxStats     : FVector Min, FVector Max -> uint32 NumPrimitives, uint64 NumTriangles, uint32 NumMeshes, uint32 NumMaterials...
+ *                 Materials of instances count as their parent material...
+ *  TopMaterials : uint32 Count, uint8 SortBy (0 BPSCount, 1 BPSVertex, 2 NumRefs) -> uint32 Num, Num x { int32 BPSCount, int32 BPSVertex, uint32 NumRefs, uint16 NameLen, UTF-8 Name }...
+ *  GridTriangles: FVector Min, FVector Max, float CellSize -> uint32 NumX, uint32 NumY, NumX x NumY uint32 Triangles (X fastest)...
+ *                 A primitive counts in the XY cell of its bounds center...
+ */
+class FStatisticsServer : public FRunnable
+{
+public:
+
+	typedef StatisticsClient::EQuery EQuery;
+	typedef StatisticsClient::EStatus EStatus;
+
+	struct FSettings
+	{
+		bool bEnabled;
+		int32 Port;
+		float RefreshSeconds;
+		int32 MaxGridCells;
+		float IndexCellSize;
+
+		FSettings() : bEnabled(false), Port(7781), RefreshSeconds(10.f), MaxGridCells(1024 * 1024), IndexCellSize(2000.f) {}
+
+		void LoadConfig(const FString& InConfigFile)
+		{
+			GConfig->GetBool(TEXT("LiveServer"), TEXT("Enabled"), bEnabled, InConfigFile);
+			GConfig->GetInt(TEXT("LiveServer"), TEXT("Port"), Port, InConfigFile);
+			GConfig->GetFloat(TEXT("LiveServer"), TEXT("RefreshSeconds"), RefreshSeconds, InConfigFile);
+			GConfig->GetInt(TEXT("LiveServer"), TEXT("MaxGridCells"), MaxGridCells, InConfigFile);
+			GConfig->GetFloat(TEXT("LiveServer"), TEXT("IndexCellSize"), IndexCellSize, InConfigFile);
+			IndexCellSize = FMath::Max(IndexCellSize, 1.f);
+		}
+	};
+
+	/** World tables of the last gather...Never changed after the build, the index is patched instead... */
+	struct FSnapshot
+	{
+		FExporterHelper::FExportContext Context;
+		TArray<FExporterHelper::FSceneDataSet> PerLODSceneDataSets;
+		// UniqueId of a UMaterial to its row of MaterialsTable...
+		TMap<uint32, int32> MaterialRows;
+		double GatherSeconds;
+	};
+
+	FStatisticsServer(const FSettings& InSettings, const FString& InConfigFile);
+	virtual ~FStatisticsServer();
+
+	/** Binds 127.0.0.1:Port, starts the thread and listens to actor changes... */
+	bool Start();
+
+	// FRunnable...
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+
+	struct FClient
+	{
+		FSocket* Socket;
+		StatisticsClient::FServerConnection Connection;
+	};
+
+	bool Tick(float InDeltaTime);
+	void BuildSnapshot();
+	void PatchSnapshot();
+
+	/** One row per primitive, or per instance...False when a material is not in the snapshot tables... */
+	static bool AddPrimitiveRows(StatisticsClient::FSceneIndex& InOutIndex, const TMap<uint32, int32>& InMaterialRows, UPrimitiveComponent* InComponent, TArray<uint32>& OutRows);
+
+	void OnActorChanged(AActor* InActor);
+	void OnObjectChanged(UObject* InObject);
+	void OnLevelsChanged();
+
+	/** Server thread... */
+	EStatus ExecuteQuery(EQuery InQuery, StatisticsClient::FReader& InRequest, std::vector<uint8>& OutPayload);
+
+	FSettings Settings;
+	FString ConfigFile;
+
+	FSocket* ListenSocket;
+	FRunnableThread* Thread;
+	TArray<TUniquePtr<FClient>> Clients;
+	FThreadSafeBool bStopping;
+
+	// Snapshot, Index, Version and UpdateTime...Written on the game thread only, which reads them without the lock...
+	FRWLock IndexLock;
+	TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> Snapshot;
+	StatisticsClient::FSceneIndex Index;
+	uint32 Version;
+	double UpdateTime;
+	// Set by the server thread...The game thread only gathers for a server in use...
+	FThreadSafeBool bQueried;
+
+	// Game thread...Actors are keys only, never dereferenced...
+	TMap<const AActor*, TArray<uint32>> ActorRows;
+	TMap<const AActor*, TWeakObjectPtr<AActor>> DirtyActors;
+	bool bGatherNeeded;
+	double GatherTime;
+
+	FDelegateHandle TickHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle MapChangeHandle;
+};
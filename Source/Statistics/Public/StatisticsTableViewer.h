@@ -0,0 +1,98 @@
+// ...
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "ExporterHelper.h"
+
+/** World tables of the last export in a virtualized list...
+ *  Sorting and filtering only reorder index arrays, rows are never copied...Sort keys are gathered and sorted on all cores...
+ *  Shift click on a header adds a secondary sort column...Click on a row selects its actor or syncs the content browser to its asset...
+ */
+class SStatisticsTableViewer : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SStatisticsTableViewer) {}
+	SLATE_ARGUMENT(TSharedPtr<FExporterHelper::FExportContext>, ExportContext)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** List item of one row...Aliases its element of RowItems, the list view needs shared pointers but no allocation per row... */
+	typedef TSharedPtr<const int32> FRowItemPtr;
+
+	FText GetCellText(int32 InRow, const FName& InColumnId) const;
+
+private:
+
+	/** Either a string or a number column...Numbers sort by value... */
+	struct FColumn
+	{
+		FName Id;
+		FText Label;
+		float FillWidth;
+		TFunction<const TCHAR*(int32)> GetString;
+		TFunction<double(int32)> GetNumber;
+		int32 Precision; // Decimals of GetNumber, 0 prints an integer...
+	};
+
+	struct FTable
+	{
+		FString Name;
+		int32 NumRows;
+		TArray<FColumn> Columns;
+		TFunction<void(int32, bool)> OnRowClicked; // Row, bFocus...
+	};
+
+	void BuildTables();
+	void SelectTable(int32 InTableIndex);
+	void SortRows();
+	void FilterRows(bool bInIncremental);
+	void RefreshItems();
+
+	TSharedRef<ITableRow> OnGenerateRow(FRowItemPtr InItem, const TSharedRef<STableViewBase>& InOwnerTable);
+	TSharedRef<SWidget> OnGenerateTableName(TSharedPtr<FString> InName);
+	void OnTableNameSelected(TSharedPtr<FString> InName, ESelectInfo::Type InSelectInfo);
+	void OnFilterTextChanged(const FText& InText);
+	void OnSortModeChanged(EColumnSortPriority::Type InPriority, const FName& InColumnId, EColumnSortMode::Type InSortMode);
+	EColumnSortMode::Type GetColumnSortMode(FName InColumnId) const;
+	EColumnSortPriority::Type GetColumnSortPriority(FName InColumnId) const;
+	void OnSelectionChanged(FRowItemPtr InItem, ESelectInfo::Type InSelectInfo);
+	void OnRowDoubleClicked(FRowItemPtr InItem);
+	FText GetCurrentTableName() const;
+	FText GetStatusText() const;
+
+	static void SelectComponentActor(const TWeakObjectPtr<UPrimitiveComponent>& InComponent, bool bInFocus);
+	void SyncBrowserToAsset(FStringPool::FId InAssetPath) const;
+
+	TSharedPtr<FExporterHelper::FExportContext> ExportContext;
+
+	// Rows of all LODs...
+	TArray<const FExporterHelper::FSceneStaticMeshDataSet*> StaticMeshRows;
+	TArray<const FExporterHelper::FSceneSkeletalMeshDataSet*> SkeletalMeshRows;
+	// Bounds row -> Mesh row, see FExporterHelper::GetBoundsOwners()...
+	TArray<int32> BoundsOwners;
+
+	TArray<FTable> Tables;
+	TArray<TSharedPtr<FString>> TableNames;
+	int32 CurrentTable;
+
+	// Row i holds i...One flat array per table, items keep their address through sorts and filters...
+	TSharedPtr<TArray<int32>> RowItems;
+	TArray<int32> SortedRows;
+	TArray<int32> FilteredRows;
+	TArray<FRowItemPtr> VisibleItems;
+	FString FilterText;
+
+	// Primary and secondary...
+	FName SortColumns[2];
+	EColumnSortMode::Type SortModes[2];
+
+	FString LastOperation;
+	double LastOperationMs;
+
+	TSharedPtr<SListView<FRowItemPtr>> ListView;
+	TSharedPtr<SHeaderRow> HeaderRow;
+};
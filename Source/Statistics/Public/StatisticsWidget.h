@@ -4,6 +4,8 @@
 
 #include "Widgets/SCompoundWidget.h"
 #include "Input/Reply.h"
+#include "ExporterHelper.h"
+#include "SceneHeatmap.h"
 
 class SStatisticsWidget : public SCompoundWidget
 {
@@ -19,6 +21,12 @@ private:
 	FString OutputPath;
 	FString VisualizationToolPath;
 	float _Scale;
+	// Last export...Its World tables are handed over to the viewer in a mapped file and browsed in SStatisticsTableViewer...
+	TSharedPtr<FExporterHelper::FExportContext> LastExportContext;
+	// Overlay of the last export in the level viewports...
+	TSharedPtr<FSceneHeatmap> Heatmap;
+	TArray<TSharedPtr<FString>> HeatmapMetricNames;
+	FSceneHeatmap::EMetric HeatmapMetric;
 
 	// OnClicked
 	FReply OnButtonChooseClicked();
@@ -27,6 +35,16 @@ private:
 
 	FReply OnButtonAnalysisClicked();
 
+	FReply OnButtonTablesClicked();
+
+	FReply OnButtonShowHeatmapClicked();
+
+	FReply OnButtonHideHeatmapClicked();
+
+	void OnHeatmapMetricSelected(TSharedPtr<FString> InName, ESelectInfo::Type InSelectInfo);
+
+	void ShowHeatmap();
+
 	TOptional<float> GetValue() const { return _Scale; }
 
 	void OnSliderValueChanged(float InVal);
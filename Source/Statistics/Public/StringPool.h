@@ -0,0 +1,143 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Hash/CityHash.h"
+
+/** Unique strings of one export stored once in a contiguous arena...Rows keep the 32 bit id instead of a FString... */
+class FStringPool
+{
+public:
+
+	typedef uint32 FId; // 0 is the empty string...Zeroed rows are valid...
+
+	FStringPool()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		Chars.Reset();
+		Offsets.Reset();
+		Lengths.Reset();
+		Hashes.Reset();
+
+		// Id 0...
+		Chars.Add(TEXT('\0'));
+		Offsets.Add(0);
+		Lengths.Add(0);
+		Hashes.Add(0);
+
+		Buckets.Reset();
+		Buckets.SetNumZeroed(1024);
+		NameIds.Reset();
+	}
+
+	FId Add(const TCHAR* InStr, int32 InLen)
+	{
+		if (!InStr || InLen <= 0)
+			return 0;
+
+		const uint32 Hash = CityHash32((const char*)InStr, InLen * sizeof(TCHAR));
+
+		// Open addressing...Bucket 0 is a free slot as id 0 is never hashed...
+		const uint32 Mask = Buckets.Num() - 1;
+		uint32 Slot = Hash & Mask;
+		while (Buckets[Slot] != 0)
+		{
+			const FId Id = Buckets[Slot];
+			if (Hashes[Id] == Hash && Lengths[Id] == InLen && FMemory::Memcmp(&Chars[Offsets[Id]], InStr, InLen * sizeof(TCHAR)) == 0)
+				return Id;
+			Slot = (Slot + 1) & Mask;
+		}
+
+		const FId NewId = Offsets.Num();
+		Offsets.Add(Chars.Num());
+		Lengths.Add(InLen);
+		Hashes.Add(Hash);
+		Chars.Append(InStr, InLen);
+		Chars.Add(TEXT('\0'));
+		Buckets[Slot] = NewId;
+
+		// Keep load under one half...
+		if ((uint32)Offsets.Num() * 2 > (uint32)Buckets.Num())
+			Rehash(Buckets.Num() * 2);
+
+		return NewId;
+	}
+
+	FId Add(const FString& InStr)
+	{
+		return Add(*InStr, InStr.Len());
+	}
+
+	/** Converted to a string once...Later adds of the same name are one lookup... */
+	FId Add(const FName& InName)
+	{
+		if (const FId* CachedId = NameIds.Find(InName))
+			return *CachedId;
+
+		const FId Id = Add(InName.ToString());
+		NameIds.Add(InName, Id);
+		return Id;
+	}
+
+	/** Null terminated...Only valid until the next Add()... */
+	const TCHAR* operator[](FId InId) const
+	{
+		return &Chars[Offsets[InId]];
+	}
+
+	int32 Len(FId InId) const
+	{
+		return Lengths[InId];
+	}
+
+	FString ToString(FId InId) const
+	{
+		return FString(Lengths[InId], &Chars[Offsets[InId]]);
+	}
+
+	/** Append to a CSV buffer without a temporary FString... */
+	FString& AppendTo(FString& OutStr, FId InId) const
+	{
+		OutStr.AppendChars(&Chars[Offsets[InId]], Lengths[InId]);
+		return OutStr;
+	}
+
+	int32 Num() const
+	{
+		return Offsets.Num();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Chars.GetAllocatedSize() + Offsets.GetAllocatedSize() + Lengths.GetAllocatedSize() + Hashes.GetAllocatedSize() + Buckets.GetAllocatedSize() + NameIds.GetAllocatedSize();
+	}
+
+private:
+
+	void Rehash(int32 InNumBuckets)
+	{
+		Buckets.Reset();
+		Buckets.SetNumZeroed(InNumBuckets);
+
+		const uint32 Mask = InNumBuckets - 1;
+		for (FId Id = 1; Id < (FId)Offsets.Num(); ++Id)
+		{
+			uint32 Slot = Hashes[Id] & Mask;
+			while (Buckets[Slot] != 0)
+				Slot = (Slot + 1) & Mask;
+			Buckets[Slot] = Id;
+		}
+	}
+
+	TArray<TCHAR>  Chars;
+	TArray<uint32> Offsets;
+	TArray<int32>  Lengths;
+	TArray<uint32> Hashes;
+	TArray<FId>	   Buckets; // Power of two...
+	TMap<FName, FId> NameIds;
+};
@@ -0,0 +1,428 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformTime.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+/** Same texture imported under different paths...Every copy is loaded and counted on its own...
+ *
+ *  Exact     : CityHash64 of source mip 0, seeded with its size and source format...
+ *  Perceptual: 64 bit difference hash of a 9x8 gray thumbnail, copies within MaxDistance bits are one group...
+ *  Source mips are copied on the game thread in batches of at most BudgetMB, hashed in parallel and freed before the next batch...
+ *  GetMipData reads the bulk data into the copy and drops what it loaded, sources stay as resident as they were...
+ *  Both hashes are kept in FAssetAnalysisCache, sources of unchanged packages are never read again...
+ */
+class FTextureDuplicateFinder
+{
+public:
+
+#if ENGINE_MINOR_VERSION >= 23
+	typedef TArray64<uint8> FMipData;
+#else
+	typedef TArray<uint8> FMipData;
+#endif
+
+	struct FTextureHash
+	{
+		uint64 ContentHash;
+		uint64 PerceptualHash;
+		uint8  bValid : 1;
+		uint8  bHasPerceptualHash : 1; // Known source formats only...
+	};
+
+	struct FGroup
+	{
+		int32 FirstMember; // See FResult::Members...
+		int32 NumMembers;
+		int32 KeptRow;	   // Largest copy...
+		float TotalKB;
+		float ReclaimableKB;
+	};
+
+	struct FResult
+	{
+		TArray<FGroup> Groups;	// Most KB reclaimable first...
+		TArray<int32> Members;	// Rows of TexturesTable...
+		int32 NumHashed;
+		int32 NumCached;
+		double Seconds;
+	};
+
+	/** Hashes of every texture, invalid for textures without source... */
+	static void HashTextures(const TArray<UTexture*>& InTextures, int32 InBudgetMB, FAssetAnalysisCache* InOutCache, TArray<FTextureHash>& OutHashes, int32& OutNumHashed, int32& OutNumCached)
+	{
+		OutHashes.SetNumZeroed(InTextures.Num());
+		OutNumHashed = OutNumCached = 0;
+
+		TArray<int32> Pending;
+		TArray<int64> PendingBytes;
+		for (int32 i = 0; i < InTextures.Num(); ++i)
+		{
+			UTexture* Texture = InTextures[i];
+			if (!Texture || !Texture->Source.IsValid())
+				continue;
+
+			if (InOutCache && LoadHash(*InOutCache, Texture, OutHashes[i]))
+			{
+				OutNumCached++;
+				continue;
+			}
+
+			Pending.Add(i);
+			PendingBytes.Add(Texture->Source.CalcMipSize(0));
+		}
+
+		// At least one texture per batch, however large...
+		const int64 BudgetBytes = (int64)FMath::Max(InBudgetMB, 1) * 1024 * 1024;
+		TArray<FMipData> MipData;
+		for (int32 BatchBegin = 0; BatchBegin < Pending.Num();)
+		{
+			int32 BatchEnd = BatchBegin;
+			int64 BatchBytes = 0;
+			while (BatchEnd < Pending.Num() && (BatchEnd == BatchBegin || BatchBytes + PendingBytes[BatchEnd] <= BudgetBytes))
+				BatchBytes += PendingBytes[BatchEnd++];
+
+			// Bulk data is loaded on the game thread only...A copy, nothing stays locked...
+			MipData.SetNum(BatchEnd - BatchBegin);
+			for (int32 i = BatchBegin; i < BatchEnd; ++i)
+			{
+				if (!InTextures[Pending[i]]->Source.GetMipData(MipData[i - BatchBegin], 0))
+					MipData[i - BatchBegin].Empty();
+			}
+
+			ParallelFor(BatchEnd - BatchBegin, [&](int32 i)
+			{
+				if (MipData[i].Num() > 0)
+					ComputeHash(InTextures[Pending[BatchBegin + i]]->Source, MipData[i].GetData(), MipData[i].Num(), OutHashes[Pending[BatchBegin + i]]);
+			});
+
+			for (int32 i = BatchBegin; i < BatchEnd; ++i)
+			{
+				if (MipData[i - BatchBegin].Num() == 0)
+					continue;
+
+				UTexture* Texture = InTextures[Pending[i]];
+				if (InOutCache)
+					StoreHash(*InOutCache, Texture, OutHashes[Pending[i]]);
+				OutNumHashed++;
+			}
+
+			// Copies of this batch are freed before the next one is read...
+			MipData.Reset();
+			BatchBegin = BatchEnd;
+		}
+	}
+
+	static void FindGroups(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FStringPool& InStringPool, const FExporterHelper::FExportSettings& InSettings, FAssetAnalysisCache* InOutCache, FResult& OutResult)
+	{
+		OutResult.Groups.Reset();
+		OutResult.Members.Reset();
+		OutResult.NumHashed = OutResult.NumCached = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		const TArray<FExporterHelper::FSceneTextureDataSet>& Rows = InSceneDataSet.TexturesTable;
+
+		// Textures of the scene are loaded...Nothing is loaded here...
+		TArray<UTexture*> Textures;
+		Textures.Reserve(Rows.Num());
+		for (TArray<FExporterHelper::FSceneTextureDataSet>::TConstIterator It(Rows); It; ++It)
+			Textures.Add(FindObject<UTexture>(nullptr, InStringPool[(*It).AssetPath]));
+
+		TArray<FTextureHash> Hashes;
+		HashTextures(Textures, InSettings.DuplicateTextureBudgetMB, InOutCache, Hashes, OutResult.NumHashed, OutResult.NumCached);
+
+		// Row -> Root row of its group...
+		TArray<int32> Parents;
+		Parents.SetNumUninitialized(Rows.Num());
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+			Parents[Row] = Row;
+
+		const bool bPerceptual = InSettings.bPerceptualTextureHash;
+		const int32 MaxDistance = bPerceptual ? InSettings.DuplicateTextureMaxDistance : 0;
+		if (MaxDistance == 0)
+		{
+			TMap<uint64, int32> FirstRows;
+			FirstRows.Reserve(Rows.Num());
+			for (int32 Row = 0; Row < Rows.Num(); ++Row)
+			{
+				const FTextureHash& Hash = Hashes[Row];
+				if (!Hash.bValid || (bPerceptual && !Hash.bHasPerceptualHash))
+					continue;
+
+				const uint64 Key = bPerceptual ? Hash.PerceptualHash : Hash.ContentHash;
+				if (const int32* FirstRow = FirstRows.Find(Key))
+					Parents[Row] = *FirstRow;
+				else
+					FirstRows.Add(Key, Row);
+			}
+		}
+		else
+		{
+			// Near copies...All pairs, a few thousand textures at most...
+			TArray<int32> HashedRows;
+			for (int32 Row = 0; Row < Rows.Num(); ++Row)
+			{
+				if (Hashes[Row].bValid && Hashes[Row].bHasPerceptualHash)
+					HashedRows.Add(Row);
+			}
+
+			for (int32 i = 0; i < HashedRows.Num(); ++i)
+			{
+				const uint64 Hash = Hashes[HashedRows[i]].PerceptualHash;
+				for (int32 j = i + 1; j < HashedRows.Num(); ++j)
+				{
+					if (FPlatformMath::CountBits(Hash ^ Hashes[HashedRows[j]].PerceptualHash) > MaxDistance)
+						continue;
+
+					const int32 RootA = FindRoot(Parents, HashedRows[i]);
+					const int32 RootB = FindRoot(Parents, HashedRows[j]);
+					if (RootA != RootB)
+						Parents[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+				}
+			}
+		}
+
+		// Members grouped by root...Groups of one are dropped...
+		TArray<int32> Counts;
+		Counts.AddZeroed(Rows.Num());
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+			Counts[FindRoot(Parents, Row)]++;
+
+		TArray<int32> RootGroups;
+		RootGroups.Init(INDEX_NONE, Rows.Num());
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+		{
+			if (Counts[Row] < 2)
+				continue;
+
+			FGroup& Group = OutResult.Groups[OutResult.Groups.AddZeroed()];
+			Group.FirstMember = OutResult.Members.Num();
+			Group.KeptRow = Row;
+			OutResult.Members.AddUninitialized(Counts[Row]);
+			RootGroups[Row] = OutResult.Groups.Num() - 1;
+		}
+
+		for (int32 Row = 0; Row < Rows.Num(); ++Row)
+		{
+			const int32 GroupIndex = RootGroups[FindRoot(Parents, Row)];
+			if (GroupIndex == INDEX_NONE)
+				continue;
+
+			FGroup& Group = OutResult.Groups[GroupIndex];
+			OutResult.Members[Group.FirstMember + Group.NumMembers++] = Row;
+			Group.TotalKB += Rows[Row].FullyLoadedKB;
+			if (Rows[Row].FullyLoadedKB > Rows[Group.KeptRow].FullyLoadedKB)
+				Group.KeptRow = Row;
+		}
+
+		for (TArray<FGroup>::TIterator It(OutResult.Groups); It; ++It)
+			(*It).ReclaimableKB = (*It).TotalKB - Rows[(*It).KeptRow].FullyLoadedKB;
+
+		OutResult.Groups.Sort([](const FGroup& A, const FGroup& B)
+		{
+			return A.ReclaimableKB > B.ReclaimableKB;
+		});
+
+		OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	static void PrintDuplicateTexturesToCSVString(const FExporterHelper::FSceneDataSet& InSceneDataSet, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+		if (!Settings.bFindDuplicateTextures)
+			return;
+
+		FResult Result;
+		FindGroups(InSceneDataSet, InOutContext.StringPool, Settings, Settings.bUseAssetCache ? &InOutContext.AssetCache : nullptr, Result);
+
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+		const TArray<FExporterHelper::FSceneTextureDataSet>& Rows = InSceneDataSet.TexturesTable;
+		double NumReclaimableKB = 0.0;
+
+		if (Result.Groups.Num() > 0)
+		{
+			// DuplicateTextureGroups...
+			{
+				FString ToCSVFile;
+				ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("NumTextures,");
+				ToCSVFile += TEXT("SourceSize,"); ToCSVFile += TEXT("TotalKB,"); ToCSVFile += TEXT("ReclaimableKB,");
+				ToCSVFile += TEXT("AssetPath\n");
+				for (int32 i = 0; i < Result.Groups.Num(); ++i)
+				{
+					const FGroup& Group = Result.Groups[i];
+					const FExporterHelper::FSceneTextureDataSet& Kept = Rows[Group.KeptRow];
+					ToCSVFile += FString::FromInt(i) + ",";
+					InOutContext.StringPool.AppendTo(ToCSVFile, Kept.Name) += ",";
+					ToCSVFile += FString::FromInt(Group.NumMembers) + ",";
+					ToCSVFile += Kept.SourceSize + ",";
+					FFloatFormatter::Append(ToCSVFile, Group.TotalKB, Precisions.KB) += ",";
+					FFloatFormatter::Append(ToCSVFile, Group.ReclaimableKB, Precisions.KB) += ",";
+					InOutContext.StringPool.AppendTo(ToCSVFile, Kept.AssetPath) += "\n";
+
+					NumReclaimableKB += Group.ReclaimableKB;
+				}
+
+				OutCSVStrings.Add("DuplicateTextureGroups", ToCSVFile);
+			}
+
+			// DuplicateTextures...
+			{
+				FString ToCSVFile;
+				ToCSVFile += TEXT("GroupId,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("Kept,");
+				ToCSVFile += TEXT("SourceSize,"); ToCSVFile += TEXT("SourceFormat,"); ToCSVFile += TEXT("PixelFormat,");
+				ToCSVFile += TEXT("FullyLoadedKB,"); ToCSVFile += TEXT("NumRefs,");
+				ToCSVFile += TEXT("AssetPath\n");
+				for (int32 i = 0; i < Result.Groups.Num(); ++i)
+				{
+					const FGroup& Group = Result.Groups[i];
+					for (int32 Member = Group.FirstMember; Member < Group.FirstMember + Group.NumMembers; ++Member)
+					{
+						const int32 Row = Result.Members[Member];
+						const FExporterHelper::FSceneTextureDataSet& Texture = Rows[Row];
+						ToCSVFile += FString::FromInt(i) + ",";
+						InOutContext.StringPool.AppendTo(ToCSVFile, Texture.Name) += ",";
+						ToCSVFile += Row == Group.KeptRow ? TEXT("True,") : TEXT("False,");
+						ToCSVFile += Texture.SourceSize + ",";
+						ToCSVFile += Texture.SourceFormat + ",";
+						ToCSVFile += Texture.PixelFormat + ",";
+						FFloatFormatter::Append(ToCSVFile, Texture.FullyLoadedKB, Precisions.KB) += ",";
+						ToCSVFile += FString::FromInt(Texture.NumRefs) + ",";
+						InOutContext.StringPool.AppendTo(ToCSVFile, Texture.AssetPath) += "\n";
+					}
+				}
+
+				OutCSVStrings.Add("DuplicateTextures", ToCSVFile);
+			}
+		}
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[Texture Duplicates] %d groups by %s hash, %.1f KB reclaimable, %d textures hashed, %d from the asset cache, %.2f s."),
+			Result.Groups.Num(), Settings.bPerceptualTextureHash ? TEXT("perceptual") : TEXT("exact"), NumReclaimableKB, Result.NumHashed, Result.NumCached, Result.Seconds));
+	}
+
+private:
+
+	static bool LoadHash(FAssetAnalysisCache& InCache, const UTexture* InTexture, FTextureHash& OutHash)
+	{
+		const TArray<uint8>* CachedData = InCache.Find(TEXT("TextureHash"), InTexture);
+		if (!CachedData)
+			return false;
+
+		uint8 bHasPerceptualHash = 0;
+		FMemoryReader Reader(*CachedData);
+		Reader << OutHash.ContentHash << OutHash.PerceptualHash << bHasPerceptualHash;
+		OutHash.bHasPerceptualHash = bHasPerceptualHash;
+		OutHash.bValid = !Reader.IsError();
+		return OutHash.bValid;
+	}
+
+	static void StoreHash(FAssetAnalysisCache& InOutCache, const UTexture* InTexture, const FTextureHash& InHash)
+	{
+		if (!InHash.bValid)
+			return;
+
+		FBufferArchive Writer;
+		uint64 ContentHash = InHash.ContentHash, PerceptualHash = InHash.PerceptualHash;
+		uint8 bHasPerceptualHash = InHash.bHasPerceptualHash;
+		Writer << ContentHash << PerceptualHash << bHasPerceptualHash;
+		InOutCache.Add(TEXT("TextureHash"), InTexture, MoveTemp(Writer));
+	}
+
+	static void ComputeHash(const FTextureSource& InSource, const uint8* InMipData, int64 InMipBytes, FTextureHash& OutHash)
+	{
+		const int32 SizeX = InSource.GetSizeX();
+		const int32 SizeY = InSource.GetSizeY();
+		const ETextureSourceFormat Format = InSource.GetFormat();
+
+		// Same bytes in another size or format are another image...
+		const uint64 Seed = (uint64)SizeX | ((uint64)SizeY << 24) | ((uint64)Format << 48);
+		OutHash.ContentHash = CityHash64WithSeed((const char*)InMipData, (uint32)InMipBytes, Seed);
+		OutHash.bValid = 1;
+
+		OutHash.bHasPerceptualHash = 0;
+		OutHash.PerceptualHash = 0;
+		if (SizeX <= 0 || SizeY <= 0 || !IsPerceptualFormat(Format))
+			return;
+
+		// 9x8 thumbnail, 4x4 samples per cell...First slice of cubes...
+		const int32 SamplesPerCell = 4;
+		float Thumbnail[8][9];
+		for (int32 CellY = 0; CellY < 8; ++CellY)
+		{
+			for (int32 CellX = 0; CellX < 9; ++CellX)
+			{
+				float Sum = 0.f;
+				for (int32 SampleY = 0; SampleY < SamplesPerCell; ++SampleY)
+				{
+					const int32 Y = FMath::Min((int32)((CellY * SamplesPerCell + SampleY + 0.5f) * SizeY / (8 * SamplesPerCell)), SizeY - 1);
+					for (int32 SampleX = 0; SampleX < SamplesPerCell; ++SampleX)
+					{
+						const int32 X = FMath::Min((int32)((CellX * SamplesPerCell + SampleX + 0.5f) * SizeX / (9 * SamplesPerCell)), SizeX - 1);
+						Sum += GetGray(InMipData, Format, (int64)Y * SizeX + X);
+					}
+				}
+				Thumbnail[CellY][CellX] = Sum;
+			}
+		}
+
+		// One bit per horizontal neighbour pair...
+		uint64 Hash = 0;
+		for (int32 CellY = 0; CellY < 8; ++CellY)
+		{
+			for (int32 CellX = 0; CellX < 8; ++CellX)
+			{
+				if (Thumbnail[CellY][CellX] < Thumbnail[CellY][CellX + 1])
+					Hash |= 1ull << (CellY * 8 + CellX);
+			}
+		}
+
+		OutHash.PerceptualHash = Hash;
+		OutHash.bHasPerceptualHash = 1;
+	}
+
+	static bool IsPerceptualFormat(ETextureSourceFormat InFormat)
+	{
+		return InFormat == TSF_G8 || InFormat == TSF_BGRA8 || InFormat == TSF_BGRE8 || InFormat == TSF_RGBA16 || InFormat == TSF_RGBA16F;
+	}
+
+	/** Luma in 0..255...HDR sources are not tone mapped... */
+	static float GetGray(const uint8* InMipData, ETextureSourceFormat InFormat, int64 InPixel)
+	{
+		switch (InFormat)
+		{
+		case TSF_G8:
+			return InMipData[InPixel];
+		case TSF_BGRA8:
+		case TSF_BGRE8:
+		{
+			const uint8* Pixel = InMipData + InPixel * 4;
+			return 0.114f * Pixel[0] + 0.587f * Pixel[1] + 0.299f * Pixel[2];
+		}
+		case TSF_RGBA16:
+		{
+			const uint16* Pixel = (const uint16*)InMipData + InPixel * 4;
+			return (0.299f * Pixel[0] + 0.587f * Pixel[1] + 0.114f * Pixel[2]) / 257.f;
+		}
+		case TSF_RGBA16F:
+		{
+			const FFloat16* Pixel = (const FFloat16*)InMipData + InPixel * 4;
+			return (0.299f * Pixel[0].GetFloat() + 0.587f * Pixel[1].GetFloat() + 0.114f * Pixel[2].GetFloat()) * 255.f;
+		}
+		default:
+			return 0.f;
+		}
+	}
+
+	static int32 FindRoot(TArray<int32>& InOutParents, int32 InRow)
+	{
+		while (InOutParents[InRow] != InRow)
+		{
+			InOutParents[InRow] = InOutParents[InOutParents[InRow]];
+			InRow = InOutParents[InRow];
+		}
+		return InRow;
+	}
+};
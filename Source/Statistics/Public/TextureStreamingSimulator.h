@@ -0,0 +1,286 @@
+// ...
+
+#pragma once
+
+#include "ExporterHelper.h"
+#include "Async/ParallelFor.h"
+
+/** Offline texture streaming estimate from the exported tables...Tune the pool without running the game on target hardware... */
+class FTextureStreamingSimulator
+{
+public:
+
+	/** Streaming state of all textures seen from one view point... */
+	struct FViewResult
+	{
+		FVector ViewPoint;
+		float   RequiredKB;
+		float   OverBudgetKB;
+		int32   NumWantedTextures;
+		int32   NumOverBudget;
+
+		TArray<float> ScreenPixels; // Per texture...Largest user on screen...
+		TArray<float> WantedKB;		// Per texture...
+		TArray<uint8> WantedMips;	// Per texture...
+		TBitArray<>   OverBudget;	// Per texture...
+	};
+
+	/** Per texture summary of all view points... */
+	struct FTextureResult
+	{
+		float MaxScreenPixels;
+		float MaxWantedKB;
+		uint8 MaxWantedMips;
+		int32 NumViewsOverBudget;
+	};
+
+	/** Texture -> bounds of the primitives using it...Flat arrays, UsersOffsets has one more elem than TexturesTable... */
+	static void BuildTextureUsers(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FIndexPool& InIndexPool, TArray<int32>& OutUsersOffsets, TArray<int32>& OutUsersBounds)
+	{
+		TArray<TPair<int32, int32>> TextureBoundsPairs;
+		TArray<int32> RowTextures;
+
+		auto AddRowTextures = [&InSceneDataSet, &InIndexPool, &RowTextures](const FIndexSpan& InUsedMaterialsIndices, const FIndexSpan& InUsedMaterialIntancesIndices)
+		{
+			RowTextures.Reset();
+			for (int32 MaterialIndex : InIndexPool[InUsedMaterialsIndices])
+				for (int32 TextureIndex : InIndexPool[InSceneDataSet.MaterialsTable[MaterialIndex].UsedTexturesIndices])
+					RowTextures.AddUnique(TextureIndex);
+			for (int32 MaterialInsIndex : InIndexPool[InUsedMaterialIntancesIndices])
+				for (int32 TextureIndex : InIndexPool[InSceneDataSet.MaterialInstancesTable[MaterialInsIndex].UsedTexturesIndices])
+					RowTextures.AddUnique(TextureIndex);
+		};
+
+		for (TArray<FExporterHelper::FSceneStaticMeshDataSet>::TConstIterator It(InSceneDataSet.StaticMeshesTable); It; ++It)
+		{
+			AddRowTextures((*It).UsedMaterialsIndices, (*It).UsedMaterialIntancesIndices);
+			for (TArray<int32>::TConstIterator It_Tex(RowTextures); It_Tex; ++It_Tex)
+				for (int32 BoundsIndex : InIndexPool[(*It).BoundsIndices])
+					TextureBoundsPairs.Add(TPair<int32, int32>(*It_Tex, BoundsIndex));
+		}
+		for (TArray<FExporterHelper::FSceneSkeletalMeshDataSet>::TConstIterator It(InSceneDataSet.SkeletalMeshesTable); It; ++It)
+		{
+			AddRowTextures((*It).UsedMaterialsIndices, (*It).UsedMaterialIntancesIndices);
+			for (TArray<int32>::TConstIterator It_Tex(RowTextures); It_Tex; ++It_Tex)
+				TextureBoundsPairs.Add(TPair<int32, int32>(*It_Tex, (*It).BoundsIndex));
+		}
+
+		// Counting sort by texture...
+		const int32 NumTextures = InSceneDataSet.TexturesTable.Num();
+		OutUsersOffsets.Reset();
+		OutUsersOffsets.AddZeroed(NumTextures + 1);
+		for (TArray<TPair<int32, int32>>::TConstIterator It(TextureBoundsPairs); It; ++It)
+			OutUsersOffsets[(*It).Key + 1]++;
+		for (int32 i = 0; i < NumTextures; ++i)
+			OutUsersOffsets[i + 1] += OutUsersOffsets[i];
+
+		TArray<int32> WriteOffsets = OutUsersOffsets;
+		OutUsersBounds.Reset();
+		OutUsersBounds.AddUninitialized(TextureBoundsPairs.Num());
+		for (TArray<TPair<int32, int32>>::TConstIterator It(TextureBoundsPairs); It; ++It)
+			OutUsersBounds[WriteOffsets[(*It).Key]++] = (*It).Value;
+	}
+
+	/** Camera path of the settings sampled every StreamingPathStep...Center of the scene when none is configured... */
+	static void GetViewPoints(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FExporterHelper::FExportSettings& InSettings, TArray<FVector>& OutViewPoints)
+	{
+		OutViewPoints.Reset();
+
+		const TArray<FVector>& PathPoints = InSettings.StreamingViewPoints;
+		if (PathPoints.Num() == 0)
+		{
+			FBox SceneBox(EForceInit::ForceInit);
+			for (TArray<FBoxSphereBounds>::TConstIterator It(InSceneDataSet.BoundsTable); It; ++It)
+				SceneBox += (*It).GetBox();
+			OutViewPoints.Add(SceneBox.IsValid ? SceneBox.GetCenter() : FVector::ZeroVector);
+			return;
+		}
+
+		OutViewPoints.Add(PathPoints[0]);
+		const float PathStep = FMath::Max(InSettings.StreamingPathStep, 1.f);
+		for (int32 i = 1; i < PathPoints.Num(); ++i)
+		{
+			const float SegmentLength = FVector::Dist(PathPoints[i - 1], PathPoints[i]);
+			const int32 NumSteps = FMath::Max(1, FMath::CeilToInt(SegmentLength / PathStep));
+			for (int32 Step = 1; Step <= NumSteps; ++Step)
+				OutViewPoints.Add(FMath::Lerp(PathPoints[i - 1], PathPoints[i], (float)Step / NumSteps));
+		}
+	}
+
+	/** Largest mip allowed (LOD bias applied) of a texture row and its number of mips... */
+	static void GetStreamingMips(const FExporterHelper::FSceneTextureDataSet& InTexture, float& OutMaxSize, int32& OutMaxMips)
+	{
+		const int32 CurrentSize = FMath::Max(InTexture.CurrentSizeX, InTexture.CurrentSizeY);
+		OutMaxMips = FMath::Max<int32>(InTexture.NumMipsAllowed, 1);
+		OutMaxSize = (float)CurrentSize * FMath::Pow(2.f, (float)FMath::Max(0, (int32)InTexture.NumMipsAllowed - (int32)InTexture.NumResidentMips));
+	}
+
+	static void SimulateView(const FExporterHelper::FSceneDataSet& InSceneDataSet, const FExporterHelper::FExportSettings& InSettings, const TArray<int32>& InUsersOffsets, const TArray<int32>& InUsersBounds, FViewResult& OutView)
+	{
+		const TArray<FExporterHelper::FSceneTextureDataSet>& Textures = InSceneDataSet.TexturesTable;
+		const TArray<FBoxSphereBounds>& Bounds = InSceneDataSet.BoundsTable;
+		const int32 NumTextures = Textures.Num();
+
+		// Screen pixels covered by a bounds of SphereRadius...Distance is taken to the sphere, not its center...
+		const float PixelsPerUnitAtOne = InSettings.StreamingScreenHeight / FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(InSettings.StreamingFOV, 1.f, 170.f) * 0.5f));
+
+		OutView.ScreenPixels.Init(0.f, NumTextures);
+		OutView.WantedKB.Init(0.f, NumTextures);
+		OutView.WantedMips.Init(0, NumTextures);
+		OutView.OverBudget.Init(false, NumTextures);
+		OutView.RequiredKB = 0.f;
+		OutView.OverBudgetKB = 0.f;
+		OutView.NumWantedTextures = 0;
+		OutView.NumOverBudget = 0;
+
+		TArray<int32> WantedTextures;
+		for (int32 TexIndex = 0; TexIndex < NumTextures; ++TexIndex)
+		{
+			if (InUsersOffsets[TexIndex] == InUsersOffsets[TexIndex + 1]) continue;
+
+			float ScreenPixels = 0.f;
+			for (int32 UserIndex = InUsersOffsets[TexIndex]; UserIndex < InUsersOffsets[TexIndex + 1]; ++UserIndex)
+			{
+				const FBoxSphereBounds& UserBounds = Bounds[InUsersBounds[UserIndex]];
+				const float Distance = FMath::Max(FVector::Dist(OutView.ViewPoint, UserBounds.Origin) - UserBounds.SphereRadius, 1.f);
+				ScreenPixels = FMath::Max(ScreenPixels, PixelsPerUnitAtOne * UserBounds.SphereRadius / Distance);
+			}
+
+			const FExporterHelper::FSceneTextureDataSet& Texture = Textures[TexIndex];
+			float MaxSize; int32 MaxMips;
+			GetStreamingMips(Texture, MaxSize, MaxMips);
+
+			// Only 2D textures stream...Assume one texture repeat across the primitive bounds...
+			int32 DroppedMips = 0;
+			if (Texture.Type == TEXT("2D") && ScreenPixels < MaxSize)
+				DroppedMips = FMath::Clamp(FMath::FloorToInt(FMath::Log2(MaxSize / FMath::Max(ScreenPixels, 1.f))), 0, MaxMips - 1);
+
+			OutView.ScreenPixels[TexIndex] = ScreenPixels;
+			OutView.WantedMips[TexIndex] = (uint8)(MaxMips - DroppedMips);
+			OutView.WantedKB[TexIndex] = Texture.FullyLoadedKB / FMath::Pow(4.f, (float)DroppedMips);
+			OutView.RequiredKB += OutView.WantedKB[TexIndex];
+			WantedTextures.Add(TexIndex);
+		}
+		OutView.NumWantedTextures = WantedTextures.Num();
+
+		// Fill the pool by screen size...Whatever does not fit is over budget...
+		const float PoolKB = InSettings.StreamingPoolSizeMB * 1024.f;
+		if (OutView.RequiredKB > PoolKB)
+		{
+			const TArray<float>& ScreenPixels = OutView.ScreenPixels;
+			WantedTextures.Sort([&ScreenPixels](const int32 A, const int32 B) { return ScreenPixels[A] > ScreenPixels[B]; });
+
+			float PoolUsedKB = 0.f;
+			for (TArray<int32>::TConstIterator It(WantedTextures); It; ++It)
+			{
+				if (PoolUsedKB + OutView.WantedKB[*It] <= PoolKB)
+				{
+					PoolUsedKB += OutView.WantedKB[*It];
+				}
+				else
+				{
+					OutView.OverBudget[*It] = true;
+					OutView.OverBudgetKB += OutView.WantedKB[*It];
+					OutView.NumOverBudget++;
+				}
+			}
+		}
+	}
+
+	static void PrintTextureStreamingToCSVString(const FExporterHelper::FSceneDataSet& InSceneDataSet, FExporterHelper::FExportContext& InOutContext, TMap<FString, FString>& OutCSVStrings)
+	{
+		const FExporterHelper::FExportSettings& Settings = InOutContext.Settings;
+		const FFloatFormatter::FPrecisions& Precisions = Settings.FloatPrecisions;
+		const TArray<FExporterHelper::FSceneTextureDataSet>& Textures = InSceneDataSet.TexturesTable;
+		if (!Textures.IsValidIndex(0) || !InSceneDataSet.BoundsTable.IsValidIndex(0))
+			return;
+
+		TArray<int32> UsersOffsets;
+		TArray<int32> UsersBounds;
+		BuildTextureUsers(InSceneDataSet, InOutContext.IndexPool, UsersOffsets, UsersBounds);
+
+		TArray<FVector> ViewPoints;
+		GetViewPoints(InSceneDataSet, Settings, ViewPoints);
+
+		// View points are independent...
+		TArray<FViewResult> Views;
+		Views.AddDefaulted(ViewPoints.Num());
+		ParallelFor(Views.Num(), [&](int32 ViewIndex)
+		{
+			Views[ViewIndex].ViewPoint = ViewPoints[ViewIndex];
+			SimulateView(InSceneDataSet, Settings, UsersOffsets, UsersBounds, Views[ViewIndex]);
+		});
+
+		TArray<FTextureResult> TextureResults;
+		TextureResults.AddZeroed(Textures.Num());
+		float MaxRequiredKB = 0.f;
+		for (TArray<FViewResult>::TConstIterator It(Views); It; ++It)
+		{
+			const FViewResult& View = (*It);
+			MaxRequiredKB = FMath::Max(MaxRequiredKB, View.RequiredKB);
+			for (int32 TexIndex = 0; TexIndex < Textures.Num(); ++TexIndex)
+			{
+				FTextureResult& Result = TextureResults[TexIndex];
+				Result.MaxScreenPixels = FMath::Max(Result.MaxScreenPixels, View.ScreenPixels[TexIndex]);
+				Result.MaxWantedKB = FMath::Max(Result.MaxWantedKB, View.WantedKB[TexIndex]);
+				Result.MaxWantedMips = FMath::Max(Result.MaxWantedMips, View.WantedMips[TexIndex]);
+				Result.NumViewsOverBudget += View.OverBudget[TexIndex] ? 1 : 0;
+			}
+		}
+
+		// TextureStreamingViews...
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,");
+			ToCSVFile += TEXT("ViewX,"); ToCSVFile += TEXT("ViewY,"); ToCSVFile += TEXT("ViewZ,");
+			ToCSVFile += TEXT("RequiredKB,"); ToCSVFile += TEXT("PoolKB,"); ToCSVFile += TEXT("OverBudgetKB,");
+			ToCSVFile += TEXT("NumTextures,"); ToCSVFile += TEXT("NumOverBudget\n");
+			for (int32 i = 0; i < Views.Num(); ++i)
+			{
+				ToCSVFile += FString::FromInt(i) + ",";
+				FFloatFormatter::Append(ToCSVFile, Views[i].ViewPoint.X, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Views[i].ViewPoint.Y, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Views[i].ViewPoint.Z, Precisions.Bounds) += ",";
+				FFloatFormatter::Append(ToCSVFile, Views[i].RequiredKB, Precisions.KB) += ",";
+				FFloatFormatter::Append(ToCSVFile, Settings.StreamingPoolSizeMB * 1024.f, Precisions.KB) += ",";
+				FFloatFormatter::Append(ToCSVFile, Views[i].OverBudgetKB, Precisions.KB) += ",";
+				ToCSVFile += FString::FromInt(Views[i].NumWantedTextures) + ",";
+				ToCSVFile += FString::FromInt(Views[i].NumOverBudget) + "\n";
+			}
+
+			OutCSVStrings.Add("TextureStreamingViews", ToCSVFile);
+		}
+
+		// TextureStreamingTable...
+		int32 NumOverBudgetTextures = 0;
+		{
+			FString ToCSVFile;
+			ToCSVFile += TEXT("Id,"); ToCSVFile += TEXT("Name,"); ToCSVFile += TEXT("Type,");
+			ToCSVFile += TEXT("NumMipsAllowed,"); ToCSVFile += TEXT("MaxWantedMips,");
+			ToCSVFile += TEXT("MaxScreenPixels,"); ToCSVFile += TEXT("FullyLoadedKB,"); ToCSVFile += TEXT("MaxWantedKB,");
+			ToCSVFile += TEXT("NumViewsOverBudget,"); ToCSVFile += TEXT("AssetPath\n");
+			for (int32 i = 0; i < Textures.Num(); ++i)
+			{
+				if (UsersOffsets[i] == UsersOffsets[i + 1]) continue;
+
+				ToCSVFile += FString::FromInt(i) + ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, Textures[i].Name) += ",";
+				ToCSVFile += Textures[i].Type + ",";
+				ToCSVFile += FString::FromInt(Textures[i].NumMipsAllowed) + ",";
+				ToCSVFile += FString::FromInt(TextureResults[i].MaxWantedMips) + ",";
+				FFloatFormatter::Append(ToCSVFile, TextureResults[i].MaxScreenPixels, Precisions.Default) += ",";
+				FFloatFormatter::Append(ToCSVFile, Textures[i].FullyLoadedKB, Precisions.KB) += ",";
+				FFloatFormatter::Append(ToCSVFile, TextureResults[i].MaxWantedKB, Precisions.KB) += ",";
+				ToCSVFile += FString::FromInt(TextureResults[i].NumViewsOverBudget) + ",";
+				InOutContext.StringPool.AppendTo(ToCSVFile, Textures[i].AssetPath) += "\n";
+
+				NumOverBudgetTextures += TextureResults[i].NumViewsOverBudget > 0 ? 1 : 0;
+			}
+
+			OutCSVStrings.Add("TextureStreamingTable", ToCSVFile);
+		}
+
+		InOutContext.Notes.Add(FString::Printf(TEXT("[Texture Streaming] %d view points, required pool %.1f MB (pool %.1f MB), %d textures over budget."),
+			Views.Num(), MaxRequiredKB / 1024.f, Settings.StreamingPoolSizeMB, NumOverBudgetTextures));
+	}
+};
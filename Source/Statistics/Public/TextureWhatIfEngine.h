@@ -0,0 +1,192 @@
+// ...
+
+#pragma once
+
+#include "PixelFormat.h"
+#include "Engine/TextureDefines.h"
+#include "Async/ParallelFor.h"
+
+// Skipped rules of [TextureWhatIf]...Defined in Statistics.cpp...
+DECLARE_LOG_CATEGORY_EXTERN(LogTextureWhatIf, Log, All);
+
+/** Projected texture memory under user scenarios of format, max size and LOD bias per texture group... */
+class FTextureWhatIfEngine
+{
+public:
+
+	/** One line of [TextureWhatIf] Rules: Scenario,Group,Format,MaxSize,LODBias...Group "All" is the default rule... */
+	struct FRule
+	{
+		int32		LODGroup; // INDEX_NONE is all groups...
+		EPixelFormat Format;
+		int32		MaxSize;  // 0 is unlimited...
+		int32		LODBias;  // Negative keeps the LOD bias of the texture...
+	};
+
+	struct FScenario
+	{
+		FString		  Name;
+		TArray<FRule> Rules;
+	};
+
+	/** Flat dimensions of all evaluated textures...One elem per texture in every array... */
+	struct FTextureDimensions
+	{
+		TArray<uint16> SizeX;
+		TArray<uint16> SizeY;
+		TArray<uint8>  NumMips;
+		TArray<uint8>  NumFaces;
+		TArray<uint8>  LODBias;
+		TArray<uint8>  LODGroup;
+
+		int32 Num() const { return SizeX.Num(); }
+
+		void Reserve(int32 InNum)
+		{
+			SizeX.Reserve(InNum); SizeY.Reserve(InNum); NumMips.Reserve(InNum);
+			NumFaces.Reserve(InNum); LODBias.Reserve(InNum); LODGroup.Reserve(InNum);
+		}
+
+		void Add(uint16 InSizeX, uint16 InSizeY, uint8 InNumMips, uint8 InNumFaces, uint8 InLODBias, uint8 InLODGroup)
+		{
+			SizeX.Add(InSizeX); SizeY.Add(InSizeY); NumMips.Add(InNumMips);
+			NumFaces.Add(InNumFaces); LODBias.Add(InLODBias); LODGroup.Add(InLODGroup);
+		}
+	};
+
+	/** Totals of one texture table...Kept out of the per texture rows, see FSceneAnalysisHelper::PrintTextureWhatIfTotalsToCSVString()... */
+	struct FTotals
+	{
+		double		   CurrentKB = 0.0;
+		double		   FullyLoadedKB = 0.0;
+		TArray<double> ScenariosKB;
+	};
+
+	/** Same columns as the fixed special format sizes of the texture tables before... */
+	static void GetDefaultScenarios(TArray<FScenario>& OutScenarios)
+	{
+		const EPixelFormat Formats[] = { PF_PVRTC2, PF_PVRTC4, PF_ASTC_4x4, PF_ASTC_6x6, PF_ASTC_8x8, PF_ASTC_10x10, PF_ASTC_12x12 };
+
+		OutScenarios.Empty();
+		for (int32 i = 0; i < UE_ARRAY_COUNT(Formats); ++i)
+		{
+			FScenario& Scenario = OutScenarios.AddDefaulted_GetRef();
+			Scenario.Name = FString(GPixelFormats[Formats[i]].Name);
+			Scenario.Rules.Add({ INDEX_NONE, Formats[i], 0, -1 });
+		}
+	}
+
+	static void ParseScenarios(const TArray<FString>& InRuleLines, TArray<FScenario>& OutScenarios)
+	{
+		static const UEnum* PixelFormatEnum = StaticEnum<EPixelFormat>();
+		static const UEnum* TextureGroupEnum = StaticEnum<TextureGroup>();
+
+		OutScenarios.Empty();
+		for (TArray<FString>::TConstIterator It(InRuleLines); It; ++It)
+		{
+			TArray<FString> Fields;
+			(*It).ParseIntoArray(Fields, TEXT(","));
+			if (Fields.Num() < 3) continue;
+			for (TArray<FString>::TIterator It_Field(Fields); It_Field; ++It_Field)
+				(*It_Field).TrimStartAndEndInline();
+
+			// Unknown names are skipped...A typo must not turn into a rule of all groups...
+			const int64 Format = PixelFormatEnum->GetValueByNameString(Fields[2]);
+			const int64 LODGroup = Fields[1] == TEXT("All") ? INDEX_NONE : TextureGroupEnum->GetValueByNameString(Fields[1]);
+			if (Format == INDEX_NONE || (LODGroup == INDEX_NONE && Fields[1] != TEXT("All")))
+			{
+				UE_LOG(LogTextureWhatIf, Warning, TEXT("Skipped rule \"%s\", unknown %s \"%s\"."),
+					*(*It), Format == INDEX_NONE ? TEXT("format") : TEXT("LOD group"), Format == INDEX_NONE ? *Fields[2] : *Fields[1]);
+				continue;
+			}
+
+			FRule Rule;
+			Rule.LODGroup = (int32)LODGroup;
+			Rule.Format = (EPixelFormat)Format;
+			Rule.MaxSize = Fields.Num() > 3 ? FCString::Atoi(*Fields[3]) : 0;
+			Rule.LODBias = Fields.Num() > 4 ? FCString::Atoi(*Fields[4]) : -1;
+
+			FScenario* Scenario = OutScenarios.FindByPredicate([&Fields](const FScenario& InScenario) { return InScenario.Name == Fields[0]; });
+			if (!Scenario)
+			{
+				Scenario = &OutScenarios.AddDefaulted_GetRef();
+				Scenario->Name = Fields[0];
+			}
+			Scenario->Rules.Add(Rule);
+		}
+	}
+
+	/** Evaluate all scenarios over all textures...OutKB is scenario major, [ScenarioIndex * NumTextures + TextureIndex]... */
+	static void Evaluate(const FTextureDimensions& InTextures, const TArray<FScenario>& InScenarios, TArray<float>& OutKB, TArray<double>& OutTotalsKB)
+	{
+		const int32 NumTextures = InTextures.Num();
+		OutKB.SetNumUninitialized(NumTextures * InScenarios.Num());
+		OutTotalsKB.SetNumZeroed(InScenarios.Num());
+
+		ParallelFor(InScenarios.Num(), [&](int32 ScenarioIndex)
+		{
+			// Resolve the rules of every group once...Group specific rules win over the "All" rule...
+			FRule RulesByGroup[TEXTUREGROUP_MAX];
+			for (int32 Group = 0; Group < TEXTUREGROUP_MAX; ++Group)
+				RulesByGroup[Group] = { INDEX_NONE, PF_Unknown, 0, -1 };
+			for (TArray<FRule>::TConstIterator It(InScenarios[ScenarioIndex].Rules); It; ++It)
+			{
+				for (int32 Group = 0; Group < TEXTUREGROUP_MAX; ++Group)
+				{
+					if ((*It).LODGroup == Group || ((*It).LODGroup == INDEX_NONE && RulesByGroup[Group].LODGroup == INDEX_NONE))
+						RulesByGroup[Group] = (*It);
+				}
+			}
+
+			float* ScenarioKB = OutKB.GetData() + (int64)ScenarioIndex * NumTextures;
+			double TotalKB = 0.0;
+			for (int32 i = 0; i < NumTextures; ++i)
+			{
+				const FRule& Rule = RulesByGroup[FMath::Min<int32>(InTextures.LODGroup[i], TEXTUREGROUP_MAX - 1)];
+				if (Rule.Format == PF_Unknown)
+				{
+					ScenarioKB[i] = 0.f;
+					continue;
+				}
+
+				ScenarioKB[i] = CalcTextureKB(InTextures.SizeX[i], InTextures.SizeY[i], InTextures.NumMips[i], InTextures.NumFaces[i],
+					Rule.LODBias < 0 ? InTextures.LODBias[i] : Rule.LODBias, Rule.MaxSize, Rule.Format);
+				TotalKB += ScenarioKB[i];
+			}
+			OutTotalsKB[ScenarioIndex] = TotalKB;
+		});
+	}
+
+	/** Block compressed mip chain size...Same result as ::CalcTextureSize, without the per call format lookups of the RHI... */
+	static FORCEINLINE float CalcTextureKB(uint32 SizeX, uint32 SizeY, uint32 NumMips, uint32 NumFaces, uint32 LODBias, uint32 MaxSize, EPixelFormat Format)
+	{
+		const FPixelFormatInfo& FormatInfo = GPixelFormats[Format];
+		const uint32 BlockSizeX = FormatInfo.BlockSizeX;
+		const uint32 BlockSizeY = FormatInfo.BlockSizeY;
+		const uint32 BlockBytes = FormatInfo.BlockBytes;
+		const bool bIsPVRTC = Format == PF_PVRTC2 || Format == PF_PVRTC4;
+
+		// Drop mips for LOD bias and max size...Keep at least one...
+		uint32 DroppedMips = LODBias;
+		const uint32 Size = FMath::Max(SizeX, SizeY);
+		if (MaxSize > 0 && Size > MaxSize)
+			DroppedMips = FMath::Max(DroppedMips, FMath::CeilLogTwo(FMath::DivideAndRoundUp(Size, MaxSize)));
+		DroppedMips = FMath::Min(DroppedMips, FMath::Max(NumMips, 1u) - 1);
+
+		uint64 Bytes = 0;
+		for (uint32 Mip = DroppedMips; Mip < NumMips; ++Mip)
+		{
+			uint32 MipSizeX = FMath::Max(SizeX >> Mip, 1u);
+			uint32 MipSizeY = FMath::Max(SizeY >> Mip, 1u);
+			if (bIsPVRTC)
+			{
+				// PVRTC mips are at least two blocks wide and high...
+				MipSizeX = FMath::Max(MipSizeX, BlockSizeX * 2);
+				MipSizeY = FMath::Max(MipSizeY, BlockSizeY * 2);
+			}
+			Bytes += (uint64)FMath::DivideAndRoundUp(MipSizeX, BlockSizeX) * FMath::DivideAndRoundUp(MipSizeY, BlockSizeY) * BlockBytes;
+		}
+
+		return (float)(Bytes * NumFaces) / 1024.0f;
+	}
+};
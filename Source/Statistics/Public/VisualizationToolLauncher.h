@@ -0,0 +1,128 @@
+// ...
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/FileManager.h"
+#include "Containers/Ticker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/** Starts the viewer without blocking the editor...
+ *
+ *  The command line comes from the [VisualizationTool] template, {Dir} and {Scale} are replaced...
+ *  With SharedMemory the last exported World tables (same bytes as <World>_Tables.stb) are written to a file under
+ *  Saved/Statistics that the viewer maps, and -tables [Path] is appended, see StatisticsReader::FTableFile::ParseTablesArgument()...
+ *  A file has the same name in both processes on every platform...Named regions do not, on Windows they are created as
+ *  Global\ names that need SeCreateGlobalPrivilege...The pages stay in the file cache, the viewer still reads no CSV...
+ *  The file lives until the viewer exits, a ticker polls the process and deletes it...
+ */
+class FVisualizationToolLauncher
+{
+public:
+
+	struct FSettings
+	{
+		FString Executable;
+		FString Arguments;
+		bool bSharedMemory;
+
+		FSettings() : Executable(GetDefaultExecutable()), Arguments(TEXT("-dir [{Dir}] -scale [{Scale}]")), bSharedMemory(true) {}
+
+		void LoadConfig(const FString& InConfigFile)
+		{
+			FString ConfigExecutable;
+			if (GConfig->GetString(TEXT("VisualizationTool"), TEXT("Executable"), ConfigExecutable, InConfigFile) && !ConfigExecutable.TrimStartAndEnd().IsEmpty())
+				Executable = ConfigExecutable.TrimStartAndEnd();
+			GConfig->GetString(TEXT("VisualizationTool"), TEXT("Arguments"), Arguments, InConfigFile);
+			GConfig->GetBool(TEXT("VisualizationTool"), TEXT("SharedMemory"), bSharedMemory, InConfigFile);
+		}
+	};
+
+	static FString GetDefaultExecutable()
+	{
+#if PLATFORM_WINDOWS
+		return TEXT("D3DVisualizationTool.exe");
+#else
+		return TEXT("D3DVisualizationTool");
+#endif
+	}
+
+	/** Returns right after the process is created...InTables may be empty, the viewer then reads the CSV files of InDataDir... */
+	static bool Launch(const FString& InToolDir, const FSettings& InSettings, const FString& InDataDir, float InScale, const TArray<uint8>& InTables, FString& OutError)
+	{
+		const FString ExecutablePath = FPaths::ConvertRelativePathToFull(InToolDir / InSettings.Executable);
+		if (!FPaths::FileExists(ExecutablePath))
+		{
+			OutError = FString::Printf(TEXT("Visualization tool not found: %s"), *ExecutablePath);
+			return false;
+		}
+
+		FStringFormatNamedArguments NamedArguments;
+		NamedArguments.Add(TEXT("Dir"), InDataDir);
+		NamedArguments.Add(TEXT("Scale"), FString::SanitizeFloat(InScale));
+		FString Arguments = FString::Format(*InSettings.Arguments, NamedArguments);
+
+		FString TablesFilePath;
+		if (InSettings.bSharedMemory && InTables.Num() > 0)
+		{
+			const FString TablesDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Statistics"));
+			DeleteStaleTablesFiles(TablesDir);
+
+			static int32 NumLaunches = 0;
+			TablesFilePath = TablesDir / FString::Printf(TEXT("StatisticsTables_%u_%d.stb"), FPlatformProcess::GetCurrentProcessId(), NumLaunches++);
+			if (FFileHelper::SaveArrayToFile(InTables, *TablesFilePath))
+			{
+				Arguments += FString::Printf(TEXT(" -tables [%s]"), *TablesFilePath);
+			}
+			else
+			{
+				// Not fatal...The viewer still has the CSV files...
+				OutError = FString::Printf(TEXT("Can not write %s, the viewer reads the CSV files"), *TablesFilePath);
+				TablesFilePath.Empty();
+			}
+		}
+
+		FProcHandle ProcHandle = FPlatformProcess::CreateProc(*ExecutablePath, *Arguments, true, false, false, nullptr, 0, *FPaths::GetPath(ExecutablePath), nullptr);
+		if (!ProcHandle.IsValid())
+		{
+			if (!TablesFilePath.IsEmpty())
+				IFileManager::Get().Delete(*TablesFilePath, false, false, true);
+			OutError = FString::Printf(TEXT("Can not start %s %s"), *ExecutablePath, *Arguments);
+			return false;
+		}
+
+		// Handle kept only to delete the file...
+		if (TablesFilePath.IsEmpty())
+		{
+			FPlatformProcess::CloseProc(ProcHandle);
+			return true;
+		}
+
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([ProcHandle, TablesFilePath](float) mutable
+		{
+			if (FPlatformProcess::IsProcRunning(ProcHandle))
+				return true;
+
+			FPlatformProcess::CloseProc(ProcHandle);
+			IFileManager::Get().Delete(*TablesFilePath, false, false, true);
+			return false;
+		}), 1.0f);
+
+		return true;
+	}
+
+	/** Files left by editors that exited before their viewer...Files still mapped can not be deleted on Windows, unlinking keeps the mapping elsewhere... */
+	static void DeleteStaleTablesFiles(const FString& InTablesDir)
+	{
+		TArray<FString> FileNames;
+		IFileManager::Get().FindFiles(FileNames, *(InTablesDir / TEXT("StatisticsTables_*.stb")), true, false);
+		for (TArray<FString>::TConstIterator It(FileNames); It; ++It)
+		{
+			const FString FilePath = InTablesDir / (*It);
+			if (FDateTime::UtcNow() - IFileManager::Get().GetTimeStamp(*FilePath) > FTimespan::FromHours(1.0))
+				IFileManager::Get().Delete(*FilePath, false, false, true);
+		}
+	}
+};
@@ -1,5 +1,6 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class Statistics : ModuleRules
@@ -17,6 +18,8 @@ public class Statistics : ModuleRules
 		
 		PrivateIncludePaths.AddRange(
 			new string[] {
+				// Wire format, scene index and request framing of the live server, engine free and shared with the client tools...
+				Path.Combine(ModuleDirectory, "..", "..", "Tools", "StatisticsClient", "Public"),
 				// ... add other private include paths required here ...
 			}
 			);
@@ -46,6 +49,10 @@ public class Statistics : ModuleRules
                 "RHI",
                 "MaterialEditor",
                 "RenderCore",
+                "Json",
+                "Sockets",
+                "Networking",
+                "NavigationSystem",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
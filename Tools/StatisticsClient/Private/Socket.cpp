@@ -0,0 +1,201 @@
+// ...
+
+#include "Socket.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace StatisticsClient
+{
+	namespace
+	{
+#if defined(_WIN32)
+		struct FWinsock
+		{
+			FWinsock() { WSADATA Data; WSAStartup(MAKEWORD(2, 2), &Data); }
+			~FWinsock() { WSACleanup(); }
+		};
+		FWinsock Winsock;
+
+		void CloseHandle(intptr_t InHandle) { closesocket((SOCKET)InHandle); }
+		bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+		const int ShutdownBoth = SD_BOTH;
+		const int SendFlags = 0;
+#else
+		void CloseHandle(intptr_t InHandle) { close((int)InHandle); }
+		bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+		const int ShutdownBoth = SHUT_RDWR;
+#if defined(MSG_NOSIGNAL)
+		// A closed peer is an error, not SIGPIPE...
+		const int SendFlags = MSG_NOSIGNAL;
+#else
+		const int SendFlags = 0;
+#endif
+#endif
+
+		void SetNoDelay(intptr_t InHandle)
+		{
+			// Small requests are latency bound...
+			int NoDelay = 1;
+			setsockopt(InHandle, IPPROTO_TCP, TCP_NODELAY, (const char*)&NoDelay, sizeof(NoDelay));
+		}
+	}
+
+	FSocket::~FSocket()
+	{
+		Close();
+	}
+
+	FSocket::FSocket(FSocket&& InOther) noexcept
+	{
+		*this = std::move(InOther);
+	}
+
+	FSocket& FSocket::operator=(FSocket&& InOther) noexcept
+	{
+		if (this != &InOther)
+		{
+			Close();
+			std::swap(Handle, InOther.Handle);
+		}
+		return *this;
+	}
+
+	bool FSocket::Connect(const std::string& InHost, uint16_t InPort)
+	{
+		Close();
+
+		sockaddr_in Address = {};
+		Address.sin_family = AF_INET;
+		Address.sin_port = htons(InPort);
+		if (inet_pton(AF_INET, InHost.c_str(), &Address.sin_addr) != 1)
+			return false;
+
+		Handle = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (Handle == InvalidHandle)
+			return false;
+		if (connect(Handle, (const sockaddr*)&Address, sizeof(Address)) != 0)
+		{
+			Close();
+			return false;
+		}
+
+		SetNoDelay(Handle);
+		return true;
+	}
+
+	bool FSocket::Listen(uint16_t InPort)
+	{
+		Close();
+
+		Handle = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (Handle == InvalidHandle)
+			return false;
+
+		int Reuse = 1;
+		setsockopt(Handle, SOL_SOCKET, SO_REUSEADDR, (const char*)&Reuse, sizeof(Reuse));
+
+		sockaddr_in Address = {};
+		Address.sin_family = AF_INET;
+		Address.sin_port = htons(InPort);
+		Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (bind(Handle, (const sockaddr*)&Address, sizeof(Address)) != 0 || listen(Handle, 64) != 0)
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	FSocket FSocket::Accept()
+	{
+		FSocket Client;
+		Client.Handle = (intptr_t)accept(Handle, nullptr, nullptr);
+		if (Client.IsValid())
+			SetNoDelay(Client.Handle);
+		return Client;
+	}
+
+	void FSocket::Shutdown()
+	{
+		if (IsValid())
+			shutdown(Handle, ShutdownBoth);
+	}
+
+	void FSocket::Close()
+	{
+		if (IsValid())
+			CloseHandle(Handle);
+		Handle = InvalidHandle;
+	}
+
+	bool FSocket::SendAll(const void* InData, size_t InSize)
+	{
+		const char* Data = (const char*)InData;
+		while (InSize > 0)
+		{
+			const auto Sent = send(Handle, Data, (int)InSize, SendFlags);
+			if (Sent <= 0)
+				return false;
+			Data += Sent;
+			InSize -= (size_t)Sent;
+		}
+		return true;
+	}
+
+	bool FSocket::SetNonBlocking()
+	{
+#if defined(_WIN32)
+		u_long NonBlocking = 1;
+		return ioctlsocket((SOCKET)Handle, FIONBIO, &NonBlocking) == 0;
+#else
+		const int Flags = fcntl((int)Handle, F_GETFL, 0);
+		return Flags >= 0 && fcntl((int)Handle, F_SETFL, Flags | O_NONBLOCK) == 0;
+#endif
+	}
+
+	int64_t FSocket::Send(const void* InData, size_t InSize)
+	{
+		const auto Sent = send(Handle, (const char*)InData, (int)std::min<size_t>(InSize, 1 << 30), SendFlags);
+		if (Sent < 0)
+			return WouldBlock() ? 0 : -1;
+		return Sent;
+	}
+
+	int64_t FSocket::Recv(void* OutData, size_t InSize)
+	{
+		const auto Received = recv(Handle, (char*)OutData, (int)std::min<size_t>(InSize, 1 << 30), 0);
+		if (Received < 0)
+			return WouldBlock() ? 0 : -1;
+		// Zero bytes of a readable socket is a closed peer...
+		return Received > 0 ? Received : -1;
+	}
+
+	bool FSocket::RecvAll(void* OutData, size_t InSize)
+	{
+		char* Data = (char*)OutData;
+		while (InSize > 0)
+		{
+			const auto Received = recv(Handle, Data, (int)InSize, 0);
+			if (Received <= 0)
+				return false;
+			Data += Received;
+			InSize -= (size_t)Received;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,48 @@
+// ...
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace StatisticsClient
+{
+	/** TCP socket, blocking unless SetNonBlocking()...Winsock or BSD sockets... */
+	class FSocket
+	{
+	public:
+
+		FSocket() = default;
+		~FSocket();
+
+		FSocket(const FSocket&) = delete;
+		FSocket& operator=(const FSocket&) = delete;
+		FSocket(FSocket&& InOther) noexcept;
+		FSocket& operator=(FSocket&& InOther) noexcept;
+
+		bool Connect(const std::string& InHost, uint16_t InPort);
+		/** Loopback only, like the editor... */
+		bool Listen(uint16_t InPort);
+		FSocket Accept();
+		/** Unblocks a thread waiting in Accept() or RecvAll()... */
+		void Shutdown();
+		void Close();
+
+		bool SendAll(const void* InData, size_t InSize);
+		bool RecvAll(void* OutData, size_t InSize);
+
+		/** Accept() returns an invalid socket while none is pending, Send() and Recv() return 0 while they would block... */
+		bool SetNonBlocking();
+		/** Bytes moved, 0 would block, negative for a closed peer or an error... */
+		int64_t Send(const void* InData, size_t InSize);
+		int64_t Recv(void* OutData, size_t InSize);
+
+		bool IsValid() const { return Handle != InvalidHandle; }
+
+	private:
+
+		static const intptr_t InvalidHandle = -1;
+		intptr_t Handle = InvalidHandle;
+	};
+}
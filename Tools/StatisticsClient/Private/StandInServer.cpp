@@ -0,0 +1,115 @@
+// ...
+
+#include "StandInServer.h"
+#include "ServerConnection.h"
+#include "Socket.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace StatisticsClient
+{
+	namespace
+	{
+		const uint64_t MaxGridCells = 1024 * 1024;
+	}
+
+	FStandInServer::FStandInServer(uint32_t InNumPrimitives, uint32_t InNumMaterials)
+	{
+		std::mt19937 Random(0x5747);
+		const uint32_t Side = std::max(1u, (uint32_t)std::ceil(std::sqrt((double)InNumPrimitives)));
+		for (uint32_t i = 0; i < InNumPrimitives; ++i)
+		{
+			const float X = (float)(i % Side) * 100.f, Y = (float)(i / Side) * 100.f;
+			const uint32_t Material = InNumMaterials > 0 ? i % InNumMaterials : 0;
+			Index.AddRow({ X - 40.f, Y - 40.f, 0.f }, { X + 40.f, Y + 40.f, 80.f }, 100 + Random() % 20000, i % 500, &Material, InNumMaterials > 0 ? 1 : 0);
+		}
+
+		std::vector<FMaterialRow> Materials;
+		for (uint32_t i = 0; i < InNumMaterials; ++i)
+			Materials.push_back({ (int32_t)(50 + Random() % 400), (int32_t)(20 + Random() % 150), InNumPrimitives / InNumMaterials, "M_StandIn_" + std::to_string(i) });
+		Index.SetMaterials(std::move(Materials));
+	}
+
+	FStandInServer::~FStandInServer()
+	{
+		Stop();
+	}
+
+	bool FStandInServer::Start(uint16_t InPort)
+	{
+		ListenSocket.reset(new FSocket());
+		if (!ListenSocket->Listen(InPort) || !ListenSocket->SetNonBlocking())
+			return false;
+
+		bStopping = false;
+		ServerThread = std::thread(&FStandInServer::Run, this);
+		return true;
+	}
+
+	void FStandInServer::Stop()
+	{
+		bStopping = true;
+		if (ServerThread.joinable())
+			ServerThread.join();
+		ListenSocket.reset();
+	}
+
+	void FStandInServer::Run()
+	{
+		struct FConnection
+		{
+			FSocket Socket;
+			FServerConnection Connection;
+		};
+		std::vector<std::unique_ptr<FConnection>> Connections;
+
+		auto Execute = [this](EQuery InQuery, FReader& InRequest, std::vector<uint8_t>& OutPayload) { return this->Execute(InQuery, InRequest, OutPayload); };
+		while (!bStopping)
+		{
+			for (FSocket Socket = ListenSocket->Accept(); Socket.IsValid(); Socket = ListenSocket->Accept())
+			{
+				if (!Socket.SetNonBlocking())
+					continue;
+				Connections.emplace_back(new FConnection());
+				Connections.back()->Socket = std::move(Socket);
+			}
+
+			bool bActive = false;
+			for (size_t i = Connections.size(); i-- > 0;)
+			{
+				FSocket& Socket = Connections[i]->Socket;
+				const FServerConnection::EPump State = Connections[i]->Connection.Pump(
+					[&Socket](uint8_t* OutData, size_t InSize) { return Socket.Recv(OutData, InSize); },
+					[&Socket](const uint8_t* InData, size_t InSize) { return Socket.Send(InData, InSize); },
+					Execute);
+
+				if (State == FServerConnection::EPump::Closed)
+				{
+					Connections[i] = std::move(Connections.back());
+					Connections.pop_back();
+				}
+				else if (State == FServerConnection::EPump::Active)
+				{
+					bActive = true;
+				}
+			}
+
+			if (!bActive)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	EStatus FStandInServer::Execute(EQuery InQuery, FReader& InRequest, std::vector<uint8_t>& OutPayload) const
+	{
+		if (InQuery != EQuery::Info)
+			return Index.Execute(InQuery, InRequest, OutPayload, MaxGridCells);
+
+		const uint32_t NumPrimitives = Index.GetNumRows();
+		const FInfo Info = { 1, NumPrimitives, NumPrimitives, 0, Index.GetNumMaterials(), 0, 0.f, 0.f, Index.GetBoundsMin(), Index.GetBoundsMax() };
+		FWriter(OutPayload).Put(Info.Version).Put(Info.NumPrimitives).Put(Info.NumStaticMeshes).Put(Info.NumSkeletalMeshes).Put(Info.NumMaterials)
+			.Put(Info.NumTextures).Put(Info.GatherMs).Put(Info.Age).Put(Info.BoundsMin).Put(Info.BoundsMax);
+		return EStatus::Ok;
+	}
+}
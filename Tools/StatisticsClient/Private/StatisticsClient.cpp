@@ -0,0 +1,139 @@
+// ...
+
+#include "StatisticsClient.h"
+#include "Socket.h"
+
+namespace StatisticsClient
+{
+	FClient::FClient() : Socket(new FSocket())
+	{
+	}
+
+	FClient::~FClient() = default;
+
+	bool FClient::Connect(const std::string& InHost, uint16_t InPort)
+	{
+		return Socket->Connect(InHost, InPort);
+	}
+
+	void FClient::Close()
+	{
+		Socket->Close();
+	}
+
+	void FClient::Shutdown()
+	{
+		Socket->Shutdown();
+	}
+
+	bool FClient::Send(EQuery InQuery, const std::vector<uint8_t>& InPayload)
+	{
+		// Header and payload in one send...
+		FHeader Header = { (uint32_t)InPayload.size(), (uint16_t)InQuery, 0, NextRequestId++ };
+		Request.clear();
+		FWriter(Request).Put(Header).Put(InPayload.data(), InPayload.size());
+		return Socket->IsValid() && Socket->SendAll(Request.data(), Request.size());
+	}
+
+	EStatus FClient::Query(EQuery InQuery, const std::vector<uint8_t>& InPayload, std::vector<uint8_t>& OutPayload)
+	{
+		OutPayload.clear();
+		LastStatus = EStatus::Disconnected;
+
+		if (!Send(InQuery, InPayload))
+			return LastStatus;
+
+		FHeader ResponseHeader;
+		if (!Socket->RecvAll(&ResponseHeader, sizeof(ResponseHeader)) || ResponseHeader.RequestId != NextRequestId - 1)
+		{
+			Socket->Close();
+			return LastStatus;
+		}
+
+		OutPayload.resize(ResponseHeader.PayloadSize);
+		if (ResponseHeader.PayloadSize > 0 && !Socket->RecvAll(OutPayload.data(), OutPayload.size()))
+		{
+			Socket->Close();
+			return LastStatus;
+		}
+
+		return LastStatus = (EStatus)ResponseHeader.Status;
+	}
+
+	bool FClient::GetInfo(FInfo& OutInfo)
+	{
+		if (Query(EQuery::Info, {}, Response) != EStatus::Ok)
+			return false;
+
+		FReader Reader(Response.data(), Response.size());
+		Reader.Get(OutInfo.Version);
+		Reader.Get(OutInfo.NumPrimitives);
+		Reader.Get(OutInfo.NumStaticMeshes);
+		Reader.Get(OutInfo.NumSkeletalMeshes);
+		Reader.Get(OutInfo.NumMaterials);
+		Reader.Get(OutInfo.NumTextures);
+		Reader.Get(OutInfo.GatherMs);
+		Reader.Get(OutInfo.Age);
+		Reader.Get(OutInfo.BoundsMin);
+		Reader.Get(OutInfo.BoundsMax);
+		return Reader.IsOk();
+	}
+
+	bool FClient::GetBoxStats(const FVector3f& InMin, const FVector3f& InMax, FBoxStats& OutStats)
+	{
+		std::vector<uint8_t> Payload;
+		FWriter(Payload).Put(InMin).Put(InMax);
+		if (Query(EQuery::BoxStats, Payload, Response) != EStatus::Ok)
+			return false;
+
+		FReader Reader(Response.data(), Response.size());
+		Reader.Get(OutStats.NumPrimitives);
+		Reader.Get(OutStats.NumTriangles);
+		Reader.Get(OutStats.NumMeshes);
+		Reader.Get(OutStats.NumMaterials);
+		return Reader.IsOk();
+	}
+
+	bool FClient::GetTopMaterials(uint32_t InCount, ESortBy InSortBy, std::vector<FMaterialRow>& OutRows)
+	{
+		OutRows.clear();
+
+		std::vector<uint8_t> Payload;
+		FWriter(Payload).Put(InCount).Put((uint8_t)InSortBy);
+		if (Query(EQuery::TopMaterials, Payload, Response) != EStatus::Ok)
+			return false;
+
+		FReader Reader(Response.data(), Response.size());
+		uint32_t Num = 0;
+		Reader.Get(Num);
+		for (uint32_t i = 0; i < Num && Reader.IsOk(); ++i)
+		{
+			FMaterialRow Row;
+			uint16_t NameLen = 0;
+			Reader.Get(Row.BPSCount);
+			Reader.Get(Row.BPSVertex);
+			Reader.Get(Row.NumRefs);
+			Reader.Get(NameLen);
+			Row.Name.resize(NameLen);
+			Reader.Get(&Row.Name[0], NameLen);
+			OutRows.push_back(std::move(Row));
+		}
+		return Reader.IsOk();
+	}
+
+	bool FClient::GetGridTriangles(const FVector3f& InMin, const FVector3f& InMax, float InCellSize, FGrid& OutGrid)
+	{
+		std::vector<uint8_t> Payload;
+		FWriter(Payload).Put(InMin).Put(InMax).Put(InCellSize);
+		if (Query(EQuery::GridTriangles, Payload, Response) != EStatus::Ok)
+			return false;
+
+		FReader Reader(Response.data(), Response.size());
+		Reader.Get(OutGrid.NumX);
+		Reader.Get(OutGrid.NumY);
+		if (!Reader.IsOk() || (uint64_t)OutGrid.NumX * OutGrid.NumY * 4 != Response.size() - 8)
+			return false;
+		OutGrid.Triangles.resize((size_t)OutGrid.NumX * OutGrid.NumY);
+		return Reader.Get(OutGrid.Triangles.data(), OutGrid.Triangles.size() * 4);
+	}
+}
@@ -0,0 +1,155 @@
+// ...
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/** Wire format of FStatisticsServer...Little endian, every message is a header followed by its payload...
+ *
+ *  Info         : -> FInfo...
+ *  BoxStats     : FVector3f Min, FVector3f Max -> FBoxStats...
+ *  TopMaterials : uint32 Count, uint8 SortBy -> uint32 Num, Num x { int32 BPSCount, int32 BPSVertex, uint32 NumRefs, uint16 NameLen, UTF-8 Name }...
+ *  GridTriangles: FVector3f Min, FVector3f Max, float CellSize -> uint32 NumX, uint32 NumY, NumX x NumY uint32 Triangles (X fastest)...
+ */
+namespace StatisticsClient
+{
+	const uint16_t DefaultPort = 7781;
+
+	enum class EQuery : uint16_t
+	{
+		Info = 1,
+		BoxStats,
+		TopMaterials,
+		GridTriangles
+	};
+
+	enum class EStatus : uint16_t
+	{
+		Ok,
+		BadRequest,
+		NoSnapshot, // Editor has not gathered the scene yet...Ask again...
+		Disconnected = 0xFFFF // Client side only...
+	};
+
+	enum class ESortBy : uint8_t
+	{
+		BPSCount,
+		BPSVertex,
+		NumRefs
+	};
+
+	struct FHeader
+	{
+		uint32_t PayloadSize;
+		uint16_t Query;
+		uint16_t Status;
+		uint32_t RequestId;
+	};
+
+	struct FVector3f
+	{
+		float X, Y, Z;
+	};
+
+	struct FInfo
+	{
+		uint32_t Version;
+		uint32_t NumPrimitives;
+		uint32_t NumStaticMeshes;
+		uint32_t NumSkeletalMeshes;
+		uint32_t NumMaterials;
+		uint32_t NumTextures;
+		float	 GatherMs;
+		float	 Age; // Seconds since the snapshot was gathered...
+		FVector3f BoundsMin;
+		FVector3f BoundsMax;
+	};
+
+	struct FBoxStats
+	{
+		uint32_t NumPrimitives;
+		uint64_t NumTriangles;
+		uint32_t NumMeshes;
+		uint32_t NumMaterials;
+	};
+
+	struct FMaterialRow
+	{
+		int32_t BPSCount;
+		int32_t BPSVertex;
+		uint32_t NumRefs;
+		std::string Name;
+	};
+
+	struct FGrid
+	{
+		uint32_t NumX = 0;
+		uint32_t NumY = 0;
+		std::vector<uint32_t> Triangles;
+	};
+
+	static_assert(sizeof(FHeader) == 12 && sizeof(FVector3f) == 12, "Sent as raw memory...");
+
+	/** Appends little endian values... */
+	class FWriter
+	{
+	public:
+
+		explicit FWriter(std::vector<uint8_t>& InOutData) : Data(InOutData) {}
+
+		template<typename ValueType>
+		FWriter& Put(const ValueType& InValue)
+		{
+			return Put(&InValue, sizeof(ValueType));
+		}
+
+		FWriter& Put(const void* InValue, size_t InSize)
+		{
+			const size_t Offset = Data.size();
+			Data.resize(Offset + InSize);
+			if (InSize > 0)
+				std::memcpy(Data.data() + Offset, InValue, InSize);
+			return *this;
+		}
+
+	private:
+
+		std::vector<uint8_t>& Data;
+	};
+
+	/** Reads little endian values...Fails once past the end... */
+	class FReader
+	{
+	public:
+
+		FReader(const uint8_t* InData, size_t InSize) : Data(InData), Size(InSize) {}
+
+		template<typename ValueType>
+		bool Get(ValueType& OutValue)
+		{
+			return Get(&OutValue, sizeof(ValueType));
+		}
+
+		bool Get(void* OutValue, size_t InSize)
+		{
+			if (!bOk || InSize > Size - Offset)
+				return bOk = false;
+			std::memcpy(OutValue, Data + Offset, InSize);
+			Offset += InSize;
+			return true;
+		}
+
+		bool IsOk() const { return bOk; }
+
+	private:
+
+		const uint8_t* Data;
+		size_t Size;
+		size_t Offset = 0;
+		bool bOk = true;
+	};
+}
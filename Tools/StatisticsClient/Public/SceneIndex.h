@@ -0,0 +1,356 @@
+// ...
+
+#pragma once
+
+#include "Protocol.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace StatisticsClient
+{
+	const uint32_t MaxTopMaterials = 10000;
+	// Rows overlapping more cells are tested one by one...Sky spheres and landscapes, not worth bucketing...
+	const int64_t MaxCellsPerRow = 64;
+
+	/** Rows of BoxStats, GridTriangles and TopMaterials...Header only and engine free, FStatisticsServer and FStandInServer answer with this code...
+	 *  Rows are bucketed on a uniform XY grid of CellSize, a query only visits the cells it overlaps...
+	 *  A row in several cells is counted in one of them, the first one inside the query box, or the cell of its center for grids...
+	 *  Rows are added and removed one by one, the editor patches moved, added and deleted actors without a new gather...
+	 */
+	class FSceneIndex
+	{
+	public:
+
+		explicit FSceneIndex(float InCellSize = 2000.f) : CellSize(InCellSize > 0.f ? InCellSize : 2000.f) {}
+
+		/** Materials are rows of SetMaterials()...Returns the row for RemoveRow()... */
+		uint32_t AddRow(const FVector3f& InMin, const FVector3f& InMax, uint32_t InNumTriangles, uint32_t InMeshId, const uint32_t* InMaterials, uint32_t InNumMaterials)
+		{
+			uint32_t RowIndex = (uint32_t)Rows.size();
+			if (!FreeRows.empty())
+			{
+				RowIndex = FreeRows.back();
+				FreeRows.pop_back();
+			}
+			else
+			{
+				Rows.emplace_back();
+			}
+
+			FRow& Row = Rows[RowIndex];
+			Row.Min = InMin;
+			Row.Max = InMax;
+			Row.NumTriangles = InNumTriangles;
+			Row.MeshId = InMeshId;
+			// Lists of removed rows stay until the next full build...
+			Row.FirstMaterial = (uint32_t)RowMaterials.size();
+			Row.NumMaterials = InNumMaterials;
+			RowMaterials.insert(RowMaterials.end(), InMaterials, InMaterials + InNumMaterials);
+			Row.CellX0 = ToCell(InMin.X);
+			Row.CellY0 = ToCell(InMin.Y);
+			Row.CellX1 = std::max(ToCell(InMax.X), Row.CellX0);
+			Row.CellY1 = std::max(ToCell(InMax.Y), Row.CellY0);
+			Row.bValid = true;
+
+			if (IsLarge(Row))
+			{
+				LargeRows.push_back(RowIndex);
+			}
+			else
+			{
+				for (int32_t Y = Row.CellY0; Y <= Row.CellY1; ++Y)
+					for (int32_t X = Row.CellX0; X <= Row.CellX1; ++X)
+						Cells[GetCellKey(X, Y)].push_back(RowIndex);
+			}
+
+			if (NumRows++ == 0)
+			{
+				BoundsMin = InMin;
+				BoundsMax = InMax;
+			}
+			else
+			{
+				BoundsMin = { std::min(BoundsMin.X, InMin.X), std::min(BoundsMin.Y, InMin.Y), std::min(BoundsMin.Z, InMin.Z) };
+				BoundsMax = { std::max(BoundsMax.X, InMax.X), std::max(BoundsMax.Y, InMax.Y), std::max(BoundsMax.Z, InMax.Z) };
+			}
+			return RowIndex;
+		}
+
+		void RemoveRow(uint32_t InRow)
+		{
+			if (InRow >= Rows.size() || !Rows[InRow].bValid)
+				return;
+
+			FRow& Row = Rows[InRow];
+			if (IsLarge(Row))
+			{
+				RemoveFromBucket(LargeRows, InRow);
+			}
+			else
+			{
+				for (int32_t Y = Row.CellY0; Y <= Row.CellY1; ++Y)
+				{
+					for (int32_t X = Row.CellX0; X <= Row.CellX1; ++X)
+					{
+						auto It = Cells.find(GetCellKey(X, Y));
+						if (It == Cells.end())
+							continue;
+						RemoveFromBucket(It->second, InRow);
+						if (It->second.empty())
+							Cells.erase(It);
+					}
+				}
+			}
+
+			Row.bValid = false;
+			FreeRows.push_back(InRow);
+			NumRows--;
+		}
+
+		/** Rows of the material table...Sorted once per key, TopMaterials only copies the first rows... */
+		void SetMaterials(std::vector<FMaterialRow>&& InMaterials)
+		{
+			Materials = std::move(InMaterials);
+			for (uint8_t SortBy = 0; SortBy < 3; ++SortBy)
+			{
+				std::vector<uint32_t>& Order = MaterialOrders[SortBy];
+				Order.resize(Materials.size());
+				std::iota(Order.begin(), Order.end(), 0u);
+
+				auto GetKey = [this, SortBy](uint32_t InRow) -> int64_t
+				{
+					const FMaterialRow& Row = Materials[InRow];
+					return SortBy == 0 ? Row.BPSCount : SortBy == 1 ? Row.BPSVertex : (int64_t)Row.NumRefs;
+				};
+				std::sort(Order.begin(), Order.end(), [&GetKey](uint32_t A, uint32_t B) { return GetKey(A) != GetKey(B) ? GetKey(A) > GetKey(B) : A < B; });
+			}
+		}
+
+		uint32_t GetNumRows() const { return NumRows; }
+		uint32_t GetNumMaterials() const { return (uint32_t)Materials.size(); }
+		/** Grows with added rows, shrinks on the next full build only...Zero without rows... */
+		FVector3f GetBoundsMin() const { return NumRows > 0 ? BoundsMin : FVector3f{ 0.f, 0.f, 0.f }; }
+		FVector3f GetBoundsMax() const { return NumRows > 0 ? BoundsMax : FVector3f{ 0.f, 0.f, 0.f }; }
+
+		/** BoxStats, TopMaterials and GridTriangles...Info is answered by the host, it knows the tables... */
+		EStatus Execute(EQuery InQuery, FReader& InRequest, std::vector<uint8_t>& OutPayload, uint64_t InMaxGridCells) const
+		{
+			FWriter Writer(OutPayload);
+
+			switch (InQuery)
+			{
+			case EQuery::BoxStats:
+			{
+				FVector3f Min, Max;
+				if (!InRequest.Get(Min) || !InRequest.Get(Max))
+					return EStatus::BadRequest;
+
+				const FBoxStats Stats = QueryBox(Min, Max);
+				Writer.Put(Stats.NumPrimitives).Put(Stats.NumTriangles).Put(Stats.NumMeshes).Put(Stats.NumMaterials);
+				return EStatus::Ok;
+			}
+			case EQuery::TopMaterials:
+			{
+				uint32_t Count;
+				uint8_t SortBy;
+				if (!InRequest.Get(Count) || !InRequest.Get(SortBy) || SortBy > 2)
+					return EStatus::BadRequest;
+
+				const std::vector<uint32_t>& Order = MaterialOrders[SortBy];
+				const uint32_t Num = std::min(std::min(Count, MaxTopMaterials), (uint32_t)Order.size());
+				Writer.Put(Num);
+				for (uint32_t i = 0; i < Num; ++i)
+				{
+					const FMaterialRow& Row = Materials[Order[i]];
+					const uint16_t NameLen = (uint16_t)std::min<size_t>(Row.Name.size(), 0xFFFF);
+					Writer.Put(Row.BPSCount).Put(Row.BPSVertex).Put(Row.NumRefs).Put(NameLen).Put(Row.Name.data(), NameLen);
+				}
+				return EStatus::Ok;
+			}
+			case EQuery::GridTriangles:
+			{
+				FVector3f Min, Max;
+				float GridCellSize;
+				if (!InRequest.Get(Min) || !InRequest.Get(Max) || !InRequest.Get(GridCellSize) || !(GridCellSize > 0.f) || Max.X < Min.X || Max.Y < Min.Y)
+					return EStatus::BadRequest;
+
+				const double NumX = std::max(std::ceil(((double)Max.X - Min.X) / GridCellSize), 1.0);
+				const double NumY = std::max(std::ceil(((double)Max.Y - Min.Y) / GridCellSize), 1.0);
+				if (NumX * NumY > (double)InMaxGridCells)
+					return EStatus::BadRequest;
+
+				std::vector<uint32_t> GridCells;
+				QueryGrid(Min, Max, GridCellSize, (uint32_t)NumX, (uint32_t)NumY, GridCells);
+				Writer.Put((uint32_t)NumX).Put((uint32_t)NumY).Put(GridCells.data(), GridCells.size() * 4);
+				return EStatus::Ok;
+			}
+			default:
+				return EStatus::BadRequest;
+			}
+		}
+
+		/** Rows whose box intersects Min Max, Z included... */
+		FBoxStats QueryBox(const FVector3f& InMin, const FVector3f& InMax) const
+		{
+			FBoxStats Stats = {};
+			if (InMax.X < InMin.X || InMax.Y < InMin.Y || InMax.Z < InMin.Z)
+				return Stats;
+
+			std::vector<bool> UsedMaterials(Materials.size(), false);
+			std::unordered_set<uint32_t> UsedMeshes;
+			auto CountRow = [&](const FRow& InRow)
+			{
+				if (InRow.Min.X > InMax.X || InRow.Max.X < InMin.X || InRow.Min.Y > InMax.Y || InRow.Max.Y < InMin.Y || InRow.Min.Z > InMax.Z || InRow.Max.Z < InMin.Z)
+					return;
+
+				Stats.NumPrimitives++;
+				Stats.NumTriangles += InRow.NumTriangles;
+				UsedMeshes.insert(InRow.MeshId);
+				for (uint32_t i = 0; i < InRow.NumMaterials; ++i)
+				{
+					const uint32_t Material = RowMaterials[InRow.FirstMaterial + i];
+					if (Material < UsedMaterials.size() && !UsedMaterials[Material])
+					{
+						UsedMaterials[Material] = true;
+						Stats.NumMaterials++;
+					}
+				}
+			};
+
+			const int32_t QueryX0 = ToCell(InMin.X), QueryY0 = ToCell(InMin.Y);
+			ForEachCell(QueryX0, QueryY0, ToCell(InMax.X), ToCell(InMax.Y), [&](int32_t InX, int32_t InY, const std::vector<uint32_t>& InBucket)
+			{
+				for (uint32_t RowIndex : InBucket)
+				{
+					const FRow& Row = Rows[RowIndex];
+					if (std::max(Row.CellX0, QueryX0) == InX && std::max(Row.CellY0, QueryY0) == InY)
+						CountRow(Row);
+				}
+			});
+			for (uint32_t RowIndex : LargeRows)
+				CountRow(Rows[RowIndex]);
+
+			Stats.NumMeshes = (uint32_t)UsedMeshes.size();
+			return Stats;
+		}
+
+		/** Triangles per XY cell of the row centers inside Min Max...X fastest... */
+		void QueryGrid(const FVector3f& InMin, const FVector3f& InMax, float InCellSize, uint32_t InNumX, uint32_t InNumY, std::vector<uint32_t>& OutCells) const
+		{
+			OutCells.assign((size_t)InNumX * InNumY, 0);
+
+			auto CountRow = [&](const FRow& InRow, float InX, float InY)
+			{
+				if (InX < InMin.X || InX > InMax.X || InY < InMin.Y || InY > InMax.Y)
+					return;
+				const uint32_t X = std::min((uint32_t)((InX - InMin.X) / InCellSize), InNumX - 1);
+				const uint32_t Y = std::min((uint32_t)((InY - InMin.Y) / InCellSize), InNumY - 1);
+				OutCells[(size_t)Y * InNumX + X] += InRow.NumTriangles;
+			};
+
+			ForEachCell(ToCell(InMin.X), ToCell(InMin.Y), ToCell(InMax.X), ToCell(InMax.Y), [&](int32_t InX, int32_t InY, const std::vector<uint32_t>& InBucket)
+			{
+				for (uint32_t RowIndex : InBucket)
+				{
+					const FRow& Row = Rows[RowIndex];
+					const float CenterX = (Row.Min.X + Row.Max.X) * 0.5f, CenterY = (Row.Min.Y + Row.Max.Y) * 0.5f;
+					if (ToCell(CenterX) == InX && ToCell(CenterY) == InY)
+						CountRow(Row, CenterX, CenterY);
+				}
+			});
+			for (uint32_t RowIndex : LargeRows)
+			{
+				const FRow& Row = Rows[RowIndex];
+				CountRow(Row, (Row.Min.X + Row.Max.X) * 0.5f, (Row.Min.Y + Row.Max.Y) * 0.5f);
+			}
+		}
+
+	private:
+
+		struct FRow
+		{
+			FVector3f Min;
+			FVector3f Max;
+			uint32_t NumTriangles;
+			uint32_t MeshId;
+			uint32_t FirstMaterial;
+			uint32_t NumMaterials;
+			int32_t CellX0, CellY0, CellX1, CellY1;
+			bool bValid;
+		};
+
+		int32_t ToCell(float InValue) const
+		{
+			// Clamped far away from int overflow...Anything out there shares the border cells...
+			const double Cell = std::floor((double)InValue / CellSize);
+			return (int32_t)std::max(std::min(Cell, 1.0e9), -1.0e9);
+		}
+
+		static uint64_t GetCellKey(int32_t InX, int32_t InY)
+		{
+			return ((uint64_t)(uint32_t)InX << 32) | (uint32_t)InY;
+		}
+
+		static bool IsLarge(const FRow& InRow)
+		{
+			return ((int64_t)InRow.CellX1 - InRow.CellX0 + 1) * ((int64_t)InRow.CellY1 - InRow.CellY0 + 1) > MaxCellsPerRow;
+		}
+
+		static void RemoveFromBucket(std::vector<uint32_t>& InOutBucket, uint32_t InRow)
+		{
+			auto It = std::find(InOutBucket.begin(), InOutBucket.end(), InRow);
+			if (It != InOutBucket.end())
+			{
+				*It = InOutBucket.back();
+				InOutBucket.pop_back();
+			}
+		}
+
+		/** Occupied cells in X0 Y0 to X1 Y1...Walks the occupied cells instead when the range has more... */
+		template<typename VisitorType>
+		void ForEachCell(int32_t InX0, int32_t InY0, int32_t InX1, int32_t InY1, VisitorType&& InVisitor) const
+		{
+			const uint64_t NumQueryCells = (uint64_t)((int64_t)InX1 - InX0 + 1) * (uint64_t)((int64_t)InY1 - InY0 + 1);
+			if (NumQueryCells <= Cells.size())
+			{
+				for (int32_t Y = InY0; Y <= InY1; ++Y)
+				{
+					for (int32_t X = InX0; X <= InX1; ++X)
+					{
+						auto It = Cells.find(GetCellKey(X, Y));
+						if (It != Cells.end())
+							InVisitor(X, Y, It->second);
+					}
+				}
+			}
+			else
+			{
+				for (const auto& Cell : Cells)
+				{
+					const int32_t X = (int32_t)(uint32_t)(Cell.first >> 32), Y = (int32_t)(uint32_t)Cell.first;
+					if (X >= InX0 && X <= InX1 && Y >= InY0 && Y <= InY1)
+						InVisitor(X, Y, Cell.second);
+				}
+			}
+		}
+
+		float CellSize;
+		std::vector<FRow> Rows;
+		std::vector<uint32_t> FreeRows;
+		std::vector<uint32_t> RowMaterials;
+		std::unordered_map<uint64_t, std::vector<uint32_t>> Cells;
+		std::vector<uint32_t> LargeRows;
+		uint32_t NumRows = 0;
+		FVector3f BoundsMin = { 0.f, 0.f, 0.f };
+		FVector3f BoundsMax = { 0.f, 0.f, 0.f };
+
+		std::vector<FMaterialRow> Materials;
+		std::vector<uint32_t> MaterialOrders[3];
+	};
+}
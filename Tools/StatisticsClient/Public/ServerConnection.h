@@ -0,0 +1,111 @@
+// ...
+
+#pragma once
+
+#include "Protocol.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace StatisticsClient
+{
+	// Requests are a few floats...Anything bigger is not a client of this server...
+	const uint32_t MaxRequestBytes = 1024;
+	// Answers waiting for a slow client...Its requests stay in the socket until they are sent...
+	const size_t MaxQueuedBytes = 4 * 1024 * 1024;
+
+	/** Request framing and the queued answers of one connection...Header only and engine free, shared by FStatisticsServer and FStandInServer...
+	 *  The host passes its non-blocking recv and send, a client that does not read only fills its own queue and never stalls the others...
+	 */
+	class FServerConnection
+	{
+	public:
+
+		enum class EPump
+		{
+			Idle,
+			Active,
+			Closed
+		};
+
+		/** One round of reading, answering and sending...
+		 *  RecvType and SendType are int64_t(Data, Size), bytes moved, 0 would block, negative for a closed peer...
+		 *  ExecuteType is EStatus(EQuery, FReader& Request, std::vector<uint8_t>& OutPayload)...
+		 */
+		template<typename RecvType, typename SendType, typename ExecuteType>
+		EPump Pump(RecvType&& InRecv, SendType&& InSend, ExecuteType&& InExecute)
+		{
+			bool bActive = false;
+			if (GetQueuedBytes() <= MaxQueuedBytes)
+			{
+				uint8_t Buffer[4096];
+				const int64_t Received = InRecv(Buffer, sizeof(Buffer));
+				if (Received < 0)
+					return EPump::Closed;
+				Incoming.insert(Incoming.end(), Buffer, Buffer + Received);
+
+				const size_t NumIncoming = Incoming.size();
+				if (!ExecuteRequests(InExecute))
+					return EPump::Closed;
+				bActive = Received > 0 || Incoming.size() != NumIncoming;
+			}
+
+			while (GetQueuedBytes() > 0)
+			{
+				const int64_t Sent = InSend(Outgoing.data() + SentBytes, GetQueuedBytes());
+				if (Sent < 0)
+					return EPump::Closed;
+				if (Sent == 0)
+					break;
+				SentBytes += (size_t)Sent;
+				bActive = true;
+			}
+
+			// Sent bytes are dropped once they are the larger part...
+			if (SentBytes == Outgoing.size() || SentBytes > Outgoing.size() / 2)
+			{
+				Outgoing.erase(Outgoing.begin(), Outgoing.begin() + SentBytes);
+				SentBytes = 0;
+			}
+
+			return bActive ? EPump::Active : EPump::Idle;
+		}
+
+		size_t GetQueuedBytes() const { return Outgoing.size() - SentBytes; }
+
+	private:
+
+		/** Complete requests in order, until the queue is full...False closes the connection... */
+		template<typename ExecuteType>
+		bool ExecuteRequests(ExecuteType&& InExecute)
+		{
+			size_t Offset = 0;
+			while (Incoming.size() - Offset >= sizeof(FHeader) && GetQueuedBytes() <= MaxQueuedBytes)
+			{
+				FHeader Header;
+				std::memcpy(&Header, Incoming.data() + Offset, sizeof(Header));
+				if (Header.PayloadSize > MaxRequestBytes)
+					return false;
+				if (Incoming.size() - Offset - sizeof(Header) < Header.PayloadSize)
+					break;
+
+				FReader Request(Incoming.data() + Offset + sizeof(Header), Header.PayloadSize);
+				Payload.clear();
+				const EStatus Status = InExecute((EQuery)Header.Query, Request, Payload);
+				if (Status != EStatus::Ok)
+					Payload.clear();
+
+				const FHeader ResponseHeader = { (uint32_t)Payload.size(), Header.Query, (uint16_t)Status, Header.RequestId };
+				FWriter(Outgoing).Put(ResponseHeader).Put(Payload.data(), Payload.size());
+				Offset += sizeof(Header) + Header.PayloadSize;
+			}
+			Incoming.erase(Incoming.begin(), Incoming.begin() + Offset);
+			return true;
+		}
+
+		std::vector<uint8_t> Incoming;
+		std::vector<uint8_t> Outgoing;
+		std::vector<uint8_t> Payload;
+		size_t SentBytes = 0;
+	};
+}
@@ -0,0 +1,39 @@
+// ...
+
+#pragma once
+
+#include "SceneIndex.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace StatisticsClient
+{
+	class FSocket;
+
+	/** Answers the FStatisticsServer queries from a synthetic scene...For viewers and the load test without an editor...
+	 *  NumPrimitives boxes on a square XY grid, 100 units apart, meshes and materials assigned round robin...
+	 *  Same FSceneIndex and FServerConnection as the editor, one thread polling non-blocking sockets like FStatisticsServer::Run()...
+	 */
+	class FStandInServer
+	{
+	public:
+
+		explicit FStandInServer(uint32_t InNumPrimitives = 100000, uint32_t InNumMaterials = 2000);
+		~FStandInServer();
+
+		bool Start(uint16_t InPort = DefaultPort);
+		void Stop();
+
+	private:
+
+		void Run();
+		EStatus Execute(EQuery InQuery, FReader& InRequest, std::vector<uint8_t>& OutPayload) const;
+
+		FSceneIndex Index;
+		std::unique_ptr<FSocket> ListenSocket;
+		std::thread ServerThread;
+		std::atomic<bool> bStopping{ false };
+	};
+}
@@ -0,0 +1,47 @@
+// ...
+
+#pragma once
+
+#include "Protocol.h"
+
+#include <memory>
+
+namespace StatisticsClient
+{
+	class FSocket;
+
+	/** One connection to the editor...Requests are answered in order, one at a time... */
+	class FClient
+	{
+	public:
+
+		FClient();
+		~FClient();
+
+		bool Connect(const std::string& InHost = "127.0.0.1", uint16_t InPort = DefaultPort);
+		void Close();
+
+		/** False for any status but Ok, see GetLastStatus()... */
+		bool GetInfo(FInfo& OutInfo);
+		bool GetBoxStats(const FVector3f& InMin, const FVector3f& InMax, FBoxStats& OutStats);
+		bool GetTopMaterials(uint32_t InCount, ESortBy InSortBy, std::vector<FMaterialRow>& OutRows);
+		bool GetGridTriangles(const FVector3f& InMin, const FVector3f& InMax, float InCellSize, FGrid& OutGrid);
+
+		/** Raw round trip...OutPayload is the response payload... */
+		EStatus Query(EQuery InQuery, const std::vector<uint8_t>& InPayload, std::vector<uint8_t>& OutPayload);
+		/** Request without reading the answer...For the load test of clients that never read... */
+		bool Send(EQuery InQuery, const std::vector<uint8_t>& InPayload);
+		/** Unblocks a thread waiting in Query() or Send()... */
+		void Shutdown();
+
+		EStatus GetLastStatus() const { return LastStatus; }
+
+	private:
+
+		std::unique_ptr<FSocket> Socket;
+		std::vector<uint8_t> Request;
+		std::vector<uint8_t> Response;
+		uint32_t NextRequestId = 1;
+		EStatus LastStatus = EStatus::Disconnected;
+	};
+}
@@ -0,0 +1,140 @@
+// ...
+
+// Checks FSceneIndex against a scan of all rows...Random boxes of all sizes, negative coordinates, rows removed and added again...
+
+#include "SceneIndex.h"
+
+#include <cstdio>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace StatisticsClient;
+
+namespace
+{
+	struct FTestRow
+	{
+		FVector3f Min;
+		FVector3f Max;
+		uint32_t NumTriangles;
+		uint32_t MeshId;
+		uint32_t Material;
+		uint32_t Row;
+		bool bValid;
+	};
+
+	FBoxStats ScanBox(const std::vector<FTestRow>& InRows, const FVector3f& InMin, const FVector3f& InMax)
+	{
+		FBoxStats Stats = {};
+		std::unordered_set<uint32_t> Meshes, Materials;
+		for (const FTestRow& Row : InRows)
+		{
+			if (!Row.bValid || Row.Min.X > InMax.X || Row.Max.X < InMin.X || Row.Min.Y > InMax.Y || Row.Max.Y < InMin.Y || Row.Min.Z > InMax.Z || Row.Max.Z < InMin.Z)
+				continue;
+			Stats.NumPrimitives++;
+			Stats.NumTriangles += Row.NumTriangles;
+			Meshes.insert(Row.MeshId);
+			Materials.insert(Row.Material);
+		}
+		Stats.NumMeshes = (uint32_t)Meshes.size();
+		Stats.NumMaterials = (uint32_t)Materials.size();
+		return Stats;
+	}
+
+	std::vector<uint32_t> ScanGrid(const std::vector<FTestRow>& InRows, const FVector3f& InMin, const FVector3f& InMax, float InCellSize, uint32_t InNumX, uint32_t InNumY)
+	{
+		std::vector<uint32_t> Cells((size_t)InNumX * InNumY, 0);
+		for (const FTestRow& Row : InRows)
+		{
+			const float X = (Row.Min.X + Row.Max.X) * 0.5f, Y = (Row.Min.Y + Row.Max.Y) * 0.5f;
+			if (!Row.bValid || X < InMin.X || X > InMax.X || Y < InMin.Y || Y > InMax.Y)
+				continue;
+			const uint32_t CellX = std::min((uint32_t)((X - InMin.X) / InCellSize), InNumX - 1);
+			const uint32_t CellY = std::min((uint32_t)((Y - InMin.Y) / InCellSize), InNumY - 1);
+			Cells[(size_t)CellY * InNumX + CellX] += Row.NumTriangles;
+		}
+		return Cells;
+	}
+}
+
+int main()
+{
+	const uint32_t NumMaterials = 50;
+	std::mt19937 Random(7);
+	std::uniform_real_distribution<float> Position(-50000.f, 50000.f), Extent(1.f, 3000.f);
+
+	FSceneIndex Index(2000.f);
+	std::vector<FMaterialRow> Materials(NumMaterials);
+	Index.SetMaterials(std::move(Materials));
+
+	std::vector<FTestRow> Rows;
+	auto AddRow = [&]()
+	{
+		FTestRow Row;
+		const float X = Position(Random), Y = Position(Random), Z = Position(Random) * 0.01f;
+		// One row in fifty spans the scene, kept apart by the index...
+		const float ExtentXY = Random() % 50 == 0 ? 40000.f : Extent(Random);
+		Row.Min = { X - ExtentXY, Y - ExtentXY, Z - 100.f };
+		Row.Max = { X + ExtentXY, Y + ExtentXY, Z + 100.f };
+		Row.NumTriangles = 1 + Random() % 5000;
+		Row.MeshId = Random() % 300;
+		Row.Material = Random() % NumMaterials;
+		Row.Row = Index.AddRow(Row.Min, Row.Max, Row.NumTriangles, Row.MeshId, &Row.Material, 1);
+		Row.bValid = true;
+		Rows.push_back(Row);
+	};
+
+	for (int32_t i = 0; i < 20000; ++i)
+		AddRow();
+	// Patched like moved actors...
+	for (int32_t i = 0; i < 5000; ++i)
+	{
+		FTestRow& Row = Rows[Random() % Rows.size()];
+		if (Row.bValid)
+		{
+			Index.RemoveRow(Row.Row);
+			Row.bValid = false;
+		}
+		AddRow();
+	}
+
+	uint32_t NumFailed = 0;
+	for (int32_t Query = 0; Query < 500; ++Query)
+	{
+		const float X = Position(Random), Y = Position(Random);
+		const float Size = Query % 10 == 0 ? 200000.f : Extent(Random) * 4.f;
+		const FVector3f Min = { X - Size, Y - Size, Query % 3 == 0 ? 0.f : -1.0e6f };
+		const FVector3f Max = { X + Size, Y + Size, 1.0e6f };
+
+		const FBoxStats Expected = ScanBox(Rows, Min, Max);
+		const FBoxStats Stats = Index.QueryBox(Min, Max);
+		if (Stats.NumPrimitives != Expected.NumPrimitives || Stats.NumTriangles != Expected.NumTriangles || Stats.NumMeshes != Expected.NumMeshes || Stats.NumMaterials != Expected.NumMaterials)
+		{
+			std::fprintf(stderr, "Box %d: %u primitives, expected %u\n", Query, Stats.NumPrimitives, Expected.NumPrimitives);
+			NumFailed++;
+		}
+
+		const float CellSize = Size / 8.f;
+		const uint32_t NumX = (uint32_t)std::ceil((Max.X - Min.X) / CellSize), NumY = (uint32_t)std::ceil((Max.Y - Min.Y) / CellSize);
+		std::vector<uint32_t> Cells;
+		Index.QueryGrid(Min, Max, CellSize, NumX, NumY, Cells);
+		if (Cells != ScanGrid(Rows, Min, Max, CellSize, NumX, NumY))
+		{
+			std::fprintf(stderr, "Grid %d differs\n", Query);
+			NumFailed++;
+		}
+	}
+
+	uint32_t NumValid = 0;
+	for (const FTestRow& Row : Rows)
+		NumValid += Row.bValid ? 1 : 0;
+	if (Index.GetNumRows() != NumValid)
+	{
+		std::fprintf(stderr, "%u rows, expected %u\n", Index.GetNumRows(), NumValid);
+		NumFailed++;
+	}
+
+	std::printf(NumFailed == 0 ? "Scene index test passed\n" : "Scene index test failed\n");
+	return NumFailed == 0 ? 0 : 1;
+}
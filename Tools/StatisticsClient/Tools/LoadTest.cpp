@@ -0,0 +1,196 @@
+// ...
+
+// Fires a mix of box, top materials and grid queries from several connections and prints the latencies...
+// Usage: StatisticsLoadTest [--port N] [--stand-in] [--connections N] [--queries N] [--slow-clients N]
+// --stand-in answers from a synthetic scene of 100k primitives, no editor needed...
+// --slow-clients keeps N connections sending large grid queries without ever reading the answers...The other connections must not stall...
+
+#include "StatisticsClient.h"
+#include "StandInServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace StatisticsClient;
+
+namespace
+{
+	double GetMilliseconds()
+	{
+		using namespace std::chrono;
+		return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	struct FLatencies
+	{
+		std::vector<double> Box, Materials, Grid;
+		uint32_t NumFailed = 0;
+	};
+
+	void RunConnection(uint16_t InPort, const FInfo& InInfo, uint32_t InNumQueries, uint32_t InSeed, FLatencies& OutLatencies)
+	{
+		FClient Client;
+		if (!Client.Connect("127.0.0.1", InPort))
+		{
+			OutLatencies.NumFailed += InNumQueries;
+			return;
+		}
+
+		std::mt19937 Random(InSeed);
+		std::uniform_real_distribution<float> X(InInfo.BoundsMin.X, InInfo.BoundsMax.X), Y(InInfo.BoundsMin.Y, InInfo.BoundsMax.Y);
+		const float SceneSize = std::max(InInfo.BoundsMax.X - InInfo.BoundsMin.X, InInfo.BoundsMax.Y - InInfo.BoundsMin.Y);
+
+		FBoxStats Stats;
+		std::vector<FMaterialRow> Rows;
+		FGrid Grid;
+		for (uint32_t i = 0; i < InNumQueries; ++i)
+		{
+			const double StartTime = GetMilliseconds();
+			bool bOk = false;
+			std::vector<double>* Latencies = nullptr;
+
+			// Mostly boxes, like a viewer following the camera...
+			const uint32_t Kind = i % 10;
+			if (Kind < 8)
+			{
+				const float CenterX = X(Random), CenterY = Y(Random), Extent = SceneSize * 0.05f;
+				bOk = Client.GetBoxStats({ CenterX - Extent, CenterY - Extent, -1.0e6f }, { CenterX + Extent, CenterY + Extent, 1.0e6f }, Stats);
+				Latencies = &OutLatencies.Box;
+			}
+			else if (Kind == 8)
+			{
+				bOk = Client.GetTopMaterials(100, ESortBy::BPSCount, Rows);
+				Latencies = &OutLatencies.Materials;
+			}
+			else
+			{
+				bOk = Client.GetGridTriangles(InInfo.BoundsMin, InInfo.BoundsMax, std::max(SceneSize / 64.f, 1.f), Grid);
+				Latencies = &OutLatencies.Grid;
+			}
+
+			if (bOk)
+				Latencies->push_back(GetMilliseconds() - StartTime);
+			else
+				OutLatencies.NumFailed++;
+		}
+	}
+
+	/** Until Shutdown()...The server stops reading once its queue for this client is full, Send() then blocks... */
+	void RunSlowClient(FClient& InClient, const FInfo& InInfo, std::atomic<uint32_t>& OutNumSent)
+	{
+		const float SceneSize = std::max(InInfo.BoundsMax.X - InInfo.BoundsMin.X, InInfo.BoundsMax.Y - InInfo.BoundsMin.Y);
+		std::vector<uint8_t> Payload;
+		FWriter(Payload).Put(InInfo.BoundsMin).Put(InInfo.BoundsMax).Put(std::max(SceneSize / 256.f, 1.f));
+		while (InClient.Send(EQuery::GridTriangles, Payload))
+			OutNumSent++;
+	}
+
+	void PrintLatencies(const char* InLabel, std::vector<double>& InOutLatencies)
+	{
+		if (InOutLatencies.empty())
+			return;
+
+		std::sort(InOutLatencies.begin(), InOutLatencies.end());
+		auto Percentile = [&InOutLatencies](double InPercent) { return InOutLatencies[std::min(InOutLatencies.size() - 1, (size_t)(InOutLatencies.size() * InPercent))]; };
+		std::printf("%-10s %7zu queries  p50 %7.2f ms  p95 %7.2f ms  p99 %7.2f ms  max %7.2f ms\n",
+			InLabel, InOutLatencies.size(), Percentile(0.5), Percentile(0.95), Percentile(0.99), InOutLatencies.back());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint16_t Port = DefaultPort;
+	bool bStandIn = false;
+	uint32_t NumConnections = 8, NumQueries = 5000, NumSlowClients = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string Arg = argv[i];
+		if (Arg == "--port" && i + 1 < argc)
+			Port = (uint16_t)std::atoi(argv[++i]);
+		else if (Arg == "--connections" && i + 1 < argc)
+			NumConnections = std::max(1, std::atoi(argv[++i]));
+		else if (Arg == "--queries" && i + 1 < argc)
+			NumQueries = std::max(1, std::atoi(argv[++i]));
+		else if (Arg == "--slow-clients" && i + 1 < argc)
+			NumSlowClients = (uint32_t)std::max(0, std::atoi(argv[++i]));
+		else if (Arg == "--stand-in")
+			bStandIn = true;
+	}
+
+	FStandInServer StandIn;
+	if (bStandIn && !StandIn.Start(Port))
+	{
+		std::fprintf(stderr, "Can not listen on 127.0.0.1:%u\n", Port);
+		return 1;
+	}
+
+	// Scene bounds for the query boxes...Waits for the first snapshot of the editor...
+	FInfo Info;
+	{
+		FClient Client;
+		bool bHasInfo = Client.Connect("127.0.0.1", Port);
+		for (int32_t Try = 0; bHasInfo && !Client.GetInfo(Info); ++Try)
+		{
+			bHasInfo = Client.GetLastStatus() == EStatus::NoSnapshot && Try < 100;
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+		if (!bHasInfo)
+		{
+			std::fprintf(stderr, "No statistics server on 127.0.0.1:%u\n", Port);
+			return 1;
+		}
+	}
+	std::printf("Snapshot %u: %u primitives, %u materials...%u connections x %u queries, %u slow clients\n", Info.Version, Info.NumPrimitives, Info.NumMaterials, NumConnections, NumQueries, NumSlowClients);
+
+	// Slow clients fill their queues first...
+	std::vector<FClient> SlowClients(NumSlowClients);
+	std::vector<std::thread> SlowThreads;
+	std::atomic<uint32_t> NumSlowSent{ 0 };
+	for (FClient& SlowClient : SlowClients)
+	{
+		if (SlowClient.Connect("127.0.0.1", Port))
+			SlowThreads.emplace_back(RunSlowClient, std::ref(SlowClient), std::cref(Info), std::ref(NumSlowSent));
+	}
+	if (NumSlowClients > 0)
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	std::vector<FLatencies> PerConnection(NumConnections);
+	std::vector<std::thread> Threads;
+	const double StartTime = GetMilliseconds();
+	for (uint32_t i = 0; i < NumConnections; ++i)
+		Threads.emplace_back(RunConnection, Port, std::cref(Info), NumQueries, 1 + i, std::ref(PerConnection[i]));
+	for (std::thread& Thread : Threads)
+		Thread.join();
+	const double Elapsed = GetMilliseconds() - StartTime;
+
+	for (FClient& SlowClient : SlowClients)
+		SlowClient.Shutdown();
+	for (std::thread& Thread : SlowThreads)
+		Thread.join();
+
+	FLatencies All;
+	for (FLatencies& Latencies : PerConnection)
+	{
+		All.Box.insert(All.Box.end(), Latencies.Box.begin(), Latencies.Box.end());
+		All.Materials.insert(All.Materials.end(), Latencies.Materials.begin(), Latencies.Materials.end());
+		All.Grid.insert(All.Grid.end(), Latencies.Grid.begin(), Latencies.Grid.end());
+		All.NumFailed += Latencies.NumFailed;
+	}
+
+	PrintLatencies("Box", All.Box);
+	PrintLatencies("Materials", All.Materials);
+	PrintLatencies("Grid", All.Grid);
+	const size_t NumAnswered = All.Box.size() + All.Materials.size() + All.Grid.size();
+	std::printf("%zu answered, %u failed in %.0f ms, %.0f queries/s\n", NumAnswered, All.NumFailed, Elapsed, NumAnswered * 1000.0 / Elapsed);
+	if (NumSlowClients > 0)
+		std::printf("Slow clients sent %u unread grid queries\n", NumSlowSent.load());
+
+	return All.NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// ...
+
+// One query against the editor, or against a stand-in scene with --stand-in...
+// Usage: StatisticsQuery [--port N] [--stand-in] info
+//        StatisticsQuery box MinX MinY MinZ MaxX MaxY MaxZ
+//        StatisticsQuery materials [Count] [bps|vertex|refs]
+//        StatisticsQuery grid CellSize [MinX MinY MaxX MaxY]
+
+#include "StatisticsClient.h"
+#include "StandInServer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace StatisticsClient;
+
+namespace
+{
+	double GetMilliseconds()
+	{
+		using namespace std::chrono;
+		return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	int PrintUsage()
+	{
+		std::fprintf(stderr, "Usage: StatisticsQuery [--port N] [--stand-in] info | box MinX MinY MinZ MaxX MaxY MaxZ | materials [Count] [bps|vertex|refs] | grid CellSize [MinX MinY MaxX MaxY]\n");
+		return 1;
+	}
+
+	/** The editor answers NoSnapshot until the first gather is done... */
+	bool WaitForSnapshot(FClient& InClient, FInfo& OutInfo)
+	{
+		for (int32_t Try = 0; Try < 100; ++Try)
+		{
+			if (InClient.GetInfo(OutInfo))
+				return true;
+			if (InClient.GetLastStatus() != EStatus::NoSnapshot)
+				return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+		return false;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint16_t Port = DefaultPort;
+	bool bStandIn = false;
+	std::vector<std::string> Args;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string Arg = argv[i];
+		if (Arg == "--port" && i + 1 < argc)
+			Port = (uint16_t)std::atoi(argv[++i]);
+		else if (Arg == "--stand-in")
+			bStandIn = true;
+		else
+			Args.push_back(Arg);
+	}
+	if (Args.empty())
+		return PrintUsage();
+
+	FStandInServer StandIn;
+	if (bStandIn && !StandIn.Start(Port))
+	{
+		std::fprintf(stderr, "Can not listen on 127.0.0.1:%u\n", Port);
+		return 1;
+	}
+
+	FClient Client;
+	FInfo Info;
+	if (!Client.Connect("127.0.0.1", Port) || !WaitForSnapshot(Client, Info))
+	{
+		std::fprintf(stderr, "No statistics server on 127.0.0.1:%u, see [LiveServer] of PluginSetting.ini\n", Port);
+		return 1;
+	}
+
+	const double StartTime = GetMilliseconds();
+	const std::string& Command = Args[0];
+	auto ArgFloat = [&Args](size_t InIndex, float InDefault) { return InIndex < Args.size() ? (float)std::atof(Args[InIndex].c_str()) : InDefault; };
+
+	if (Command == "info")
+	{
+		std::printf("Snapshot %u, %.1f s old, gathered in %.1f ms\n", Info.Version, Info.Age, Info.GatherMs);
+		std::printf("%u primitives, %u static meshes, %u skeletal meshes, %u materials, %u textures\n",
+			Info.NumPrimitives, Info.NumStaticMeshes, Info.NumSkeletalMeshes, Info.NumMaterials, Info.NumTextures);
+		std::printf("Bounds (%.0f, %.0f, %.0f) - (%.0f, %.0f, %.0f)\n",
+			Info.BoundsMin.X, Info.BoundsMin.Y, Info.BoundsMin.Z, Info.BoundsMax.X, Info.BoundsMax.Y, Info.BoundsMax.Z);
+	}
+	else if (Command == "box" && Args.size() == 7)
+	{
+		FBoxStats Stats;
+		if (!Client.GetBoxStats({ ArgFloat(1, 0.f), ArgFloat(2, 0.f), ArgFloat(3, 0.f) }, { ArgFloat(4, 0.f), ArgFloat(5, 0.f), ArgFloat(6, 0.f) }, Stats))
+			return PrintUsage();
+		std::printf("%u primitives, %llu triangles, %u meshes, %u materials\n",
+			Stats.NumPrimitives, (unsigned long long)Stats.NumTriangles, Stats.NumMeshes, Stats.NumMaterials);
+	}
+	else if (Command == "materials")
+	{
+		const uint32_t Count = Args.size() > 1 ? (uint32_t)std::atoi(Args[1].c_str()) : 100;
+		const std::string SortBy = Args.size() > 2 ? Args[2] : "bps";
+		std::vector<FMaterialRow> Rows;
+		if (!Client.GetTopMaterials(Count, SortBy == "vertex" ? ESortBy::BPSVertex : SortBy == "refs" ? ESortBy::NumRefs : ESortBy::BPSCount, Rows))
+			return PrintUsage();
+		std::printf("%8s %8s %8s  %s\n", "BPS", "Vertex", "Refs", "Name");
+		for (const FMaterialRow& Row : Rows)
+			std::printf("%8d %8d %8u  %s\n", Row.BPSCount, Row.BPSVertex, Row.NumRefs, Row.Name.c_str());
+	}
+	else if (Command == "grid" && Args.size() >= 2)
+	{
+		// Whole scene by default...
+		const float CellSize = ArgFloat(1, 0.f);
+		const FVector3f Min = { ArgFloat(2, Info.BoundsMin.X), ArgFloat(3, Info.BoundsMin.Y), 0.f };
+		const FVector3f Max = { ArgFloat(4, Info.BoundsMax.X), ArgFloat(5, Info.BoundsMax.Y), 0.f };
+		FGrid Grid;
+		if (!Client.GetGridTriangles(Min, Max, CellSize, Grid))
+			return PrintUsage();
+
+		uint64_t Total = 0, Peak = 0;
+		for (uint32_t Triangles : Grid.Triangles)
+		{
+			Total += Triangles;
+			Peak = Triangles > Peak ? Triangles : Peak;
+		}
+		std::printf("%u x %u cells of %.0f, %llu triangles, peak cell %llu\n", Grid.NumX, Grid.NumY, CellSize, (unsigned long long)Total, (unsigned long long)Peak);
+	}
+	else
+	{
+		return PrintUsage();
+	}
+
+	std::printf("Answered in %.2f ms\n", GetMilliseconds() - StartTime);
+	return 0;
+}
@@ -0,0 +1,208 @@
+// ...
+
+// Loads an export with 2M transforms through FTableFile and through a CSV parse of the same rows...
+// Usage: StatisticsReaderBenchmark [Tables.stb]...Without a file a synthetic export is written to the temp dir first...
+
+#include "TableFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace StatisticsReader;
+
+namespace
+{
+	const uint32_t NumTransforms = 2 * 1024 * 1024;
+
+	double GetSeconds()
+	{
+		using namespace std::chrono;
+		return duration<double>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	/** Same layout as FBinaryTableWriter...Transforms, bounds and one static mesh row per transform... */
+	bool WriteSyntheticExport(const std::string& InFilePath)
+	{
+		struct FColumn
+		{
+			const char* Name;
+			EColumnType Type;
+			uint32_t NumComponents;
+			uint64_t NumRows;
+			const void* Data;
+			uint64_t NumBytes;
+		};
+
+		std::vector<FMatrix44f> Transforms(NumTransforms);
+		std::vector<FVector3f> Origins(NumTransforms), Extents(NumTransforms);
+		std::vector<float> Radii(NumTransforms);
+		std::vector<uint32_t> Triangles(NumTransforms);
+		std::vector<FIndexSpan> TransformsIndices(NumTransforms);
+		std::vector<int32_t> Indices(NumTransforms);
+		for (uint32_t i = 0; i < NumTransforms; ++i)
+		{
+			FMatrix44f& Transform = Transforms[i];
+			std::memset(&Transform, 0, sizeof(Transform));
+			Transform.M[0][0] = Transform.M[1][1] = Transform.M[2][2] = Transform.M[3][3] = 1.f;
+			Transform.M[3][0] = (float)(i % 2048) * 100.f;
+			Transform.M[3][1] = (float)(i / 2048) * 100.f;
+			Origins[i] = { Transform.M[3][0], Transform.M[3][1], 0.f };
+			Extents[i] = { 50.f, 50.f, 50.f };
+			Radii[i] = 86.6f;
+			Triangles[i] = 100 + i % 5000;
+			TransformsIndices[i] = { (int32_t)i, 1 };
+			Indices[i] = (int32_t)i;
+		}
+
+		const std::vector<FColumn> Columns =
+		{
+			{ "Indices", EColumnType::Int32, 1, NumTransforms, Indices.data(), NumTransforms * 4ull },
+			{ "Transforms", EColumnType::Float, 16, NumTransforms, Transforms.data(), NumTransforms * 64ull },
+			{ "Bounds.Origin", EColumnType::Float, 3, NumTransforms, Origins.data(), NumTransforms * 12ull },
+			{ "Bounds.BoxExtent", EColumnType::Float, 3, NumTransforms, Extents.data(), NumTransforms * 12ull },
+			{ "Bounds.SphereRadius", EColumnType::Float, 1, NumTransforms, Radii.data(), NumTransforms * 4ull },
+			{ "StaticMeshes.NumTriangles", EColumnType::UInt32, 1, NumTransforms, Triangles.data(), NumTransforms * 4ull },
+			{ "StaticMeshes.TransformsIndices", EColumnType::Int32, 2, NumTransforms, TransformsIndices.data(), NumTransforms * 8ull },
+		};
+
+		std::ofstream Out(InFilePath, std::ios::binary);
+		if (!Out)
+			return false;
+
+		auto Align = [](uint64_t InOffset) { return (InOffset + 63) & ~63ull; };
+		auto Write = [&Out](const void* InData, size_t InSize) { Out.write((const char*)InData, InSize); };
+
+		const uint32_t Header[4] = { 0x46425453, 1, (uint32_t)Columns.size(), 0 };
+		Write(Header, sizeof(Header));
+
+		uint64_t Offset = Align(16 + Columns.size() * 72);
+		for (const FColumn& Column : Columns)
+		{
+			char Name[48] = { 0 };
+			std::strncpy(Name, Column.Name, sizeof(Name) - 1);
+			const uint32_t Type = (uint32_t)Column.Type;
+			Write(Name, sizeof(Name));
+			Write(&Type, 4);
+			Write(&Column.NumComponents, 4);
+			Write(&Column.NumRows, 8);
+			Write(&Offset, 8);
+			Offset = Align(Offset + Column.NumBytes);
+		}
+
+		const char Zeros[64] = { 0 };
+		for (const FColumn& Column : Columns)
+		{
+			const uint64_t Position = (uint64_t)Out.tellp();
+			Write(Zeros, Align(Position) - Position);
+			Write(Column.Data, Column.NumBytes);
+		}
+
+		// Same transforms as the CSV tables print them...
+		std::ofstream Csv(InFilePath + ".csv");
+		Csv << "Index,M00,M01,M02,M03,M10,M11,M12,M13,M20,M21,M22,M23,M30,M31,M32,M33\n";
+		for (uint32_t i = 0; i < NumTransforms; ++i)
+		{
+			Csv << i;
+			for (int32_t Row = 0; Row < 4; ++Row)
+				for (int32_t Col = 0; Col < 4; ++Col)
+					Csv << ',' << Transforms[i].M[Row][Col];
+			Csv << '\n';
+		}
+
+		return Out.good() && Csv.good();
+	}
+
+	/** Typical consumer pass...Bounds of all translations... */
+	double SumTranslations(const TColumnView<FMatrix44f>& InTransforms)
+	{
+		double Sum = 0.0;
+		for (const FMatrix44f& Transform : InTransforms)
+			Sum += Transform.M[3][0] + Transform.M[3][1] + Transform.M[3][2];
+		return Sum;
+	}
+
+	double ParseCsvTranslations(const std::string& InFilePath, size_t& OutNumRows)
+	{
+		std::ifstream In(InFilePath, std::ios::binary);
+		std::string Text((std::istreambuf_iterator<char>(In)), std::istreambuf_iterator<char>());
+
+		std::vector<FMatrix44f> Transforms;
+		const char* Cursor = std::strchr(Text.c_str(), '\n');
+		while (Cursor && *++Cursor)
+		{
+			char* End = nullptr;
+			std::strtoul(Cursor, &End, 10);
+			FMatrix44f Transform;
+			for (int32_t i = 0; i < 16; ++i)
+				Transform.M[i / 4][i % 4] = std::strtof(End + 1, &End);
+			Transforms.push_back(Transform);
+			Cursor = std::strchr(End, '\n');
+		}
+
+		OutNumRows = Transforms.size();
+		return SumTranslations(TColumnView<FMatrix44f>(Transforms.data(), Transforms.size()));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string FilePath;
+	if (argc > 1)
+	{
+		FilePath = argv[1];
+	}
+	else
+	{
+		FilePath = (std::filesystem::temp_directory_path() / "StatisticsReaderBenchmark_Tables.stb").string();
+		const double StartTime = GetSeconds();
+		if (!WriteSyntheticExport(FilePath))
+		{
+			std::fprintf(stderr, "Can not write %s\n", FilePath.c_str());
+			return 1;
+		}
+		std::printf("Wrote synthetic export of %u transforms in %.1f ms\n", NumTransforms, (GetSeconds() - StartTime) * 1000.0);
+	}
+
+	const int32_t NumRuns = 5;
+	for (int32_t Run = 0; Run < NumRuns; ++Run)
+	{
+		const double OpenTime = GetSeconds();
+		FTableFile Tables;
+		if (!Tables.Open(FilePath))
+		{
+			std::fprintf(stderr, "%s: %s\n", FilePath.c_str(), Tables.GetError().c_str());
+			return 1;
+		}
+		const TColumnView<FMatrix44f> Transforms = Tables.GetTransforms();
+		const FBoundsColumns Bounds = Tables.GetBounds();
+
+		const double ScanTime = GetSeconds();
+		const double Sum = SumTranslations(Transforms);
+		double Radii = 0.0;
+		for (float Radius : Bounds.SphereRadius)
+			Radii += Radius;
+		const double EndTime = GetSeconds();
+
+		std::printf("Mapped: %zu columns, %zu transforms, open %.3f ms, first scan %.1f ms (checksum %.0f, %.0f)\n",
+			Tables.GetColumns().size(), Transforms.Num(), (ScanTime - OpenTime) * 1000.0, (EndTime - ScanTime) * 1000.0, Sum, Radii);
+	}
+
+	if (argc <= 1)
+	{
+		size_t NumRows = 0;
+		const double StartTime = GetSeconds();
+		const double Sum = ParseCsvTranslations(FilePath + ".csv", NumRows);
+		std::printf("CSV:    %zu transforms, parse and scan %.1f ms (checksum %.0f)\n", NumRows, (GetSeconds() - StartTime) * 1000.0, Sum);
+
+		std::filesystem::remove(FilePath);
+		std::filesystem::remove(FilePath + ".csv");
+	}
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+// ...
+
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace StatisticsReader
+{
+	FMappedFile::~FMappedFile()
+	{
+		Close();
+	}
+
+	FMappedFile::FMappedFile(FMappedFile&& InOther) noexcept
+	{
+		*this = std::move(InOther);
+	}
+
+	FMappedFile& FMappedFile::operator=(FMappedFile&& InOther) noexcept
+	{
+		if (this != &InOther)
+		{
+			Close();
+			std::swap(Data, InOther.Data);
+			std::swap(Size, InOther.Size);
+#if defined(_WIN32)
+			std::swap(FileHandle, InOther.FileHandle);
+			std::swap(MappingHandle, InOther.MappingHandle);
+#endif
+		}
+		return *this;
+	}
+
+#if defined(_WIN32)
+
+	bool FMappedFile::Open(const std::string& InFilePath)
+	{
+		Close();
+
+		HANDLE File = CreateFileA(InFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (File == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER FileSize;
+		if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0)
+		{
+			CloseHandle(File);
+			return false;
+		}
+
+		HANDLE Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		const void* View = Mapping ? MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!View)
+		{
+			if (Mapping)
+				CloseHandle(Mapping);
+			CloseHandle(File);
+			return false;
+		}
+
+		FileHandle = File;
+		MappingHandle = Mapping;
+		Data = (const uint8_t*)View;
+		Size = (size_t)FileSize.QuadPart;
+		return true;
+	}
+
+	void FMappedFile::Close()
+	{
+		if (Data)
+			UnmapViewOfFile(Data);
+		if (MappingHandle)
+			CloseHandle(MappingHandle);
+		if (FileHandle)
+			CloseHandle(FileHandle);
+
+		Data = nullptr;
+		Size = 0;
+		FileHandle = MappingHandle = nullptr;
+	}
+
+#else
+
+	bool FMappedFile::Open(const std::string& InFilePath)
+	{
+		Close();
+
+		const int File = open(InFilePath.c_str(), O_RDONLY);
+		if (File < 0)
+			return false;
+
+		struct stat FileStat;
+		if (fstat(File, &FileStat) != 0 || FileStat.st_size == 0)
+		{
+			close(File);
+			return false;
+		}
+
+		// The mapping keeps its own reference to the file...
+		void* View = mmap(nullptr, (size_t)FileStat.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+		close(File);
+		if (View == MAP_FAILED)
+			return false;
+
+		Data = (const uint8_t*)View;
+		Size = (size_t)FileStat.st_size;
+		return true;
+	}
+
+	void FMappedFile::Close()
+	{
+		if (Data)
+			munmap((void*)Data, Size);
+
+		Data = nullptr;
+		Size = 0;
+	}
+
+#endif
+}
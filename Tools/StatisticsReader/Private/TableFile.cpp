@@ -0,0 +1,247 @@
+// ...
+
+#include "TableFile.h"
+
+#include <cstring>
+
+namespace StatisticsReader
+{
+	namespace
+	{
+		const uint32_t Magic = 0x46425453; // STBF
+		const uint32_t Version = 1;
+		const size_t NameBytes = 48;
+		const size_t HeaderBytes = 16;
+		const size_t ColumnBytes = NameBytes + 4 + 4 + 8 + 8;
+
+		template<typename ValueType>
+		ValueType ReadValue(const uint8_t* InData)
+		{
+			ValueType Value;
+			std::memcpy(&Value, InData, sizeof(ValueType));
+			return Value;
+		}
+
+		size_t GetTypeBytes(EColumnType InType)
+		{
+			switch (InType)
+			{
+			case EColumnType::UInt8:  return 1;
+			case EColumnType::UInt16: return 2;
+			case EColumnType::UInt64: return 8;
+			default:				  return 4;
+			}
+		}
+	}
+
+	static_assert(sizeof(FVector3f) == 12 && sizeof(FMatrix44f) == 64 && sizeof(FIndexSpan) == 8, "Rows are read as raw memory...");
+
+	bool FTableFile::Open(const std::string& InFilePath)
+	{
+		Close();
+
+		if (!File.Open(InFilePath))
+			return Fail("Can not map " + InFilePath);
+
+		return ReadColumns();
+	}
+
+	bool FTableFile::ParseTablesArgument(const std::string& InCommandLine, std::string& OutFilePath)
+	{
+		// Brackets keep paths with spaces in one value, same as -dir [..]...
+		const std::string Key = "-tables [";
+		const size_t Begin = InCommandLine.find(Key);
+		if (Begin == std::string::npos)
+			return false;
+
+		const size_t PathBegin = Begin + Key.size();
+		const size_t PathEnd = InCommandLine.find(']', PathBegin);
+		if (PathEnd == std::string::npos || PathEnd == PathBegin)
+			return false;
+
+		OutFilePath = InCommandLine.substr(PathBegin, PathEnd - PathBegin);
+		return true;
+	}
+
+	bool FTableFile::ReadColumns()
+	{
+		const uint8_t* Data = File.GetData();
+		const size_t Size = File.GetSize();
+		if (Size < HeaderBytes || ReadValue<uint32_t>(Data) != Magic)
+			return Fail("Not a statistics table file");
+		if (ReadValue<uint32_t>(Data + 4) != Version)
+			return Fail("Unsupported table file version");
+
+		const uint32_t NumColumns = ReadValue<uint32_t>(Data + 8);
+		if (HeaderBytes + (uint64_t)NumColumns * ColumnBytes > Size)
+			return Fail("Truncated column directory");
+
+		Columns.reserve(NumColumns);
+		for (uint32_t i = 0; i < NumColumns; ++i)
+		{
+			const uint8_t* Desc = Data + HeaderBytes + (size_t)i * ColumnBytes;
+
+			FColumnInfo Column;
+			Column.Type = (EColumnType)ReadValue<uint32_t>(Desc + NameBytes);
+			Column.NumComponents = ReadValue<uint32_t>(Desc + NameBytes + 4);
+			Column.NumRows = ReadValue<uint64_t>(Desc + NameBytes + 8);
+			const uint64_t Offset = ReadValue<uint64_t>(Desc + NameBytes + 16);
+
+			if (Column.Type > EColumnType::Float || Column.NumComponents == 0)
+				return Fail("Unknown column type");
+
+			// Rows are checked against the bytes left...A corrupt row count must not wrap the product around...
+			const uint64_t RowBytes = (uint64_t)Column.NumComponents * GetTypeBytes(Column.Type);
+			if (Offset > Size || Column.NumRows > (Size - Offset) / RowBytes)
+				return Fail("Truncated column data");
+			Column.Data = Data + Offset;
+
+			const char* Name = (const char*)Desc;
+			Columns.emplace(std::string(Name, strnlen(Name, NameBytes)), Column);
+		}
+
+		StringOffsets = GetColumn<uint32_t>("Strings.Offsets");
+		StringChars = GetColumn<uint8_t>("Strings.Chars");
+		Indices = GetColumn<int32_t>("Indices");
+		return true;
+	}
+
+	void FTableFile::Close()
+	{
+		File.Close();
+		Columns.clear();
+		StringOffsets = TColumnView<uint32_t>();
+		StringChars = TColumnView<uint8_t>();
+		Indices = TColumnView<int32_t>();
+		Error.clear();
+	}
+
+	bool FTableFile::Fail(const std::string& InError)
+	{
+		File.Close();
+		Columns.clear();
+		Error = InError;
+		return false;
+	}
+
+	const FColumnInfo* FTableFile::FindColumn(const std::string& InName) const
+	{
+		auto It = Columns.find(InName);
+		return It != Columns.end() ? &It->second : nullptr;
+	}
+
+	std::string_view FTableFile::GetString(uint32_t InId) const
+	{
+		if ((size_t)InId + 1 >= StringOffsets.Num())
+			return std::string_view();
+
+		// Null terminator is not part of the view...
+		const uint32_t Begin = StringOffsets[InId];
+		const uint32_t End = StringOffsets[InId + 1];
+		if (End <= Begin || End > StringChars.Num())
+			return std::string_view();
+		return std::string_view((const char*)StringChars.GetData() + Begin, End - Begin - 1);
+	}
+
+	TColumnView<int32_t> FTableFile::GetIndices(const FIndexSpan& InSpan) const
+	{
+		if (InSpan.Offset < 0 || InSpan.Count <= 0 || (size_t)InSpan.Offset + InSpan.Count > Indices.Num())
+			return TColumnView<int32_t>();
+		return TColumnView<int32_t>(Indices.GetData() + InSpan.Offset, (size_t)InSpan.Count);
+	}
+
+	FBoundsColumns FTableFile::GetBounds() const
+	{
+		FBoundsColumns Bounds;
+		Bounds.Origin = GetColumn<FVector3f>("Bounds.Origin");
+		Bounds.BoxExtent = GetColumn<FVector3f>("Bounds.BoxExtent");
+		Bounds.SphereRadius = GetColumn<float>("Bounds.SphereRadius");
+		return Bounds;
+	}
+
+	FStaticMeshColumns FTableFile::GetStaticMeshes() const
+	{
+		FStaticMeshColumns Meshes;
+		Meshes.Name = GetColumn<uint32_t>("StaticMeshes.Name");
+		Meshes.OwnerName = GetColumn<uint32_t>("StaticMeshes.OwnerName");
+		Meshes.AssetPath = GetColumn<uint32_t>("StaticMeshes.AssetPath");
+		Meshes.UniqueId = GetColumn<uint32_t>("StaticMeshes.UniqueId");
+		Meshes.CurrentLOD = GetColumn<uint16_t>("StaticMeshes.CurrentLOD");
+		Meshes.NumLODs = GetColumn<uint16_t>("StaticMeshes.NumLODs");
+		Meshes.NumVertices = GetColumn<uint32_t>("StaticMeshes.NumVertices");
+		Meshes.NumTriangles = GetColumn<uint32_t>("StaticMeshes.NumTriangles");
+		Meshes.NumInstances = GetColumn<uint32_t>("StaticMeshes.NumInstances");
+		Meshes.BoundsIndices = GetColumn<FIndexSpan>("StaticMeshes.BoundsIndices");
+		Meshes.TransformsIndices = GetColumn<FIndexSpan>("StaticMeshes.TransformsIndices");
+		Meshes.UsedMaterials = GetColumn<FIndexSpan>("StaticMeshes.UsedMaterials");
+		Meshes.UsedMaterialInstances = GetColumn<FIndexSpan>("StaticMeshes.UsedMaterialInstances");
+		return Meshes;
+	}
+
+	FSkeletalMeshColumns FTableFile::GetSkeletalMeshes() const
+	{
+		FSkeletalMeshColumns Meshes;
+		Meshes.Name = GetColumn<uint32_t>("SkeletalMeshes.Name");
+		Meshes.OwnerName = GetColumn<uint32_t>("SkeletalMeshes.OwnerName");
+		Meshes.AssetPath = GetColumn<uint32_t>("SkeletalMeshes.AssetPath");
+		Meshes.UniqueId = GetColumn<uint32_t>("SkeletalMeshes.UniqueId");
+		Meshes.CurrentLOD = GetColumn<uint16_t>("SkeletalMeshes.CurrentLOD");
+		Meshes.NumLODs = GetColumn<uint16_t>("SkeletalMeshes.NumLODs");
+		Meshes.NumVertices = GetColumn<uint32_t>("SkeletalMeshes.NumVertices");
+		Meshes.NumTriangles = GetColumn<uint32_t>("SkeletalMeshes.NumTriangles");
+		Meshes.NumSections = GetColumn<uint32_t>("SkeletalMeshes.NumSections");
+		Meshes.BoundsIndex = GetColumn<int32_t>("SkeletalMeshes.BoundsIndex");
+		Meshes.TransformsIndex = GetColumn<int32_t>("SkeletalMeshes.TransformsIndex");
+		Meshes.UsedMaterials = GetColumn<FIndexSpan>("SkeletalMeshes.UsedMaterials");
+		Meshes.UsedMaterialInstances = GetColumn<FIndexSpan>("SkeletalMeshes.UsedMaterialInstances");
+		return Meshes;
+	}
+
+	FMaterialColumns FTableFile::GetMaterials() const
+	{
+		FMaterialColumns Materials;
+		Materials.Name = GetColumn<uint32_t>("Materials.Name");
+		Materials.AssetPath = GetColumn<uint32_t>("Materials.AssetPath");
+		Materials.UniqueId = GetColumn<uint32_t>("Materials.UniqueId");
+		Materials.NumRefs = GetColumn<uint32_t>("Materials.NumRefs");
+		Materials.NumInstances = GetColumn<uint32_t>("Materials.NumInstances");
+		Materials.BPSCount = GetColumn<int32_t>("Materials.BPSCount");
+		Materials.BPSVertex = GetColumn<int32_t>("Materials.BPSVertex");
+		Materials.NumShaderPermutations = GetColumn<uint32_t>("Materials.NumShaderPermutations");
+		Materials.ShaderMapBytes = GetColumn<uint32_t>("Materials.ShaderMapBytes");
+		Materials.MaterialInstances = GetColumn<FIndexSpan>("Materials.MaterialInstances");
+		Materials.UsedTextures = GetColumn<FIndexSpan>("Materials.UsedTextures");
+		return Materials;
+	}
+
+	FMaterialInstanceColumns FTableFile::GetMaterialInstances() const
+	{
+		FMaterialInstanceColumns MaterialInstances;
+		MaterialInstances.Name = GetColumn<uint32_t>("MaterialInstances.Name");
+		MaterialInstances.AssetPath = GetColumn<uint32_t>("MaterialInstances.AssetPath");
+		MaterialInstances.UniqueId = GetColumn<uint32_t>("MaterialInstances.UniqueId");
+		MaterialInstances.NumRefs = GetColumn<uint32_t>("MaterialInstances.NumRefs");
+		MaterialInstances.ParentIndex = GetColumn<int32_t>("MaterialInstances.ParentIndex");
+		MaterialInstances.NumShaderPermutations = GetColumn<uint32_t>("MaterialInstances.NumShaderPermutations");
+		MaterialInstances.ShaderMapBytes = GetColumn<uint32_t>("MaterialInstances.ShaderMapBytes");
+		MaterialInstances.UsedTextures = GetColumn<FIndexSpan>("MaterialInstances.UsedTextures");
+		return MaterialInstances;
+	}
+
+	FTextureColumns FTableFile::GetTextures() const
+	{
+		FTextureColumns Textures;
+		Textures.Name = GetColumn<uint32_t>("Textures.Name");
+		Textures.AssetPath = GetColumn<uint32_t>("Textures.AssetPath");
+		Textures.UniqueId = GetColumn<uint32_t>("Textures.UniqueId");
+		Textures.NumRefs = GetColumn<uint32_t>("Textures.NumRefs");
+		Textures.LODBias = GetColumn<int32_t>("Textures.LODBias");
+		Textures.CurrentKB = GetColumn<float>("Textures.CurrentKB");
+		Textures.FullyLoadedKB = GetColumn<float>("Textures.FullyLoadedKB");
+		Textures.SizeX = GetColumn<uint16_t>("Textures.SizeX");
+		Textures.SizeY = GetColumn<uint16_t>("Textures.SizeY");
+		Textures.NumResidentMips = GetColumn<uint8_t>("Textures.NumResidentMips");
+		Textures.LODGroup = GetColumn<uint8_t>("Textures.LODGroup");
+		return Textures;
+	}
+}
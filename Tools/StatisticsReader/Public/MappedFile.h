@@ -0,0 +1,40 @@
+// ...
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace StatisticsReader
+{
+	/** Read only view of a whole file...Pages are loaded by the OS on first access... */
+	class FMappedFile
+	{
+	public:
+
+		FMappedFile() = default;
+		~FMappedFile();
+
+		FMappedFile(const FMappedFile&) = delete;
+		FMappedFile& operator=(const FMappedFile&) = delete;
+		FMappedFile(FMappedFile&& InOther) noexcept;
+		FMappedFile& operator=(FMappedFile&& InOther) noexcept;
+
+		bool Open(const std::string& InFilePath);
+		void Close();
+
+		const uint8_t* GetData() const { return Data; }
+		size_t GetSize() const { return Size; }
+		bool IsOpen() const { return Data != nullptr; }
+
+	private:
+
+		const uint8_t* Data = nullptr;
+		size_t Size = 0;
+#if defined(_WIN32)
+		void* FileHandle = nullptr;
+		void* MappingHandle = nullptr;
+#endif
+	};
+}
@@ -0,0 +1,225 @@
+// ...
+
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/** Reader of the <Table>_Tables.stb files written by FBinaryTableWriter...No engine dependency...
+ *
+ *  Header     : uint32 Magic 'STBF', uint32 Version, uint32 NumColumns, uint32 Reserved...
+ *  Columns    : NumColumns x { char Name[48], uint32 Type, uint32 NumComponents, uint64 NumRows, uint64 Offset }...
+ *  Column data: Rows x Components, little endian, every column aligned to 64 bytes...
+ */
+namespace StatisticsReader
+{
+	enum class EColumnType : uint32_t
+	{
+		UInt8,
+		UInt16,
+		UInt32,
+		UInt64,
+		Int32,
+		Float
+	};
+
+	struct FVector3f
+	{
+		float X, Y, Z;
+	};
+
+	/** Row major, translation in M[3]...Same layout as FMatrix... */
+	struct FMatrix44f
+	{
+		float M[4][4];
+	};
+
+	/** Offset and count into the Indices column... */
+	struct FIndexSpan
+	{
+		int32_t Offset;
+		int32_t Count;
+	};
+
+	/** Column type and components of a value type... */
+	template<typename ValueType> struct TColumnTraits;
+	template<> struct TColumnTraits<uint8_t>	{ static constexpr EColumnType Type = EColumnType::UInt8;  static constexpr uint32_t NumComponents = 1; };
+	template<> struct TColumnTraits<uint16_t>	{ static constexpr EColumnType Type = EColumnType::UInt16; static constexpr uint32_t NumComponents = 1; };
+	template<> struct TColumnTraits<uint32_t>	{ static constexpr EColumnType Type = EColumnType::UInt32; static constexpr uint32_t NumComponents = 1; };
+	template<> struct TColumnTraits<uint64_t>	{ static constexpr EColumnType Type = EColumnType::UInt64; static constexpr uint32_t NumComponents = 1; };
+	template<> struct TColumnTraits<int32_t>	{ static constexpr EColumnType Type = EColumnType::Int32;  static constexpr uint32_t NumComponents = 1; };
+	template<> struct TColumnTraits<float>		{ static constexpr EColumnType Type = EColumnType::Float;  static constexpr uint32_t NumComponents = 1; };
+	template<> struct TColumnTraits<FVector3f>	{ static constexpr EColumnType Type = EColumnType::Float;  static constexpr uint32_t NumComponents = 3; };
+	template<> struct TColumnTraits<FMatrix44f> { static constexpr EColumnType Type = EColumnType::Float;  static constexpr uint32_t NumComponents = 16; };
+	template<> struct TColumnTraits<FIndexSpan> { static constexpr EColumnType Type = EColumnType::Int32;  static constexpr uint32_t NumComponents = 2; };
+
+	/** Typed rows of one column, pointing into the mapped file...Empty if the column is missing or of another type... */
+	template<typename ValueType>
+	class TColumnView
+	{
+	public:
+
+		TColumnView() = default;
+		TColumnView(const ValueType* InData, size_t InNum) : Data(InData), NumRows(InNum) {}
+
+		const ValueType& operator[](size_t InIndex) const { return Data[InIndex]; }
+		const ValueType* GetData() const { return Data; }
+		size_t Num() const { return NumRows; }
+		bool IsEmpty() const { return NumRows == 0; }
+
+		const ValueType* begin() const { return Data; }
+		const ValueType* end() const { return Data + NumRows; }
+
+	private:
+
+		const ValueType* Data = nullptr;
+		size_t NumRows = 0;
+	};
+
+	struct FColumnInfo
+	{
+		EColumnType Type;
+		uint32_t	NumComponents;
+		uint64_t	NumRows;
+		const uint8_t* Data;
+	};
+
+	struct FBoundsColumns
+	{
+		TColumnView<FVector3f> Origin;
+		TColumnView<FVector3f> BoxExtent;
+		TColumnView<float>	   SphereRadius;
+	};
+
+	/** Rows of all LODs, see CurrentLOD... */
+	struct FStaticMeshColumns
+	{
+		TColumnView<uint32_t>	Name; // String ids, see FTableFile::GetString()...
+		TColumnView<uint32_t>	OwnerName;
+		TColumnView<uint32_t>	AssetPath;
+		TColumnView<uint32_t>	UniqueId;
+		TColumnView<uint16_t>	CurrentLOD;
+		TColumnView<uint16_t>	NumLODs;
+		TColumnView<uint32_t>	NumVertices;
+		TColumnView<uint32_t>	NumTriangles;
+		TColumnView<uint32_t>	NumInstances;
+		TColumnView<FIndexSpan> BoundsIndices;	   // First is Mesh...Rest is Instance...
+		TColumnView<FIndexSpan> TransformsIndices; // First is Mesh...Rest is Instance...
+		TColumnView<FIndexSpan> UsedMaterials;
+		TColumnView<FIndexSpan> UsedMaterialInstances;
+	};
+
+	struct FSkeletalMeshColumns
+	{
+		TColumnView<uint32_t>	Name;
+		TColumnView<uint32_t>	OwnerName;
+		TColumnView<uint32_t>	AssetPath;
+		TColumnView<uint32_t>	UniqueId;
+		TColumnView<uint16_t>	CurrentLOD;
+		TColumnView<uint16_t>	NumLODs;
+		TColumnView<uint32_t>	NumVertices;
+		TColumnView<uint32_t>	NumTriangles;
+		TColumnView<uint32_t>	NumSections;
+		TColumnView<int32_t>	BoundsIndex;
+		TColumnView<int32_t>	TransformsIndex;
+		TColumnView<FIndexSpan> UsedMaterials;
+		TColumnView<FIndexSpan> UsedMaterialInstances;
+	};
+
+	struct FMaterialColumns
+	{
+		TColumnView<uint32_t>	Name;
+		TColumnView<uint32_t>	AssetPath;
+		TColumnView<uint32_t>	UniqueId;
+		TColumnView<uint32_t>	NumRefs;
+		TColumnView<uint32_t>	NumInstances;
+		TColumnView<int32_t>	BPSCount;
+		TColumnView<int32_t>	BPSVertex;
+		TColumnView<uint32_t>	NumShaderPermutations;
+		TColumnView<uint32_t>	ShaderMapBytes;
+		TColumnView<FIndexSpan> MaterialInstances;
+		TColumnView<FIndexSpan> UsedTextures;
+	};
+
+	struct FMaterialInstanceColumns
+	{
+		TColumnView<uint32_t>	Name;
+		TColumnView<uint32_t>	AssetPath;
+		TColumnView<uint32_t>	UniqueId;
+		TColumnView<uint32_t>	NumRefs;
+		TColumnView<int32_t>	ParentIndex; // Row of Materials...
+		TColumnView<uint32_t>	NumShaderPermutations;
+		TColumnView<uint32_t>	ShaderMapBytes;
+		TColumnView<FIndexSpan> UsedTextures;
+	};
+
+	struct FTextureColumns
+	{
+		TColumnView<uint32_t> Name;
+		TColumnView<uint32_t> AssetPath;
+		TColumnView<uint32_t> UniqueId;
+		TColumnView<uint32_t> NumRefs;
+		TColumnView<int32_t>  LODBias;
+		TColumnView<float>	  CurrentKB;
+		TColumnView<float>	  FullyLoadedKB;
+		TColumnView<uint16_t> SizeX;
+		TColumnView<uint16_t> SizeY;
+		TColumnView<uint8_t>  NumResidentMips;
+		TColumnView<uint8_t>  LODGroup;
+	};
+
+	/** One exported World or Level...Views are valid while the file is open... */
+	class FTableFile
+	{
+	public:
+
+		/** Only reads the column directory...Column data is paged in on access... */
+		bool Open(const std::string& InFilePath);
+		/** Path of the tables handed over by the editor, -tables [Path] of the viewer command line...False when absent... */
+		static bool ParseTablesArgument(const std::string& InCommandLine, std::string& OutFilePath);
+		void Close();
+
+		const std::string& GetError() const { return Error; }
+
+		const FColumnInfo* FindColumn(const std::string& InName) const;
+		const std::unordered_map<std::string, FColumnInfo>& GetColumns() const { return Columns; }
+
+		template<typename ValueType>
+		TColumnView<ValueType> GetColumn(const std::string& InName) const
+		{
+			const FColumnInfo* Column = FindColumn(InName);
+			if (!Column || Column->Type != TColumnTraits<ValueType>::Type || Column->NumComponents != TColumnTraits<ValueType>::NumComponents)
+				return TColumnView<ValueType>();
+			return TColumnView<ValueType>((const ValueType*)Column->Data, (size_t)Column->NumRows);
+		}
+
+		/** Names and asset paths of the rows...Empty for unknown ids... */
+		std::string_view GetString(uint32_t InId) const;
+		TColumnView<int32_t> GetIndices(const FIndexSpan& InSpan) const;
+
+		TColumnView<FMatrix44f> GetTransforms() const { return GetColumn<FMatrix44f>("Transforms"); }
+		FBoundsColumns GetBounds() const;
+		FStaticMeshColumns GetStaticMeshes() const;
+		FSkeletalMeshColumns GetSkeletalMeshes() const;
+		FMaterialColumns GetMaterials() const;
+		FMaterialInstanceColumns GetMaterialInstances() const;
+		FTextureColumns GetTextures() const;
+
+	private:
+
+		bool ReadColumns();
+		bool Fail(const std::string& InError);
+
+		FMappedFile File;
+		std::unordered_map<std::string, FColumnInfo> Columns;
+		TColumnView<uint32_t> StringOffsets;
+		TColumnView<uint8_t>  StringChars;
+		TColumnView<int32_t>  Indices;
+		std::string Error;
+	};
+}
@@ -0,0 +1,179 @@
+// ...
+
+// End to end check of the editor to viewer handoff...Writes tables the way FVisualizationToolLauncher does, starts itself
+// as the viewer with the same -tables [Path] command line and checks what the child process maps...
+// Usage: StatisticsReaderHandoffTest...The child is started as StatisticsReaderHandoffTest --viewer "<CommandLine>"...
+
+#include "TableFile.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace StatisticsReader;
+
+namespace
+{
+	const uint32_t NumTransforms = 1000;
+	const char* MeshName = "SM_Handoff";
+
+	/** Same layout as FBinaryTableWriter...A corrupt row count is written past the end of the file on request... */
+	bool WriteTables(const std::string& InFilePath, bool bInCorruptRowCount)
+	{
+		struct FColumn
+		{
+			const char* Name;
+			EColumnType Type;
+			uint32_t NumComponents;
+			uint64_t NumRows;
+			const void* Data;
+			uint64_t NumBytes;
+		};
+
+		std::vector<FMatrix44f> Transforms(NumTransforms);
+		for (uint32_t i = 0; i < NumTransforms; ++i)
+		{
+			FMatrix44f& Transform = Transforms[i];
+			std::memset(&Transform, 0, sizeof(Transform));
+			Transform.M[0][0] = Transform.M[1][1] = Transform.M[2][2] = Transform.M[3][3] = 1.f;
+			Transform.M[3][0] = (float)i;
+		}
+
+		const uint32_t NameLength = (uint32_t)std::strlen(MeshName) + 1;
+		const uint32_t StringOffsets[2] = { 0, NameLength };
+		const uint64_t NumTransformRows = bInCorruptRowCount ? ~0ull / 64 : NumTransforms;
+
+		const std::vector<FColumn> Columns =
+		{
+			{ "Strings.Offsets", EColumnType::UInt32, 1, 2, StringOffsets, sizeof(StringOffsets) },
+			{ "Strings.Chars", EColumnType::UInt8, 1, NameLength, MeshName, NameLength },
+			{ "Transforms", EColumnType::Float, 16, NumTransformRows, Transforms.data(), NumTransforms * 64ull },
+		};
+
+		std::filesystem::create_directories(std::filesystem::path(InFilePath).parent_path());
+		std::ofstream Out(InFilePath, std::ios::binary);
+		if (!Out)
+			return false;
+
+		auto Align = [](uint64_t InOffset) { return (InOffset + 63) & ~63ull; };
+		auto Write = [&Out](const void* InData, size_t InSize) { Out.write((const char*)InData, InSize); };
+
+		const uint32_t Header[4] = { 0x46425453, 1, (uint32_t)Columns.size(), 0 };
+		Write(Header, sizeof(Header));
+
+		uint64_t Offset = Align(16 + Columns.size() * 72);
+		for (const FColumn& Column : Columns)
+		{
+			char Name[48] = { 0 };
+			std::strncpy(Name, Column.Name, sizeof(Name) - 1);
+			const uint32_t Type = (uint32_t)Column.Type;
+			Write(Name, sizeof(Name));
+			Write(&Type, 4);
+			Write(&Column.NumComponents, 4);
+			Write(&Column.NumRows, 8);
+			Write(&Offset, 8);
+			Offset = Align(Offset + Column.NumBytes);
+		}
+
+		const char Zeros[64] = { 0 };
+		for (const FColumn& Column : Columns)
+		{
+			const uint64_t Position = (uint64_t)Out.tellp();
+			Write(Zeros, Align(Position) - Position);
+			Write(Column.Data, Column.NumBytes);
+		}
+
+		return Out.good();
+	}
+
+	/** Viewer side...Exit code 0 only when the mapped tables match what the editor wrote... */
+	int RunViewer(const std::string& InCommandLine)
+	{
+		std::string FilePath;
+		if (!FTableFile::ParseTablesArgument(InCommandLine, FilePath))
+		{
+			std::fprintf(stderr, "Viewer: no -tables [Path] in %s\n", InCommandLine.c_str());
+			return 1;
+		}
+
+		FTableFile Tables;
+		if (!Tables.Open(FilePath))
+		{
+			std::fprintf(stderr, "Viewer: %s: %s\n", FilePath.c_str(), Tables.GetError().c_str());
+			return 1;
+		}
+
+		const TColumnView<FMatrix44f> Transforms = Tables.GetTransforms();
+		if (Transforms.Num() != NumTransforms)
+		{
+			std::fprintf(stderr, "Viewer: %zu transforms, expected %u\n", Transforms.Num(), NumTransforms);
+			return 1;
+		}
+		for (uint32_t i = 0; i < NumTransforms; ++i)
+		{
+			if (Transforms[i].M[3][0] != (float)i || Transforms[i].M[3][3] != 1.f)
+			{
+				std::fprintf(stderr, "Viewer: transform %u differs\n", i);
+				return 1;
+			}
+		}
+		if (Tables.GetString(0) != MeshName)
+		{
+			std::fprintf(stderr, "Viewer: string 0 differs\n");
+			return 1;
+		}
+
+		std::printf("Viewer: mapped %zu transforms from %s\n", Transforms.Num(), FilePath.c_str());
+		return 0;
+	}
+
+	bool Check(bool bInCondition, const char* InMessage)
+	{
+		if (!bInCondition)
+			std::fprintf(stderr, "FAILED: %s\n", InMessage);
+		return bInCondition;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 2 && std::strcmp(argv[1], "--viewer") == 0)
+		return RunViewer(argv[2]);
+
+	// Space in the path, the viewer gets it in brackets like -dir [..]...
+	const std::filesystem::path TablesDir = std::filesystem::temp_directory_path() / "Statistics Handoff";
+	const std::string FilePath = (TablesDir / "StatisticsTables_1_0.stb").string();
+	if (!Check(WriteTables(FilePath, false), "write tables"))
+		return 1;
+
+	// Same arguments as FVisualizationToolLauncher::Launch()...
+	const std::string CommandLine = "-dir [" + TablesDir.string() + "] -scale [0.001] -tables [" + FilePath + "]";
+	std::string ViewerCommand = "\"" + std::string(argv[0]) + "\" --viewer \"" + CommandLine + "\"";
+#if defined(_WIN32)
+	// cmd.exe strips one pair of outer quotes...
+	ViewerCommand = "\"" + ViewerCommand + "\"";
+#endif
+	bool bPassed = Check(std::system(ViewerCommand.c_str()) == 0, "viewer process maps the handed over tables");
+
+	// The launcher deletes the file once the viewer exited...
+	std::error_code ErrorCode;
+	bPassed &= Check(std::filesystem::remove(FilePath, ErrorCode), "tables file can be deleted after the viewer exited");
+
+	std::string ParsedPath;
+	bPassed &= Check(!FTableFile::ParseTablesArgument("-dir [Saved/Statistics] -scale [0.001]", ParsedPath), "no -tables argument");
+	bPassed &= Check(!FTableFile::ParseTablesArgument("-tables []", ParsedPath), "empty -tables argument");
+
+	// A truncated or corrupt handoff must fail to open, the viewer then falls back to the CSV files...
+	bPassed &= Check(WriteTables(FilePath, true), "write corrupt tables");
+	FTableFile Corrupt;
+	bPassed &= Check(!Corrupt.Open(FilePath), "corrupt row count is rejected");
+	Corrupt.Close();
+	std::filesystem::remove_all(TablesDir, ErrorCode);
+
+	std::printf(bPassed ? "Handoff test passed\n" : "Handoff test failed\n");
+	return bPassed ? 0 : 1;
+}